@@ -0,0 +1,1172 @@
+// 통신 계층 벤치마크 모음
+// 코덱 / 파서 / 메시지 일정 / 송신 값 합성 마이크로벤치마크부터 vcan 시스템 호출 처리량, PTY 직렬 처리량,
+// 채널을 통한 왕복(loopback) 지연, 채널 시작 / 정지 지연까지 측정해 JSON으로 출력하고,
+// 이전 결과(기준선)와 비교해 임계값 이상 나빠진 항목을 회귀로 표시한다.
+//
+//   comm_bench [--out 결과.json] [--baseline 기준.json] [--threshold %] [--filter 이름] [--can vcan0] [--quick]
+//   comm_bench compare <기준.json> <결과.json> [--threshold %]
+//
+// 표는 stderr, JSON은 stdout(또는 --out)으로 나간다. 회귀가 있으면 종료 코드 1.
+// vcan 인터페이스가 없으면 CAN 항목은 "skipped"에 사유와 함께 기록된다.
+// 결과 검증(배치 디코딩 / 송신 값 합성 커널과 스칼라 경로의 일치 등)에 실패한 항목은 "failed"에 기록되고 종료 코드 1.
+#include "CANBatchDecoder.h"
+#include "CANCommunication.h"
+#include "CANSignalCodec.h"
+#include "IMUSignalModel.h"
+#include "JsonWriter.h"
+#include "LatencyHistogram.h"
+#include "LineFramer.h"
+#include "MessageSchedule.h"
+#include "NMEAGenerator.h"
+#include "NMEAParser.h"
+#include "RS232Communication.h"
+#include "SerialPort.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <net/if.h>
+#include <poll.h>
+#include <pty.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/utsname.h>
+#include <termios.h>
+#include <unistd.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+
+namespace {
+
+constexpr int kRepetitions = 5;      // 마이크로벤치마크 반복 (중앙값 사용, 첫 회는 워밍업으로 버림)
+constexpr double kDefaultThreshold = 10.0;  // 회귀 판정 기준 (%)
+constexpr int kIOBatch = 32;         // sendmmsg / recvmmsg 묶음 크기 (CANCommunication 기본값과 같음)
+constexpr int kIdleTimeoutMs = 200;  // 수신 측이 이 시간 동안 아무것도 못 받으면 종료
+
+struct Result {
+    std::string name;
+    std::string unit;
+    double value;
+    bool higherIsBetter;
+};
+
+struct Skipped {
+    std::string name;
+    std::string reason;
+};
+
+struct Options {
+    std::string outPath;
+    std::string baselinePath;
+    std::string filter;
+    std::string canInterface{"vcan0"};
+    double threshold{kDefaultThreshold};
+    bool quick{false};
+};
+
+class Suite {
+public:
+    explicit Suite(const Options& options) : options(options) {}
+
+    bool selected(const std::string& group) const {
+        return options.filter.empty() || group.find(options.filter) != std::string::npos ||
+               options.filter.find(group) == 0;
+    }
+    size_t scale(size_t full) const { return options.quick ? std::max<size_t>(full / 10, 1) : full; }
+
+    void add(const std::string& name, const std::string& unit, double value, bool higherIsBetter) {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+            return;
+        }
+        results.push_back({name, unit, value, higherIsBetter});
+        std::fprintf(stderr, "  %-40s %14.1f %s\n", name.c_str(), value, unit.c_str());
+    }
+    void addLatency(const std::string& prefix, const HistogramSummary& summary) {
+        add(prefix + ".p50", "ns", static_cast<double>(summary.p50), false);
+        add(prefix + ".p99", "ns", static_cast<double>(summary.p99), false);
+        add(prefix + ".p999", "ns", static_cast<double>(summary.p999), false);
+        add(prefix + ".max", "ns", static_cast<double>(summary.max), false);
+    }
+    void skip(const std::string& name, const std::string& reason) {
+        skipped.push_back({name, reason});
+        std::fprintf(stderr, "  %-40s skipped: %s\n", name.c_str(), reason.c_str());
+    }
+    void fail(const std::string& name, const std::string& reason) {
+        failed.push_back({name, reason});
+        std::fprintf(stderr, "  %-40s FAILED: %s\n", name.c_str(), reason.c_str());
+    }
+
+    const Options& options;
+    std::vector<Result> results;
+    std::vector<Skipped> skipped;
+    std::vector<Skipped> failed;
+};
+
+// 최적화로 측정 대상이 사라지지 않도록 결과를 모음
+uint64_t sink = 0;
+
+template <typename Fn>
+double measureNsPerOp(size_t iterations, Fn&& fn) {
+    std::vector<double> samples;
+    uint64_t local = 0;
+    for (int r = 0; r <= kRepetitions; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            local += fn(i);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (r > 0) {
+            samples.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / iterations);
+        }
+    }
+    sink += local;
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    return samples[samples.size() / 2];
+}
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ---------------------------------------------------------------- 마이크로벤치마크
+
+// 수신 배치 디코딩: recvmmsg 버퍼와 같은 canfd_frame 배열에서 메시지별로 모아 한 번에 디코딩
+// 커널마다 결과를 프레임 단위 스칼라 decode()와 비트 단위로 비교하고, 프레임당 비용을 기록
+void benchBatchDecode(Suite& suite, bool fd) {
+    const size_t frameCount = 1024;
+    const int samplesPerFrame = fd ? CANCommunication::kMaxFDSamplesPerFrame : 1;
+    const size_t count = can_codec::kMessageCount;
+
+    std::vector<canfd_frame> frames(frameCount);
+    FastRandom random(7);
+    for (size_t i = 0; i < frameCount; ++i) {
+        const can_codec::MessageDesc& msg = can_codec::kMessages[random.next() % count];
+        canfd_frame& frame = frames[i];
+        frame = {};
+        frame.can_id = msg.id;
+        uint8_t* samples = frame.data;
+        if (fd) {
+            frame.data[0] = static_cast<uint8_t>(samplesPerFrame);
+            samples = frame.data + 1;
+        }
+        frame.len = static_cast<uint8_t>((fd ? 1 : 0) + samplesPerFrame * msg.sampleBytes());
+        for (int b = 0; b < samplesPerFrame * msg.sampleBytes(); ++b) {
+            samples[b] = static_cast<uint8_t>(random.next());
+        }
+    }
+
+    // 수신 경로와 같은 순서: 프레임을 차례로 추가한 뒤 한 번에 디코딩
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(frames.data());
+    std::vector<uint32_t> first(frameCount);
+    auto runBatch = [&](CANBatchDecoder& decoder) {
+        decoder.reset(base);
+        for (size_t i = 0; i < frameCount; ++i) {
+            int index = can_codec::messageIndex(frames[i].can_id);
+            first[i] = decoder.add(index, fd ? frames[i].data + 1 : frames[i].data, samplesPerFrame);
+        }
+        decoder.decode();
+    };
+
+    const std::string prefix = fd ? "codec.can.batch_decode_fd." : "codec.can.batch_decode.";
+    for (SimdLevel kernel : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        const std::string name = prefix + simdLevelName(kernel);
+        if (!simdLevelAvailable(kernel)) {
+            suite.skip(name, "CPU에서 지원하지 않음");
+            continue;
+        }
+        CANBatchDecoder decoder(kernel);
+        runBatch(decoder);
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < frameCount; ++i) {
+            int index = can_codec::messageIndex(frames[i].can_id);
+            const can_codec::MessageDesc& msg = can_codec::kMessages[index];
+            const DecodedColumns& columns = decoder.columns(index);
+            const uint8_t* samples = fd ? frames[i].data + 1 : frames[i].data;
+            for (int s = 0; s < samplesPerFrame; ++s) {
+                float expected[can_codec::kMaxFields];
+                can_codec::decode(msg, samples + s * msg.sampleBytes(), expected);
+                for (int f = 0; f < msg.fieldCount; ++f) {
+                    if (memcmp(&expected[f], &columns.values[f][first[i] + s], sizeof(float)) != 0) {
+                        ++mismatches;
+                    }
+                }
+            }
+        }
+        if (mismatches > 0) {
+            suite.fail(name, "스칼라 decode()와 다른 값 " + std::to_string(mismatches) + "개");
+            continue;
+        }
+
+        // decode: 모아 둔 샘플의 디코딩만, total: 프레임 추가(ID 조회 포함)부터 디코딩까지
+        double decodeNs = measureNsPerOp(suite.scale(2000), [&](size_t) {
+            decoder.decode();
+            return static_cast<uint64_t>(decoder.columns(0).count);
+        });
+        suite.add(name + ".decode", "ns/frame", decodeNs / frameCount, false);
+        double totalNs = measureNsPerOp(suite.scale(2000), [&](size_t) {
+            runBatch(decoder);
+            return static_cast<uint64_t>(decoder.columns(0).count);
+        });
+        suite.add(name + ".total", "ns/frame", totalNs / frameCount, false);
+    }
+}
+
+void benchCodec(Suite& suite) {
+    if (!suite.selected("codec")) {
+        return;
+    }
+    std::fprintf(stderr, "[codec]\n");
+    const size_t iterations = suite.scale(2000000);
+    const size_t count = can_codec::kMessageCount;
+
+    double encodeNs = measureNsPerOp(iterations, [count](size_t i) {
+        const can_codec::MessageDesc& msg = can_codec::kMessages[i % count];
+        float values[can_codec::kMaxFields];
+        for (int f = 0; f < msg.fieldCount; ++f) {
+            // 신호 범위 안을 고르게 (범위 밖 값은 encode()에서 제한됨)
+            const can_codec::SignalDesc& signal = msg.fields[f];
+            float fraction = static_cast<float>((i + f * 37) % 4000) / 4000.0f;
+            values[f] = signal.minValue + fraction * (signal.maxValue - signal.minValue);
+        }
+        uint8_t out[8];
+        can_codec::encode(msg, values, out);
+        return static_cast<uint64_t>(out[0] ^ out[5]);
+    });
+    suite.add("codec.can.encode", "ns/op", encodeNs, false);
+
+    std::vector<std::array<uint8_t, 8>> payloads(1024);
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        for (size_t b = 0; b < 8; ++b) {
+            payloads[i][b] = static_cast<uint8_t>(i * 31 + b * 7);
+        }
+    }
+    double decodeNs = measureNsPerOp(iterations, [&payloads, count](size_t i) {
+        const can_codec::MessageDesc& msg = can_codec::kMessages[i % count];
+        float values[can_codec::kMaxFields];
+        can_codec::decode(msg, payloads[i & 1023].data(), values);
+        return static_cast<uint64_t>(values[0] + values[1] + values[2]);
+    });
+    suite.add("codec.can.decode", "ns/op", decodeNs, false);
+
+    double lookupNs = measureNsPerOp(iterations, [count](size_t i) {
+        // 정의된 ID와 없는 ID를 섞어서 조회
+        canid_t id = (i & 1) ? can_codec::kMessages[(i >> 1) % count].id : static_cast<canid_t>(0x100 + (i & 0x3FF));
+        return static_cast<uint64_t>(can_codec::messageIndex(id) + 1);
+    });
+    suite.add("codec.can.message_index", "ns/op", lookupNs, false);
+
+    benchBatchDecode(suite, false);
+    benchBatchDecode(suite, true);
+}
+
+void benchNMEA(Suite& suite) {
+    if (!suite.selected("nmea")) {
+        return;
+    }
+    std::fprintf(stderr, "[nmea]\n");
+    const size_t iterations = suite.scale(1000000);
+
+    // 송신 경로와 같은 "타임스탬프 - 문장" 형식
+    NMEAGenerator generator(42);
+    std::vector<std::string> lines;
+    for (int i = 0; i < 1024; ++i) {
+        lines.push_back("2025-01-01 12:00:00.000 - " + std::string(generator.next()));
+    }
+
+    double generateNs = measureNsPerOp(iterations, [&generator](size_t) {
+        return static_cast<uint64_t>(generator.next().size());
+    });
+    suite.add("nmea.generate", "ns/op", generateNs, false);
+
+    double parseNs = measureNsPerOp(iterations, [&lines](size_t i) {
+        nmea::Sentence sentence;
+        nmea::ParseResult result = nmea::parse(lines[i & 1023], sentence);
+        return static_cast<uint64_t>(result == nmea::ParseResult::Ok ? sentence.fieldCount : 0);
+    });
+    suite.add("nmea.parse", "ns/op", parseNs, false);
+
+    double checksumNs = measureNsPerOp(iterations, [&lines](size_t i) {
+        const std::string& line = lines[i & 1023];
+        return static_cast<uint64_t>(nmea::xorChecksum(line.data(), line.size()));
+    });
+    suite.add("nmea.checksum", "ns/op", checksumNs, false);
+
+    // 수신 경로의 줄 분리 (4KB 조각 단위로 입력)
+    std::string stream;
+    for (const std::string& line : lines) {
+        stream += line;
+        stream += '\n';
+    }
+    LineFramer framer;
+    double framerNs = measureNsPerOp(suite.scale(2000), [&stream, &framer](size_t) {
+        uint64_t count = 0;
+        for (size_t offset = 0; offset < stream.size(); offset += 4096) {
+            framer.feed(stream.data() + offset, std::min<size_t>(4096, stream.size() - offset),
+                        [&count](std::string_view) { ++count; });
+        }
+        return count;
+    });
+    suite.add("nmea.frame_line", "ns/op", framerNs / lines.size(), false);
+}
+
+// 메시지 일정 (타이밍 휠): 실제 시간 대신 1ms 단위로 시각을 넘기며 만료 처리 비용만 측정
+// 메시지 수가 10배가 되어도 송신 메시지당 비용이 비슷해야 함 (타이머 수가 아니라 송신 수에 비례)
+void benchSchedule(Suite& suite) {
+    if (!suite.selected("schedule")) {
+        return;
+    }
+    std::fprintf(stderr, "[schedule]\n");
+    const std::vector<int64_t> periodsNs = {10000000, 20000000, 100000000};
+    const int64_t stepNs = 1000000;
+    const size_t steps = suite.scale(20000);  // 20초 분량
+
+    for (size_t count : {size_t(1000), size_t(10000)}) {
+        MessageSchedule schedule;
+        schedule.setMessages(makeSensorFleet(count, 0x18000000, periodsNs, 200000, can_codec::kMessageCount), 1);
+        std::vector<uint32_t> due;
+        due.reserve(count);
+
+        schedule.start(0);
+        uint64_t fired = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 1; i <= steps; ++i) {
+            due.clear();
+            fired += schedule.advance(static_cast<int64_t>(i) * stepNs, due);
+        }
+        double elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        sink += fired;
+
+        std::string prefix = "schedule.wheel_" + std::to_string(count);
+        suite.add(prefix + ".per_fired", "ns/msg", elapsedNs / std::max<uint64_t>(fired, 1), false);
+        suite.add(prefix + ".per_tick", "ns/tick", elapsedNs / steps, false);
+    }
+}
+
+// 송신 값 합성: 가상 센서 메시지 N개의 값을 송신 순서대로 읽고 송신 후처럼 prepare()
+// SIMD 경로마다 같은 시드의 값 수열이 스칼라 경로와 비트 단위로 같은지, 합성 값이 CAN 코덱을 거쳐
+// 그대로 복원되는지 확인하고, 샘플당 비용을 기록
+void benchSignal(Suite& suite) {
+    if (!suite.selected("signal")) {
+        return;
+    }
+    std::fprintf(stderr, "[signal]\n");
+    const std::vector<int64_t> periodsNs = {10000000, 20000000, 100000000};
+    const size_t rounds = 4 * IMUSignalSet::kBlockSamples;  // 검증 구간 (블록 4개)
+
+    for (size_t count : {size_t(1000), size_t(10000)}) {
+        std::vector<IMUSignalStream> streams;
+        for (const ScheduledMessage& message :
+             makeSensorFleet(count, 0x18000000, periodsNs, 0, can_codec::kMessageCount)) {
+            streams.push_back({message.sensor, message.layout, message.periodNs});
+        }
+        auto runRounds = [&](IMUSignalSet& signalSet, size_t roundCount, std::vector<float>* out) {
+            float values[can_codec::kMaxFields];
+            uint64_t checksum = 0;
+            for (size_t r = 0; r < roundCount; ++r) {
+                for (size_t i = 0; i < signalSet.size(); ++i) {
+                    signalSet.next(i, values);
+                    if (out) {
+                        out->insert(out->end(), values, values + can_codec::kMaxFields);
+                    }
+                    checksum += static_cast<uint64_t>(static_cast<int64_t>(values[0]));
+                }
+                signalSet.prepare();
+            }
+            return checksum;
+        };
+
+        std::vector<float> expected;
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+            const std::string name = "signal.imu_" + std::to_string(count) + "." + simdLevelName(level);
+            if (!simdLevelAvailable(level)) {
+                suite.skip(name, "CPU에서 지원하지 않음");
+                continue;
+            }
+            IMUSignalSet signalSet;
+            signalSet.configure(streams, 1, level);
+            std::vector<float> values;
+            values.reserve(rounds * count * can_codec::kMaxFields);
+            runRounds(signalSet, rounds, &values);
+            if (level == SimdLevel::Scalar) {
+                // 수신 측 복원: 합성 값이 encode() / decode()를 거쳐 scale 한 단계 안으로 돌아와야 함
+                size_t roundTripErrors = 0;
+                for (size_t k = 0; k < values.size() / can_codec::kMaxFields; ++k) {
+                    const can_codec::MessageDesc& msg = can_codec::kMessages[streams[k % count].layout];
+                    const float* sample = &values[k * can_codec::kMaxFields];
+                    float input[can_codec::kMaxFields];
+                    float decoded[can_codec::kMaxFields];
+                    uint8_t payload[8];
+                    std::copy(sample, sample + can_codec::kMaxFields, input);
+                    can_codec::encode(msg, input, payload);
+                    can_codec::decode(msg, payload, decoded);
+                    for (int f = 0; f < msg.fieldCount; ++f) {
+                        if (!(std::fabs(decoded[f] - input[f]) <= msg.fields[f].scale)) {
+                            ++roundTripErrors;
+                        }
+                    }
+                }
+                if (roundTripErrors > 0) {
+                    suite.fail("signal.imu_" + std::to_string(count) + ".round_trip",
+                               "CAN 코덱으로 복원되지 않는 값 " + std::to_string(roundTripErrors) + "개");
+                }
+                expected = values;
+            } else if (values.size() != expected.size() ||
+                       memcmp(values.data(), expected.data(), values.size() * sizeof(float)) != 0) {
+                suite.fail(name, "스칼라 경로와 다른 값 수열");
+                continue;
+            }
+
+            // 한 회 = 모든 스트림에서 샘플 하나씩 읽고 prepare()
+            double roundNs = measureNsPerOp(suite.scale(200), [&](size_t) { return runRounds(signalSet, 1, nullptr); });
+            suite.add(name + ".per_sample", "ns/sample", roundNs / count, false);
+        }
+    }
+}
+
+// ---------------------------------------------------------------- vcan 시스템 호출 처리량
+
+int openCANSocket(const std::string& interfaceName, std::string& error) {
+    int fd = socket(PF_CAN, SOCK_RAW | SOCK_CLOEXEC, CAN_RAW);
+    if (fd < 0) {
+        error = std::string("socket: ") + strerror(errno);
+        return -1;
+    }
+    struct ifreq ifr = {};
+    strncpy(ifr.ifr_name, interfaceName.c_str(), IFNAMSIZ - 1);
+    if (ioctl(fd, SIOCGIFINDEX, &ifr) < 0) {
+        error = interfaceName + ": " + strerror(errno);
+        close(fd);
+        return -1;
+    }
+    struct sockaddr_can addr = {};
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        error = std::string("bind: ") + strerror(errno);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+struct ThroughputResult {
+    double txFramesPerSec;
+    double rxFramesPerSec;
+    uint64_t lost;
+};
+
+// 송신 스레드가 frameCount개를 보내고 이 스레드가 다른 소켓으로 받음
+ThroughputResult runCANThroughput(int txFd, int rxFd, size_t frameCount, bool batched) {
+    std::vector<can_frame> frames(kIOBatch);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        frames[i] = {};
+        frames[i].can_id = can_codec::kMessages[i % can_codec::kMessageCount].id;
+        frames[i].can_dlc = 6;
+    }
+
+    std::atomic<int64_t> txDoneNs{0};
+    const int64_t startNs = nowNs();
+    std::thread sender([&] {
+        std::vector<struct iovec> iov(kIOBatch);
+        std::vector<struct mmsghdr> msgs(kIOBatch);
+        for (int i = 0; i < kIOBatch; ++i) {
+            iov[i] = {&frames[i], sizeof(can_frame)};
+            msgs[i] = {};
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        size_t sent = 0;
+        while (sent < frameCount) {
+            int want = static_cast<int>(std::min<size_t>(kIOBatch, frameCount - sent));
+            int n = batched ? sendmmsg(txFd, msgs.data(), want, MSG_DONTWAIT)
+                            : (send(txFd, &frames[sent % kIOBatch], sizeof(can_frame), MSG_DONTWAIT) ==
+                                       static_cast<ssize_t>(sizeof(can_frame)) ? 1 : -1);
+            if (n > 0) {
+                sent += static_cast<size_t>(n);
+            } else if (errno == EAGAIN || errno == ENOBUFS) {
+                // 송신 큐 가득 참: 비워질 때까지 대기
+                struct pollfd pfd = {txFd, POLLOUT, 0};
+                poll(&pfd, 1, 1);
+            } else {
+                break;
+            }
+        }
+        txDoneNs.store(nowNs());
+    });
+
+    std::vector<can_frame> rxFrames(kIOBatch);
+    std::vector<struct iovec> rxIov(kIOBatch);
+    std::vector<struct mmsghdr> rxMsgs(kIOBatch);
+    for (int i = 0; i < kIOBatch; ++i) {
+        rxIov[i] = {&rxFrames[i], sizeof(can_frame)};
+        rxMsgs[i] = {};
+        rxMsgs[i].msg_hdr.msg_iov = &rxIov[i];
+        rxMsgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    size_t received = 0;
+    int64_t lastRxNs = startNs;
+    while (received < frameCount) {
+        struct pollfd pfd = {rxFd, POLLIN, 0};
+        if (poll(&pfd, 1, kIdleTimeoutMs) <= 0) {
+            break;
+        }
+        int n = batched ? recvmmsg(rxFd, rxMsgs.data(), kIOBatch, MSG_DONTWAIT, nullptr)
+                        : (recv(rxFd, rxFrames.data(), sizeof(can_frame), MSG_DONTWAIT) > 0 ? 1 : 0);
+        if (n > 0) {
+            received += static_cast<size_t>(n);
+            lastRxNs = nowNs();
+        }
+    }
+    sender.join();
+
+    ThroughputResult result;
+    result.txFramesPerSec = frameCount / (std::max<int64_t>(txDoneNs.load() - startNs, 1) / 1e9);
+    result.rxFramesPerSec = received / (std::max<int64_t>(lastRxNs - startNs, 1) / 1e9);
+    result.lost = frameCount - std::min(received, frameCount);
+    return result;
+}
+
+void benchCANSyscalls(Suite& suite) {
+    if (!suite.selected("can.vcan")) {
+        return;
+    }
+    std::fprintf(stderr, "[can.vcan] %s\n", suite.options.canInterface.c_str());
+    std::string error;
+    int txFd = openCANSocket(suite.options.canInterface, error);
+    int rxFd = txFd >= 0 ? openCANSocket(suite.options.canInterface, error) : -1;
+    if (rxFd < 0) {
+        if (txFd >= 0) {
+            close(txFd);
+        }
+        suite.skip("can.vcan", error);
+        return;
+    }
+    int rcvbuf = 8 << 20;
+    setsockopt(rxFd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    const size_t frameCount = suite.scale(500000);
+    for (bool batched : {false, true}) {
+        const std::string mode = batched ? "batched" : "perframe";
+        ThroughputResult result = runCANThroughput(txFd, rxFd, frameCount, batched);
+        suite.add("can.vcan.tx_" + mode, "frames/s", result.txFramesPerSec, true);
+        suite.add("can.vcan.rx_" + mode, "frames/s", result.rxFramesPerSec, true);
+        suite.add("can.vcan.lost_" + mode, "frames", static_cast<double>(result.lost), false);
+    }
+    close(txFd);
+    close(rxFd);
+}
+
+// ---------------------------------------------------------------- PTY 직렬 처리량
+
+struct Pty {
+    int master{-1};
+    int slave{-1};
+    std::string slavePath;
+
+    bool open(std::string& error) {
+        char name[64];
+        if (openpty(&master, &slave, name, nullptr, nullptr) < 0) {
+            error = std::string("openpty: ") + strerror(errno);
+            return false;
+        }
+        struct termios tio;
+        tcgetattr(slave, &tio);
+        cfmakeraw(&tio);
+        tcsetattr(slave, TCSANOW, &tio);
+        slavePath = name;
+        return true;
+    }
+    ~Pty() {
+        if (master >= 0) close(master);
+        if (slave >= 0) close(slave);
+    }
+};
+
+void benchSerial(Suite& suite) {
+    if (!suite.selected("serial.pty")) {
+        return;
+    }
+    std::fprintf(stderr, "[serial.pty]\n");
+    Pty pty;
+    std::string error;
+    if (!pty.open(error)) {
+        suite.skip("serial.pty", error);
+        return;
+    }
+    SerialPort port;  // 송신 경로와 같은 방식 (논블로킹 raw 8N1)
+    if (!port.open(pty.slavePath, 115200)) {
+        suite.skip("serial.pty", pty.slavePath + ": " + strerror(errno));
+        return;
+    }
+
+    NMEAGenerator generator(7);
+    std::string chunk;
+    while (chunk.size() < 64 * 1024) {
+        chunk += "2025-01-01 12:00:00.000 - ";
+        chunk += generator.next();
+        chunk += '\n';
+    }
+    const size_t totalBytes = suite.scale(32u << 20) / chunk.size() * chunk.size();
+
+    const int64_t startNs = nowNs();
+    std::thread writer([&] {
+        size_t written = 0;
+        size_t offset = 0;
+        while (written < totalBytes) {
+            ssize_t n = port.writeSome(chunk.data() + offset, chunk.size() - offset);
+            if (n < 0) {
+                break;
+            }
+            if (n == 0) {
+                struct pollfd pfd = {port.nativeHandle(), POLLOUT, 0};
+                poll(&pfd, 1, 10);
+                continue;
+            }
+            written += static_cast<size_t>(n);
+            offset = (offset + static_cast<size_t>(n)) % chunk.size();
+        }
+    });
+
+    LineFramer framer;
+    char buffer[4096];
+    size_t bytes = 0;
+    uint64_t lines = 0;
+    while (bytes < totalBytes) {
+        struct pollfd pfd = {pty.master, POLLIN, 0};
+        if (poll(&pfd, 1, kIdleTimeoutMs) <= 0) {
+            break;
+        }
+        ssize_t n = read(pty.master, buffer, sizeof(buffer));
+        if (n <= 0) {
+            break;
+        }
+        bytes += static_cast<size_t>(n);
+        framer.feed(buffer, static_cast<size_t>(n), [&lines](std::string_view) { ++lines; });
+    }
+    const double elapsedSec = (nowNs() - startNs) / 1e9;
+    writer.join();
+
+    suite.add("serial.pty.throughput", "MB/s", bytes / elapsedSec / 1e6, true);
+    suite.add("serial.pty.lines", "lines/s", lines / elapsedSec, true);
+}
+
+// ---------------------------------------------------------------- 채널 왕복 지연
+
+// 기록 하나가 수신 링에 나올 때까지 대기 (반응기 스레드에 CPU를 양보하며)
+template <typename Channel>
+bool waitForRecord(Channel& channel, int64_t deadlineNs) {
+    CommRecord record;
+    while (channel.drainRecords(&record, 1) == 0) {
+        if (nowNs() > deadlineNs) {
+            return false;
+        }
+        sched_yield();
+    }
+    return true;
+}
+
+void benchRS232Loopback(Suite& suite) {
+    if (!suite.selected("e2e.rs232")) {
+        return;
+    }
+    std::fprintf(stderr, "[e2e.rs232]\n");
+    Pty pty;
+    std::string error;
+    if (!pty.open(error)) {
+        suite.skip("e2e.rs232", error);
+        return;
+    }
+    // 루프백 케이블: 마스터에서 읽은 바이트를 그대로 되돌려 보냄
+    std::atomic<bool> relaying{true};
+    std::thread relay([&] {
+        char buffer[4096];
+        while (relaying.load(std::memory_order_relaxed)) {
+            struct pollfd pfd = {pty.master, POLLIN, 0};
+            if (poll(&pfd, 1, 50) <= 0) {
+                continue;
+            }
+            ssize_t n = read(pty.master, buffer, sizeof(buffer));
+            if (n > 0 && write(pty.master, buffer, static_cast<size_t>(n)) < 0) {
+                break;
+            }
+        }
+    });
+
+    RS232Communication channel(pty.slavePath, pty.slavePath);
+    channel.start();
+    NMEAGenerator generator(3);
+    LatencyHistogram histogram;
+    const size_t pings = suite.scale(5000);
+    const size_t warmup = std::min<size_t>(100, pings);
+    uint64_t timeouts = 0;
+    if (channel.isConnected()) {
+        for (size_t i = 0; i < warmup + pings; ++i) {
+            int64_t sentNs = nowNs();
+            channel.replaySentence(generator.next());
+            if (!waitForRecord(channel, sentNs + 1000000000LL)) {
+                ++timeouts;
+                continue;
+            }
+            if (i >= warmup) {
+                histogram.record(static_cast<uint64_t>(nowNs() - sentNs));
+            }
+        }
+    }
+    channel.stop();
+    relaying = false;
+    relay.join();
+
+    if (histogram.count() == 0) {
+        suite.skip("e2e.rs232", "채널 시작 실패 또는 응답 없음");
+        return;
+    }
+    suite.addLatency("e2e.rs232.rtt", histogram.summary());
+    suite.add("e2e.rs232.timeouts", "count", static_cast<double>(timeouts), false);
+}
+
+void benchCANLoopback(Suite& suite) {
+    if (!suite.selected("e2e.can")) {
+        return;
+    }
+    std::fprintf(stderr, "[e2e.can] %s\n", suite.options.canInterface.c_str());
+    std::string error;
+    int probe = openCANSocket(suite.options.canInterface, error);
+    if (probe < 0) {
+        suite.skip("e2e.can", error);
+        return;
+    }
+    close(probe);
+
+    // 송신 API -> 커널 루프백 -> 반응기 수신 -> 디코딩 -> 수신 링
+    CANCommunication channel(suite.options.canInterface);
+    channel.start();
+    const can_codec::MessageDesc& msg = can_codec::kMessages[0];
+    can_frame frame = {};
+    frame.can_id = msg.id;
+    frame.can_dlc = msg.sampleBytes();
+
+    LatencyHistogram histogram;
+    const size_t pings = suite.scale(20000);
+    const size_t warmup = std::min<size_t>(100, pings);
+    uint64_t timeouts = 0;
+    if (channel.isConnected()) {
+        for (size_t i = 0; i < warmup + pings; ++i) {
+            frame.data[0] = static_cast<uint8_t>(i);
+            int64_t sentNs = nowNs();
+            channel.sendData(frame);
+            if (!waitForRecord(channel, sentNs + 1000000000LL)) {
+                ++timeouts;
+                continue;
+            }
+            if (i >= warmup) {
+                histogram.record(static_cast<uint64_t>(nowNs() - sentNs));
+            }
+        }
+    }
+    channel.stop();
+
+    if (histogram.count() == 0) {
+        suite.skip("e2e.can", "채널 시작 실패 또는 응답 없음");
+        return;
+    }
+    suite.addLatency("e2e.can.rtt", histogram.summary());
+    suite.add("e2e.can.timeouts", "count", static_cast<double>(timeouts), false);
+}
+
+// ---------------------------------------------------------------- 채널 시작 / 정지
+
+// startAsync / stopAsync 요청부터 반응기 스레드에서 등록 / 해제가 끝날 때까지 (포트 열기 / 닫기 포함)
+void benchChannelCycle(Suite& suite) {
+    if (!suite.selected("channel.rs232")) {
+        return;
+    }
+    std::fprintf(stderr, "[channel.rs232]\n");
+    Pty pty;
+    std::string error;
+    if (!pty.open(error)) {
+        suite.skip("channel.rs232", error);
+        return;
+    }
+
+    RS232Communication channel(pty.slavePath, pty.slavePath);
+    LatencyHistogram startHistogram;
+    LatencyHistogram stopHistogram;
+    std::atomic<int> finished{0};
+    std::atomic<bool> failed{false};
+    auto await = [&finished](int count) {
+        while (finished.load(std::memory_order_acquire) < count) {
+            sched_yield();
+        }
+    };
+
+    const size_t cycles = suite.scale(2000);
+    const int64_t startNs = nowNs();
+    for (size_t i = 0; i < cycles && !failed; ++i) {
+        int done = finished.load(std::memory_order_relaxed);
+        channel.startAsync([&](const ChannelTransition& result) {
+            startHistogram.record(static_cast<uint64_t>(result.elapsedNs));
+            failed = failed || !result.connected;
+            finished.fetch_add(1, std::memory_order_release);
+        });
+        await(done + 1);
+        channel.stopAsync([&](const ChannelTransition& result) {
+            stopHistogram.record(static_cast<uint64_t>(result.elapsedNs));
+            finished.fetch_add(1, std::memory_order_release);
+        });
+        await(done + 2);
+    }
+    const double elapsedSec = (nowNs() - startNs) / 1e9;
+
+    if (failed) {
+        suite.skip("channel.rs232", "채널 시작 실패: " + pty.slavePath);
+        return;
+    }
+    suite.addLatency("channel.rs232.start", startHistogram.summary());
+    suite.addLatency("channel.rs232.stop", stopHistogram.summary());
+    suite.add("channel.rs232.cycles", "cycles/s", cycles / elapsedSec, true);
+}
+
+// ---------------------------------------------------------------- 결과 파일
+
+void writeResults(std::ostream& out, const Suite& suite) {
+    struct utsname host;
+    uname(&host);
+    JsonWriter json(out);
+    json.beginObject();
+    json.field("schema", "vsensor-bench/1");
+    json.field("timestamp", static_cast<int64_t>(std::time(nullptr)));
+    json.key("host");
+    json.beginObject();
+    json.field("kernel", host.release);
+    json.field("machine", host.machine);
+    json.field("cpus", static_cast<int64_t>(std::thread::hardware_concurrency()));
+    json.endObject();
+    json.field("quick", suite.options.quick);
+    json.key("results");
+    json.beginArray();
+    for (const Result& result : suite.results) {
+        json.beginObject();
+        json.field("name", result.name);
+        json.field("unit", result.unit);
+        json.field("value", result.value);
+        json.field("higher_is_better", result.higherIsBetter);
+        json.endObject();
+    }
+    json.endArray();
+    json.key("skipped");
+    json.beginArray();
+    for (const Skipped& entry : suite.skipped) {
+        json.beginObject();
+        json.field("name", entry.name);
+        json.field("reason", entry.reason);
+        json.endObject();
+    }
+    json.endArray();
+    json.key("failed");
+    json.beginArray();
+    for (const Skipped& entry : suite.failed) {
+        json.beginObject();
+        json.field("name", entry.name);
+        json.field("reason", entry.reason);
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+}
+
+// 결과 파일의 "results" 배열만 읽는 최소 JSON 파서 (writeResults의 출력 형식)
+class ResultReader {
+public:
+    explicit ResultReader(std::string text) : text(std::move(text)) {}
+
+    bool read(std::vector<Result>& results, std::string& error) {
+        if (!parseValue(nullptr, &results) || (skipSpace(), pos != text.size())) {
+            error = "JSON 형식 오류 (위치 " + std::to_string(pos) + ")";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    // results가 nullptr이 아니면 최상위 객체의 "results" 배열 원소를 채움
+    bool parseValue(Result* field, std::vector<Result>* results, const std::string& name = std::string()) {
+        skipSpace();
+        if (pos >= text.size()) {
+            return false;
+        }
+        char c = text[pos];
+        if (c == '{') {
+            return parseObject(results);
+        }
+        if (c == '[') {
+            ++pos;
+            skipSpace();
+            if (consume(']')) {
+                return true;
+            }
+            do {
+                Result item{};
+                item.higherIsBetter = false;
+                skipSpace();
+                bool isObject = pos < text.size() && text[pos] == '{';
+                if (isObject && results) {
+                    if (!parseObject(nullptr, &item)) {
+                        return false;
+                    }
+                    results->push_back(item);
+                } else if (!parseValue(nullptr, nullptr)) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume(']');
+        }
+        if (c == '"') {
+            std::string value;
+            if (!parseString(value)) {
+                return false;
+            }
+            if (field && name == "name") field->name = value;
+            if (field && name == "unit") field->unit = value;
+            return true;
+        }
+        if (text.compare(pos, 4, "true") == 0 || text.compare(pos, 5, "false") == 0) {
+            bool value = text[pos] == 't';
+            pos += value ? 4 : 5;
+            if (field && name == "higher_is_better") field->higherIsBetter = value;
+            return true;
+        }
+        if (text.compare(pos, 4, "null") == 0) {
+            pos += 4;
+            if (field && name == "value") field->value = NAN;
+            return true;
+        }
+        char* end = nullptr;
+        double value = std::strtod(text.c_str() + pos, &end);
+        if (end == text.c_str() + pos) {
+            return false;
+        }
+        pos = static_cast<size_t>(end - text.c_str());
+        if (field && name == "value") field->value = value;
+        return true;
+    }
+
+    bool parseObject(std::vector<Result>* results, Result* item = nullptr) {
+        ++pos;  // '{'
+        skipSpace();
+        if (consume('}')) {
+            return true;
+        }
+        do {
+            skipSpace();
+            std::string name;
+            if (!parseString(name) || (skipSpace(), !consume(':'))) {
+                return false;
+            }
+            std::vector<Result>* nested = (results && name == "results") ? results : nullptr;
+            if (!parseValue(item, nested, name)) {
+                return false;
+            }
+            skipSpace();
+        } while (consume(','));
+        return consume('}');
+    }
+
+    bool parseString(std::string& out) {
+        if (!consume('"')) {
+            return false;
+        }
+        while (pos < text.size() && text[pos] != '"') {
+            if (text[pos] == '\\' && pos + 1 < text.size()) {
+                ++pos;
+                char e = text[pos];
+                if (e == 'u') {
+                    pos += 4;  // 이름 / 단위에는 쓰지 않으므로 건너뜀
+                    out += '?';
+                } else {
+                    out += (e == 'n') ? '\n' : e;
+                }
+                ++pos;
+                continue;
+            }
+            out += text[pos++];
+        }
+        return consume('"');
+    }
+
+    void skipSpace() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+        }
+    }
+    bool consume(char c) {
+        skipSpace();
+        if (pos < text.size() && text[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    std::string text;
+    size_t pos{0};
+};
+
+bool loadResults(const std::string& path, std::vector<Result>& results) {
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "%s: %s\n", path.c_str(), strerror(errno));
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string error;
+    if (!ResultReader(buffer.str()).read(results, error)) {
+        std::fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+        return false;
+    }
+    return true;
+}
+
+// 기준선 대비 변화율 표 출력, 회귀 수 반환
+int compareResults(const std::vector<Result>& baseline, const std::vector<Result>& current, double threshold) {
+    int regressions = 0;
+    std::fprintf(stderr, "\n%-40s %14s %14s %9s\n", "benchmark", "baseline", "current", "change");
+    for (const Result& now : current) {
+        auto it = std::find_if(baseline.begin(), baseline.end(), [&](const Result& r) { return r.name == now.name; });
+        if (it == baseline.end() || !std::isfinite(it->value) || !std::isfinite(now.value)) {
+            std::fprintf(stderr, "%-40s %14s %14.1f %9s\n", now.name.c_str(), "-", now.value, "new");
+            continue;
+        }
+        // 기준값이 0이면 (예: 손실 0) 값이 생긴 것만으로 100% 변화로 봄
+        double change = it->value != 0.0 ? (now.value - it->value) / std::fabs(it->value) * 100.0
+                                         : (now.value == 0.0 ? 0.0 : std::copysign(100.0, now.value));
+        double worse = now.higherIsBetter ? -change : change;
+        bool regressed = worse > threshold;
+        regressions += regressed;
+        std::fprintf(stderr, "%-40s %14.1f %14.1f %+8.1f%%%s\n", now.name.c_str(), it->value, now.value, change,
+                     regressed ? "  REGRESSION" : (worse < -threshold ? "  improved" : ""));
+    }
+    for (const Result& old : baseline) {
+        if (std::none_of(current.begin(), current.end(), [&](const Result& r) { return r.name == old.name; })) {
+            std::fprintf(stderr, "%-40s %14.1f %14s %9s\n", old.name.c_str(), old.value, "-", "missing");
+        }
+    }
+    std::fprintf(stderr, "%d regression(s) beyond %.1f%%\n", regressions, threshold);
+    return regressions;
+}
+
+int usage() {
+    std::fprintf(stderr,
+                 "usage: comm_bench [--out 결과.json] [--baseline 기준.json] [--threshold %%] [--filter 이름] "
+                 "[--can vcan0] [--quick]\n"
+                 "       comm_bench compare <기준.json> <결과.json> [--threshold %%]\n");
+    return 2;
+}
+
+bool parseThreshold(const char* text, double& threshold) {
+    char* end = nullptr;
+    threshold = std::strtod(text, &end);
+    return end != text && *end == '\0' && threshold >= 0.0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && std::strcmp(argv[1], "compare") == 0) {
+        double threshold = kDefaultThreshold;
+        if (argc == 6 && std::strcmp(argv[4], "--threshold") == 0) {
+            if (!parseThreshold(argv[5], threshold)) {
+                return usage();
+            }
+        } else if (argc != 4) {
+            return usage();
+        }
+        std::vector<Result> baseline;
+        std::vector<Result> current;
+        if (!loadResults(argv[2], baseline) || !loadResults(argv[3], current)) {
+            return 2;
+        }
+        return compareResults(baseline, current, threshold) > 0 ? 1 : 0;
+    }
+
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--quick") {
+            options.quick = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return usage();
+        }
+        const char* value = argv[++i];
+        if (option == "--out") {
+            options.outPath = value;
+        } else if (option == "--baseline") {
+            options.baselinePath = value;
+        } else if (option == "--filter") {
+            options.filter = value;
+        } else if (option == "--can") {
+            options.canInterface = value;
+        } else if (option == "--threshold") {
+            if (!parseThreshold(value, options.threshold)) {
+                return usage();
+            }
+        } else {
+            return usage();
+        }
+    }
+
+    // 기준선은 실행 전에 읽어 둠 (형식 오류를 늦게 알지 않도록)
+    std::vector<Result> baseline;
+    if (!options.baselinePath.empty() && !loadResults(options.baselinePath, baseline)) {
+        return 2;
+    }
+
+    AsyncLogger::instance().setMode(LogMode::Disabled);
+    Suite suite(options);
+    benchCodec(suite);
+    benchNMEA(suite);
+    benchSchedule(suite);
+    benchSignal(suite);
+    benchCANSyscalls(suite);
+    benchSerial(suite);
+    benchRS232Loopback(suite);
+    benchCANLoopback(suite);
+    benchChannelCycle(suite);
+
+    if (options.outPath.empty()) {
+        writeResults(std::cout, suite);
+    } else {
+        std::ofstream out(options.outPath);
+        writeResults(out, suite);
+        if (!out) {
+            std::fprintf(stderr, "%s: 쓰기 실패\n", options.outPath.c_str());
+            return 2;
+        }
+    }
+    if (sink == 1) {
+        std::fprintf(stderr, "\n");  // 결과 사용 (최적화 방지)
+    }
+
+    int exitCode = suite.failed.empty() ? 0 : 1;
+    if (!baseline.empty() && compareResults(baseline, suite.results, options.threshold) > 0) {
+        exitCode = 1;
+    }
+    return exitCode;
+}
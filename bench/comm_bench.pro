@@ -0,0 +1,62 @@
+TEMPLATE = app
+TARGET = comm_bench
+QT = core
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+QMAKE_CXXFLAGS += -D_GNU_SOURCE
+# SIMD 배치 디코딩(CANBatchDecoder)과 송신 값 합성(IMUSignalModel)이 스칼라 경로와 비트 단위로 같도록 곱셈-덧셈 융합 금지
+QMAKE_CXXFLAGS += -ffp-contract=off
+QMAKE_CXXFLAGS_RELEASE += -O2
+
+SOURCES += \
+    comm_bench.cpp \
+    ../comm/CANCommunication.cpp \
+    ../comm/CANBatchDecoder.cpp \
+    ../comm/IMUSignalModel.cpp \
+    ../comm/SimdDispatch.cpp \
+    ../comm/CANIDStatsTable.cpp \
+    ../comm/RS232Communication.cpp \
+    ../comm/SentenceHistory.cpp \
+    ../comm/LatencyHistogram.cpp \
+    ../comm/AsyncLogger.cpp \
+    ../comm/SerialPort.cpp \
+    ../comm/NMEAParser.cpp \
+    ../comm/NMEAGenerator.cpp \
+    ../comm/PeriodicScheduler.cpp \
+    ../comm/MessageSchedule.cpp \
+    ../comm/EventReactor.cpp \
+    ../comm/CaptureFile.cpp \
+    ../comm/TrafficRecorder.cpp \
+    ../comm/Metrics.cpp \
+
+HEADERS += \
+    ../comm/HardwareCommunication.h \
+    ../comm/CANCommunication.h \
+    ../comm/CANIDStatsTable.h \
+    ../comm/CANSignalCodec.h \
+    ../comm/CANId.h \
+    ../comm/CANBatchDecoder.h \
+    ../comm/IMUSignalModel.h \
+    ../comm/SimdDispatch.h \
+    ../comm/RS232Communication.h \
+    ../comm/SentenceHistory.h \
+    ../comm/LatencyHistogram.h \
+    ../comm/SPSCRing.h \
+    ../comm/CommRecord.h \
+    ../comm/AsyncLogger.h \
+    ../comm/SerialPort.h \
+    ../comm/LineFramer.h \
+    ../comm/NMEAParser.h \
+    ../comm/NMEAGenerator.h \
+    ../comm/FastRandom.h \
+    ../comm/PeriodicScheduler.h \
+    ../comm/MessageSchedule.h \
+    ../comm/EventReactor.h \
+    ../comm/CaptureFile.h \
+    ../comm/TrafficRecorder.h \
+    ../comm/Metrics.h \
+    ../comm/JsonWriter.h \
+
+INCLUDEPATH += \
+    ../comm \
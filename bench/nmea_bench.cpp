@@ -0,0 +1,258 @@
+// NMEA 송수신 경로 마이크로벤치마크
+// 기존 구현(정규식 검증 + stringstream 필드 분리 + find() 3회 분기)과
+// NMEAParser(단일 패스, 할당 없음)를 같은 입력으로 비교하고,
+// 기존 생성기(random_device + ostringstream)와 NMEAGenerator의 생성 속도를 비교한다.
+#include "NMEAGenerator.h"
+#include "NMEAParser.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace legacy {
+
+// RS232Communication의 이전 구현 사본 (비교용)
+std::string calculateChecksum(const std::string& sentence) {
+    unsigned char checksum = 0;
+    bool start = false;
+
+    for (char ch : sentence) {
+        if (ch == '$') {
+            start = true;
+            continue;
+        }
+        if (ch == '*') break;
+
+        if (start) checksum ^= static_cast<unsigned char>(ch);
+    }
+
+    std::ostringstream hexStream;
+    hexStream << std::uppercase << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(checksum);
+    return hexStream.str();
+}
+
+bool verifyChecksum(const std::string& sentence) {
+    size_t pos = sentence.find("$");
+    if (pos == std::string::npos) {
+        return false;
+    }
+
+    std::string timestamp = sentence.substr(0, pos);
+    std::string nmeaSentence = sentence.substr(pos);
+
+    std::regex checksumRegex("^(\\$[^*]+)\\*([0-9A-Fa-f]{2})$");
+    std::smatch match;
+    if (std::regex_match(nmeaSentence, match, checksumRegex)) {
+        if (calculateChecksum(match[1].str()) == match[2].str()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> parseNMEAMessage(const std::string& message) {
+    std::vector<std::string> fields;
+    std::stringstream ss(message);
+    std::string field;
+    while (std::getline(ss, field, ',')) {
+        if (field.empty()) {
+            fields.push_back("<빈 값>");
+        } else {
+            fields.push_back(field);
+        }
+    }
+    return fields;
+}
+
+// 분기 후 필드 하나를 읽는 데까지 (QString 포맷팅은 제외)
+size_t dispatch(const std::string& message) {
+    std::size_t gpgga_pos = message.find("$GPGGA");
+    std::size_t gphdt_pos = message.find("$GPHDT");
+    std::size_t gpvtg_pos = message.find("$GPVTG");
+
+    if (gpgga_pos != std::string::npos) {
+        std::vector<std::string> fields = parseNMEAMessage(message.substr(gpgga_pos));
+        return fields.size() >= 15 ? fields[9].size() : 0;
+    } else if (gphdt_pos != std::string::npos) {
+        std::vector<std::string> fields = parseNMEAMessage(message.substr(gphdt_pos));
+        return fields.size() >= 3 ? fields[1].size() : 0;
+    } else if (gpvtg_pos != std::string::npos) {
+        std::vector<std::string> fields = parseNMEAMessage(message.substr(gpvtg_pos));
+        return fields.size() >= 9 ? fields[7].size() : 0;
+    }
+    return 0;
+}
+
+std::string formatDouble(double val) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(4) << val;
+    return ss.str();
+}
+
+int generateRandomInt(int min, int max) {
+    std::random_device rd;
+    std::uniform_int_distribution<> dist(min, max);
+    return dist(rd);
+}
+
+double generateRandomDouble(double min, double max) {
+    std::random_device rd;
+    std::uniform_real_distribution<> dist(min, max);
+    return dist(rd);
+}
+
+std::string generateGPGGA() {
+    int hours = generateRandomInt(0, 23);
+    int minutes = generateRandomInt(0, 59);
+    int seconds = generateRandomInt(0, 59);
+    int milliseconds = generateRandomInt(0, 99);
+
+    double latitude = generateRandomDouble(0.0, 90.0);
+    char lat_dir = (generateRandomInt(0, 1) == 0) ? 'N' : 'S';
+    double longitude = generateRandomDouble(0.0, 180.0);
+    char lon_dir = (generateRandomInt(0, 1) == 0) ? 'E' : 'W';
+
+    std::string fix = std::to_string(generateRandomInt(0, 2));
+    std::string nsat = std::to_string(generateRandomInt(0, 12));
+    std::string hdop = formatDouble(generateRandomDouble(0.0, 99.9));
+    std::string altitude = formatDouble(generateRandomDouble(-1000.0, 10000.0));
+    std::string sep = formatDouble(generateRandomDouble(-9999.9, 9999.9));
+    std::string dgps_age = formatDouble(generateRandomDouble(0.0, 999.9));
+    std::string dgps_id = std::to_string(generateRandomInt(0, 1023));
+
+    std::ostringstream oss;
+    oss << "$GPGGA,"
+        << std::setw(2) << std::setfill('0') << hours
+        << std::setw(2) << std::setfill('0') << minutes
+        << std::setw(2) << std::setfill('0') << seconds
+        << "." << std::setw(2) << std::setfill('0') << milliseconds << ","
+        << std::fixed << std::setprecision(4) << latitude << "," << lat_dir << ","
+        << std::fixed << std::setprecision(4) << longitude << "," << lon_dir << ","
+        << fix << ","
+        << nsat << ","
+        << hdop << ","
+        << altitude << ",M," << sep << ",M,,"
+        << "*" << calculateChecksum(oss.str());
+
+    return oss.str();
+}
+
+}  // namespace legacy
+
+namespace {
+
+size_t dispatch(std::string_view message) {
+    nmea::Sentence sentence;
+    if (nmea::parse(message, sentence) != nmea::ParseResult::Ok) {
+        return 0;
+    }
+    switch (sentence.type) {
+    case nmea::SentenceType::GGA:
+        return sentence.fieldCount >= 15 ? sentence.field(9).size() : 0;
+    case nmea::SentenceType::HDT:
+        return sentence.fieldCount >= 3 ? sentence.field(1).size() : 0;
+    case nmea::SentenceType::VTG:
+        return sentence.fieldCount >= 9 ? sentence.field(7).size() : 0;
+    default:
+        return 0;
+    }
+}
+
+std::vector<std::string> makeInputs() {
+    // 송신 스레드가 쓰는 "타임스탬프 - 문장" 형식, 체크섬 오류 문장 포함
+    std::vector<std::string> bodies = {
+        "$GPGGA,123519.25,4807.0380,N,01131.0000,E,1,08,0.9000,545.4000,M,46.9000,M,,*",
+        "$GPHDT,274.0700,T*",
+        "$GPVTG,054.7000,T,034.4000,M,005.5000,N,010.2000,K*",
+    };
+
+    std::vector<std::string> inputs;
+    for (const std::string& body : bodies) {
+        std::string sentence = body + legacy::calculateChecksum(body);
+        inputs.push_back("2025-01-01 12:00:00 - " + sentence);
+    }
+    std::string corrupted = inputs[0];
+    corrupted[corrupted.size() - 1] = (corrupted.back() == '0') ? '1' : '0';
+    inputs.push_back(corrupted);
+    return inputs;
+}
+
+template <typename Fn>
+double measureNsPerOp(const std::vector<std::string>& inputs, int iterations, Fn&& fn) {
+    size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink += fn(inputs[static_cast<size_t>(i) % inputs.size()]);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    // 최적화로 제거되지 않도록 결과 사용
+    if (sink == static_cast<size_t>(-1)) {
+        std::printf("%zu\n", sink);
+    }
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = (argc > 1) ? std::atoi(argv[1]) : 200000;
+    std::vector<std::string> inputs = makeInputs();
+
+    // 두 구현의 판정이 같은지 먼저 확인 (기존 분기는 체크섬을 보지 않으므로 유효한 문장만 비교)
+    for (const std::string& input : inputs) {
+        bool valid = legacy::verifyChecksum(input);
+        if (valid != nmea::verify(input) || (valid && legacy::dispatch(input) != dispatch(input))) {
+            std::fprintf(stderr, "결과 불일치: %s\n", input.c_str());
+            return 1;
+        }
+    }
+
+    double legacyVerify = measureNsPerOp(inputs, iterations, [](const std::string& s) {
+        return static_cast<size_t>(legacy::verifyChecksum(s));
+    });
+    double fastVerify = measureNsPerOp(inputs, iterations, [](const std::string& s) {
+        return static_cast<size_t>(nmea::verify(s));
+    });
+    double legacyDispatch = measureNsPerOp(inputs, iterations, [](const std::string& s) {
+        return legacy::dispatch(s);
+    });
+    double fastDispatch = measureNsPerOp(inputs, iterations, [](const std::string& s) {
+        return dispatch(s);
+    });
+    // 생성기: 같은 시드는 같은 수열, 생성된 문장은 모두 검증 통과
+    NMEAGenerator first(42);
+    NMEAGenerator second(42);
+    for (int i = 0; i < 1000; ++i) {
+        std::string sentence(first.next());
+        if (sentence != second.next() || !nmea::verify(sentence)) {
+            std::fprintf(stderr, "생성기 오류: %s\n", sentence.c_str());
+            return 1;
+        }
+    }
+
+    int generateIterations = std::max(iterations / 20, 1);
+    double legacyGenerate = measureNsPerOp(inputs, generateIterations, [](const std::string&) {
+        return legacy::generateGPGGA().size();
+    });
+    double fastGenerate = measureNsPerOp(inputs, iterations, [&first](const std::string&) {
+        return first.generateGPGGA().size();
+    });
+
+    double checksumOnly = measureNsPerOp(inputs, iterations, [](const std::string& s) {
+        return static_cast<size_t>(nmea::xorChecksum(s.data(), s.size()));
+    });
+
+    std::printf("%-28s %12s %12s %9s\n", "benchmark", "legacy(ns)", "new(ns)", "speedup");
+    std::printf("%-28s %12.1f %12.1f %8.1fx\n", "verify checksum", legacyVerify, fastVerify, legacyVerify / fastVerify);
+    std::printf("%-28s %12.1f %12.1f %8.1fx\n", "parse + dispatch", legacyDispatch, fastDispatch, legacyDispatch / fastDispatch);
+    std::printf("%-28s %12.1f %12.1f %8.1fx\n", "generate GPGGA", legacyGenerate, fastGenerate, legacyGenerate / fastGenerate);
+    std::printf("%-28s %12s %12.1f\n", "xor checksum (SSE2)", "-", checksumOnly);
+    std::printf("generator rate: %.0f sentences/s\n", 1e9 / fastGenerate);
+    return 0;
+}
@@ -0,0 +1,20 @@
+TEMPLATE = app
+TARGET = nmea_bench
+QT -= core gui
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+QMAKE_CXXFLAGS_RELEASE += -O2
+
+SOURCES += \
+    nmea_bench.cpp \
+    ../comm/NMEAParser.cpp \
+    ../comm/NMEAGenerator.cpp \
+
+HEADERS += \
+    ../comm/NMEAParser.h \
+    ../comm/NMEAGenerator.h \
+    ../comm/FastRandom.h \
+
+INCLUDEPATH += \
+    ../comm \
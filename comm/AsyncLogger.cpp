@@ -0,0 +1,335 @@
+#include "AsyncLogger.h"
+#include "CANSignalCodec.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <unistd.h>
+
+namespace {
+
+int64_t realtimeNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+int64_t monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// 환경 변수 VSENSOR_LOG_LEVEL / VSENSOR_LOG_MODE로 초기 설정
+LogLevel levelFromEnv(LogLevel fallback) {
+    const char* value = std::getenv("VSENSOR_LOG_LEVEL");
+    if (value == nullptr) return fallback;
+    if (strcmp(value, "debug") == 0) return LogLevel::Debug;
+    if (strcmp(value, "info") == 0) return LogLevel::Info;
+    if (strcmp(value, "warning") == 0) return LogLevel::Warning;
+    if (strcmp(value, "error") == 0) return LogLevel::Error;
+    if (strcmp(value, "off") == 0) return LogLevel::Off;
+    return fallback;
+}
+
+LogMode modeFromEnv(LogMode fallback) {
+    const char* value = std::getenv("VSENSOR_LOG_MODE");
+    if (value == nullptr) return fallback;
+    if (strcmp(value, "async") == 0) return LogMode::Async;
+    if (strcmp(value, "sync") == 0) return LogMode::Synchronous;
+    if (strcmp(value, "off") == 0) return LogMode::Disabled;
+    return fallback;
+}
+
+// snprintf 결과를 out에 이어 붙이고 쓴 길이 반환 (잘리면 capacity까지)
+template <typename... Args>
+size_t appendFormat(char* out, size_t capacity, size_t used, const char* format, Args... args) {
+    if (used >= capacity) return used;
+    int n = snprintf(out + used, capacity - used, format, args...);
+    if (n < 0) return used;
+    return std::min(capacity - 1, used + static_cast<size_t>(n));
+}
+
+// thread_local 핸들: 스레드 종료 시 버퍼를 retired로 표시 (남은 이벤트는 백그라운드가 마저 출력)
+struct ThreadBufferHandle {
+    std::shared_ptr<void> buffer;
+    std::atomic<bool>* retired = nullptr;
+    ~ThreadBufferHandle() {
+        if (retired) retired->store(true, std::memory_order_release);
+    }
+};
+
+thread_local ThreadBufferHandle localHandle;
+
+}  // namespace
+
+AsyncLogger& AsyncLogger::instance() {
+    static AsyncLogger logger;
+    return logger;
+}
+
+AsyncLogger::AsyncLogger() : stdoutBuffer(64 * 1024), stderrBuffer(64 * 1024) {
+    minLevel.store(levelFromEnv(LogLevel::Info));
+    outputMode.store(modeFromEnv(LogMode::Async));
+    writerThread = std::thread(&AsyncLogger::writerLoop, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+    running = false;
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+}
+
+void AsyncLogger::setLevel(LogLevel level) {
+    minLevel.store(level);
+}
+
+void AsyncLogger::setMode(LogMode mode) {
+    outputMode.store(mode);
+}
+
+AsyncLogger::ThreadBuffer& AsyncLogger::localBuffer() {
+    if (!localHandle.buffer) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        localHandle.retired = &buffer->retired;
+        localHandle.buffer = buffer;
+
+        // 스레드당 한 번만 락을 잡아 등록
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers.push_back(buffer);
+    }
+    return *static_cast<ThreadBuffer*>(localHandle.buffer.get());
+}
+
+void AsyncLogger::log(LogLevel level, LogChannel channel, LogEvent event, uint32_t id,
+                      const void* data, size_t length, int32_t value) {
+    if (!enabled(level)) {
+        return;
+    }
+
+    LogRecord record;
+    record.timestampNs = realtimeNs();
+    record.id = id;
+    record.value = value;
+    record.level = level;
+    record.channel = channel;
+    record.event = event;
+    record.length = static_cast<uint8_t>(std::min<size_t>(length, LogRecord::kMaxData));
+    if (record.length > 0) {
+        memcpy(record.data, data, record.length);
+    }
+    // 여러 반응기 스레드가 동시에 기록하므로 카운터는 스레드 버퍼별로 (lock 접두 명령 없이)
+    ThreadBuffer& buffer = localBuffer();
+    buffer.logged.store(buffer.logged.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (outputMode.load(std::memory_order_relaxed) == LogMode::Synchronous) {
+        writeSynchronously(record);
+        return;
+    }
+    buffer.ring.tryPush(record);
+}
+
+void AsyncLogger::writeSynchronously(const LogRecord& record) {
+    int64_t start = monotonicNs();
+
+    char line[512];
+    size_t length = formatRecord(record, line, sizeof(line));
+    std::ostream& stream = (record.level >= LogLevel::Warning) ? std::cerr : std::cout;
+    stream.write(line, static_cast<std::streamsize>(length));
+    stream << std::endl;  // 기존 코드와 동일하게 매 줄 flush
+
+    linesWritten.fetch_add(1, std::memory_order_relaxed);
+    bytesWritten.fetch_add(length + 1, std::memory_order_relaxed);
+    callerNs.fetch_add(static_cast<uint64_t>(monotonicNs() - start), std::memory_order_relaxed);
+}
+
+size_t AsyncLogger::formatRecord(const LogRecord& record, char* out, size_t capacity) {
+    size_t n = 0;
+    const bool fd = record.channel == LogChannel::CANFD;
+
+    switch (record.event) {
+    case LogEvent::FrameSent:
+        n = appendFormat(out, capacity, n, "%s CAN ID: 0x%x 데이터 길이: %d 데이터: ",
+                         fd ? "[CAN FD 송신]" : "[CAN 송신]", record.id, record.length);
+        for (int i = 0; i < record.length; ++i) {
+            n = appendFormat(out, capacity, n, "0x%x ", record.data[i]);
+        }
+        break;
+    case LogEvent::FrameReceived: {
+        const can_codec::MessageDesc* msg = can_codec::findMessage(record.id);
+        if (msg == nullptr || record.length < msg->sampleBytes()) {
+            n = appendFormat(out, capacity, n, "[CAN 수신] CAN ID: 0x%x", record.id);
+            break;
+        }
+        float values[can_codec::kMaxFields] = {};
+        can_codec::decode(*msg, record.data, values);
+        n = appendFormat(out, capacity, n, "%s %s | 값1=%g, 값2=%g, 값3=%g",
+                         fd ? "[CAN FD 수신]" : "[CAN 수신]", msg->name, values[0], values[1], values[2]);
+        break;
+    }
+    case LogEvent::SentenceSent:
+    case LogEvent::SentenceReceived: {
+        time_t seconds = static_cast<time_t>(record.timestampNs / 1000000000LL);
+        struct tm local;
+        localtime_r(&seconds, &local);
+        char timestamp[32];
+        strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &local);
+        n = appendFormat(out, capacity, n, "%s %s - %.*s",
+                         record.event == LogEvent::SentenceSent ? "[RS232 송신]" : "[RS232 수신]",
+                         timestamp, static_cast<int>(record.length), reinterpret_cast<const char*>(record.data));
+        break;
+    }
+    case LogEvent::ChecksumMismatch:
+        n = appendFormat(out, capacity, n, "[RS232 수신 오류] 잘못된 체크섬: %.*s",
+                         static_cast<int>(record.length), reinterpret_cast<const char*>(record.data));
+        break;
+    case LogEvent::SendFailed:
+        n = appendFormat(out, capacity, n, "[오류] %s 데이터 전송 실패: %s",
+                         record.channel == LogChannel::RS232 ? "RS232" : "CAN", strerror(record.value));
+        break;
+    case LogEvent::ReceiveFailed:
+        n = appendFormat(out, capacity, n, "[오류] %s 수신 실패: %s (errno=%d)",
+                         record.channel == LogChannel::RS232 ? "RS232" : "CAN", strerror(record.value), record.value);
+        break;
+    case LogEvent::UnknownID:
+        n = appendFormat(out, capacity, n, "[경고] 알 수 없는 CAN ID: 0x%x", record.id);
+        break;
+    case LogEvent::InvalidFrame:
+        n = appendFormat(out, capacity, n, "[경고] 잘못된 CAN 프레임: ID=0x%x, 길이=%d", record.id, record.value);
+        break;
+    case LogEvent::ErrorFrame:
+        n = appendFormat(out, capacity, n, "[경고] CAN 에러 프레임: class=0x%x", record.id);
+        break;
+    case LogEvent::SocketClosed:
+        n = appendFormat(out, capacity, n, "[정보] 소켓 닫힘: %.*s", static_cast<int>(record.length),
+                         reinterpret_cast<const char*>(record.data));
+        break;
+    }
+    return n;
+}
+
+size_t AsyncLogger::drainOnce() {
+    static constexpr size_t kBatch = 256;
+    const size_t kOutputCapacity = stdoutBuffer.size();
+    LogRecord batch[kBatch];
+    std::vector<char>& outBuffer = stdoutBuffer;
+    std::vector<char>& errBuffer = stderrBuffer;
+    size_t outUsed = 0, errUsed = 0;
+    size_t total = 0;
+
+    auto flushBuffer = [this](int fd, std::vector<char>& buffer, size_t& used) {
+        size_t offset = 0;
+        while (offset < used) {
+            ssize_t written = ::write(fd, buffer.data() + offset, used - offset);
+            if (written <= 0) break;
+            offset += static_cast<size_t>(written);
+        }
+        bytesWritten.fetch_add(used, std::memory_order_relaxed);
+        used = 0;
+    };
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto it = buffers.begin(); it != buffers.end();) {
+        ThreadBuffer& buffer = **it;
+        bool retired = buffer.retired.load(std::memory_order_acquire);
+
+        size_t n;
+        while ((n = buffer.ring.popBatch(batch, kBatch)) > 0) {
+            total += n;
+            for (size_t i = 0; i < n; ++i) {
+                bool isError = batch[i].level >= LogLevel::Warning;
+                std::vector<char>& target = isError ? errBuffer : outBuffer;
+                size_t& used = isError ? errUsed : outUsed;
+                if (kOutputCapacity - used < 1024) {
+                    flushBuffer(isError ? STDERR_FILENO : STDOUT_FILENO, target, used);
+                }
+                used += formatRecord(batch[i], target.data() + used, kOutputCapacity - used - 1);
+                target[used++] = '\n';
+            }
+        }
+
+        // 종료된 스레드의 버퍼는 비운 뒤 제거
+        if (retired && buffer.ring.size() == 0) {
+            droppedRetired.fetch_add(buffer.ring.dropped(), std::memory_order_relaxed);
+            loggedRetired.fetch_add(buffer.logged.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            it = buffers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    flushBuffer(STDOUT_FILENO, outBuffer, outUsed);
+    flushBuffer(STDERR_FILENO, errBuffer, errUsed);
+    linesWritten.fetch_add(total, std::memory_order_relaxed);
+    return total;
+}
+
+void AsyncLogger::writerLoop() {
+    while (running) {
+        int64_t start = monotonicNs();
+        size_t drained = drainOnce();
+        if (drained > 0) {
+            writerNs.fetch_add(static_cast<uint64_t>(monotonicNs() - start), std::memory_order_relaxed);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    drainOnce();  // 종료 전 남은 이벤트 출력
+}
+
+void AsyncLogger::flush() {
+    for (;;) {
+        bool empty = true;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            for (const auto& buffer : buffers) {
+                if (buffer->ring.size() > 0) {
+                    empty = false;
+                    break;
+                }
+            }
+        }
+        if (empty || !running) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+LoggerStats AsyncLogger::stats() const {
+    uint64_t dropped = droppedRetired.load(std::memory_order_relaxed);
+    uint64_t logged = totalLogged();
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto& buffer : buffers) {
+            dropped += buffer->ring.dropped();
+        }
+    }
+    return {logged - loggedBase.load(std::memory_order_relaxed),
+            dropped,
+            linesWritten.load(std::memory_order_relaxed),
+            bytesWritten.load(std::memory_order_relaxed),
+            callerNs.load(std::memory_order_relaxed),
+            writerNs.load(std::memory_order_relaxed)};
+}
+
+uint64_t AsyncLogger::totalLogged() const {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    uint64_t logged = loggedRetired.load(std::memory_order_relaxed);
+    for (const auto& buffer : buffers) {
+        logged += buffer->logged.load(std::memory_order_relaxed);
+    }
+    return logged;
+}
+
+void AsyncLogger::resetStats() {
+    loggedBase.store(totalLogged());
+    linesWritten.store(0);
+    bytesWritten.store(0);
+    callerNs.store(0);
+    writerNs.store(0);
+}
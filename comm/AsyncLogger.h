@@ -0,0 +1,134 @@
+#ifndef ASYNCLOGGER_H
+#define ASYNCLOGGER_H
+
+#include "SPSCRing.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+enum class LogChannel : uint8_t {
+    CAN,
+    CANFD,
+    RS232
+};
+
+// 이벤트 종류 (문자열 포맷은 백그라운드 스레드에서 이벤트별로 결정)
+enum class LogEvent : uint8_t {
+    FrameSent,          // data: 페이로드
+    FrameReceived,      // data: 페이로드, value: 샘플 인덱스
+    SentenceSent,       // data: NMEA 문장
+    SentenceReceived,   // data: NMEA 문장
+    ChecksumMismatch,   // data: NMEA 문장
+    SendFailed,         // value: errno
+    ReceiveFailed,      // value: errno
+    UnknownID,
+    InvalidFrame,       // value: 길이
+    ErrorFrame,         // id: 에러 클래스
+    SocketClosed        // data: 인터페이스 이름
+};
+
+// 로그 출력 방식
+enum class LogMode {
+    Async,        // 스레드별 링에 바이너리 이벤트 기록, 백그라운드 스레드가 포맷팅/출력
+    Synchronous,  // 호출 스레드에서 바로 std::cout/std::cerr 출력 (기존 방식, 비교용)
+    Disabled      // 콘솔 출력 없음
+};
+
+struct LogRecord {
+    static constexpr int kMaxData = 108;  // 타임스탬프 접두어가 붙은 NMEA 문장까지 수용
+
+    int64_t timestampNs;  // CLOCK_REALTIME
+    uint32_t id;
+    int32_t value;
+    LogLevel level;
+    LogChannel channel;
+    LogEvent event;
+    uint8_t length;
+    uint8_t data[kMaxData];
+};
+
+static_assert(sizeof(LogRecord) == 128, "LogRecord는 캐시 라인 2개 크기로 유지");
+
+// 출력 비용 측정용 누적 통계
+struct LoggerStats {
+    uint64_t eventsLogged;    // 기록된 이벤트 수
+    uint64_t eventsDropped;   // 스레드 링이 가득 차서 버린 수
+    uint64_t linesWritten;
+    uint64_t bytesWritten;
+    uint64_t callerNs;        // 호출 스레드에서 로그 처리에 쓴 시간 (Synchronous 모드)
+    uint64_t writerNs;        // 백그라운드 스레드가 포맷팅/출력에 쓴 시간 (Async 모드)
+};
+
+class AsyncLogger {
+public:
+    static AsyncLogger& instance();
+    ~AsyncLogger();
+
+    void setLevel(LogLevel level);
+    void setMode(LogMode mode);
+    LogLevel level() const { return minLevel.load(std::memory_order_relaxed); }
+    LogMode mode() const { return outputMode.load(std::memory_order_relaxed); }
+
+    bool enabled(LogLevel level) const {
+        return level >= minLevel.load(std::memory_order_relaxed) &&
+               outputMode.load(std::memory_order_relaxed) != LogMode::Disabled;
+    }
+
+    // 핫 패스용: 할당 / 락 없이 호출 스레드 링에 기록
+    void log(LogLevel level, LogChannel channel, LogEvent event, uint32_t id,
+             const void* data = nullptr, size_t length = 0, int32_t value = 0);
+
+    void flush();  // 지금까지 기록된 이벤트를 모두 출력할 때까지 대기
+    LoggerStats stats() const;
+    void resetStats();
+
+    static constexpr size_t kThreadBufferCapacity = 4096;
+
+private:
+    struct ThreadBuffer {
+        SPSCRing<LogRecord, kThreadBufferCapacity> ring;
+        std::atomic<bool> retired{false};  // 소유 스레드 종료됨
+        std::atomic<uint64_t> logged{0};   // 소유 스레드만 증가 (스레드 간 공유 카운터 경합 방지)
+    };
+
+    AsyncLogger();
+    ThreadBuffer& localBuffer();
+    void writerLoop();
+    size_t drainOnce();
+    static size_t formatRecord(const LogRecord& record, char* out, size_t capacity);
+    void writeSynchronously(const LogRecord& record);
+    uint64_t totalLogged() const;
+
+    std::atomic<LogLevel> minLevel{LogLevel::Info};
+    std::atomic<LogMode> outputMode{LogMode::Async};
+
+    mutable std::mutex registryMutex;  // 스레드 버퍼 등록 / 백그라운드 순회
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::vector<char> stdoutBuffer;  // 백그라운드 스레드 전용 출력 버퍼
+    std::vector<char> stderrBuffer;
+
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> loggedRetired{0};   // 제거된 버퍼의 logged 누적
+    std::atomic<uint64_t> loggedBase{0};      // resetStats() 시점의 logged 합계
+    std::atomic<uint64_t> droppedRetired{0};  // 제거된 버퍼의 dropped 누적
+    std::atomic<uint64_t> linesWritten{0};
+    std::atomic<uint64_t> bytesWritten{0};
+    std::atomic<uint64_t> callerNs{0};
+    std::atomic<uint64_t> writerNs{0};
+    std::thread writerThread;
+};
+
+#endif // ASYNCLOGGER_H
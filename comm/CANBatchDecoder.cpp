@@ -0,0 +1,142 @@
+#include "CANBatchDecoder.h"
+#include <cstring>
+
+#ifdef VSENSOR_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// 물리값 = raw * scale + offset을 곱셈과 덧셈 두 번의 반올림으로 계산해야 스칼라 경로와 같은 값이 나온다.
+// 그래서 AVX2 경로는 fma를 켜지 않고, 빌드는 -ffp-contract=off로 스칼라 쪽 융합도 막는다.
+
+namespace {
+
+void decodeScalar(const can_codec::MessageDesc& msg, const uint8_t* base, const uint32_t* offsets, size_t begin,
+                  size_t count, float* const* out) {
+    for (int f = 0; f < msg.fieldCount; ++f) {
+        const can_codec::SignalDesc& signal = msg.fields[f];
+        float* column = out[f];
+        for (size_t i = begin; i < count; ++i) {
+            const uint8_t* in = base + offsets[i] + signal.byteOffset;
+            uint16_t raw = static_cast<uint16_t>(in[0] | (in[1] << 8));
+            column[i] = can_codec::fromRaw(signal, raw);
+        }
+    }
+}
+
+#ifdef VSENSOR_X86_SIMD
+
+// 필드 앞 2바이트부터 읽은 32비트 값의 상위 16비트 = little-endian raw
+// (UInt16은 논리 시프트, Int16은 산술 시프트로 부호 확장)
+inline int32_t loadFieldWord(const uint8_t* field) {
+    int32_t word;
+    memcpy(&word, field - 2, sizeof(word));
+    return word;
+}
+
+void decodeSSE2(const can_codec::MessageDesc& msg, const uint8_t* base, const uint32_t* offsets, size_t count,
+                float* const* out) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        for (int f = 0; f < msg.fieldCount; ++f) {
+            const can_codec::SignalDesc& signal = msg.fields[f];
+            const uint8_t* field = base + signal.byteOffset;
+            __m128i words = _mm_set_epi32(loadFieldWord(field + offsets[i + 3]), loadFieldWord(field + offsets[i + 2]),
+                                          loadFieldWord(field + offsets[i + 1]), loadFieldWord(field + offsets[i]));
+            __m128i fieldRaw = signal.rawType == can_codec::RawType::Int16 ? _mm_srai_epi32(words, 16)
+                                                                           : _mm_srli_epi32(words, 16);
+            __m128 raw = _mm_cvtepi32_ps(fieldRaw);
+            __m128 value = _mm_add_ps(_mm_mul_ps(raw, _mm_set1_ps(signal.scale)), _mm_set1_ps(signal.offset));
+            _mm_storeu_ps(out[f] + i, value);
+        }
+    }
+    decodeScalar(msg, base, offsets, i, count, out);
+}
+
+__attribute__((target("avx2")))
+void decodeAVX2(const can_codec::MessageDesc& msg, const uint8_t* base, const uint32_t* offsets, size_t count,
+                float* const* out) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i sampleOffsets = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + i));
+        for (int f = 0; f < msg.fieldCount; ++f) {
+            const can_codec::SignalDesc& signal = msg.fields[f];
+            __m256i index = _mm256_add_epi32(sampleOffsets, _mm256_set1_epi32(signal.byteOffset - 2));
+            __m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base), index, 1);
+            __m256i fieldRaw = signal.rawType == can_codec::RawType::Int16 ? _mm256_srai_epi32(words, 16)
+                                                                           : _mm256_srli_epi32(words, 16);
+            __m256 raw = _mm256_cvtepi32_ps(fieldRaw);
+            __m256 value = _mm256_add_ps(_mm256_mul_ps(raw, _mm256_set1_ps(signal.scale)),
+                                         _mm256_set1_ps(signal.offset));
+            _mm256_storeu_ps(out[f] + i, value);
+        }
+    }
+    decodeScalar(msg, base, offsets, i, count, out);
+}
+
+#endif
+
+}  // namespace
+
+void decodeSamples(const can_codec::MessageDesc& msg, const uint8_t* base, const uint32_t* offsets, size_t count,
+                   float* const* out, SimdLevel kernel) {
+    switch (kernel) {
+#ifdef VSENSOR_X86_SIMD
+    case SimdLevel::AVX2:
+        decodeAVX2(msg, base, offsets, count, out);
+        return;
+    case SimdLevel::SSE2:
+        decodeSSE2(msg, base, offsets, count, out);
+        return;
+#endif
+    default:
+        decodeScalar(msg, base, offsets, 0, count, out);
+        return;
+    }
+}
+
+CANBatchDecoder::CANBatchDecoder(SimdLevel kernel) {
+    setKernel(kernel);
+}
+
+void CANBatchDecoder::setKernel(SimdLevel kernel) {
+    activeKernel = simdLevelAvailable(kernel) ? kernel : SimdLevel::Scalar;
+}
+
+void CANBatchDecoder::reset(const uint8_t* newBase) {
+    base = newBase;
+    for (std::vector<uint32_t>& pending : offsets) {
+        pending.clear();
+    }
+}
+
+uint32_t CANBatchDecoder::add(int messageIndex, const uint8_t* samples, int sampleCount) {
+    std::vector<uint32_t>& pending = offsets[messageIndex];
+    size_t first = pending.size();
+    pending.resize(first + sampleCount);
+    const int sampleBytes = can_codec::kMessages[messageIndex].sampleBytes();
+    uint32_t offset = static_cast<uint32_t>(samples - base);
+    uint32_t* out = pending.data() + first;
+    for (int s = 0; s < sampleCount; ++s) {
+        out[s] = offset + static_cast<uint32_t>(s * sampleBytes);
+    }
+    return static_cast<uint32_t>(first);
+}
+
+void CANBatchDecoder::decode() {
+    for (size_t m = 0; m < can_codec::kMessageCount; ++m) {
+        const std::vector<uint32_t>& pending = offsets[m];
+        DecodedColumns& columns = decoded[m];
+        columns.count = pending.size();
+        if (pending.empty()) {
+            continue;
+        }
+        float* out[can_codec::kMaxFields] = {};
+        for (int f = 0; f < can_codec::kMessages[m].fieldCount; ++f) {
+            if (columns.values[f].size() < pending.size()) {
+                columns.values[f].resize(pending.size());
+            }
+            out[f] = columns.values[f].data();
+        }
+        decodeSamples(can_codec::kMessages[m], base, pending.data(), pending.size(), out, activeKernel);
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef CANBATCHDECODER_H
+#define CANBATCHDECODER_H
+
+#include "CANSignalCodec.h"
+#include "SimdDispatch.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// 여러 샘플을 한 번에 디코딩: i번째 샘플은 base + offsets[i], 결과는 out[f][i] (f < msg.fieldCount)
+// 어느 커널이든 can_codec::decode()와 비트 단위로 같은 값을 낸다.
+// SIMD 경로는 필드 앞 2바이트부터 32비트로 모아 읽으므로 offsets[i] + byteOffset >= 2여야 하고
+// 그 2바이트도 읽을 수 있어야 한다 (canfd_frame 버퍼 안의 샘플이면 항상 만족).
+void decodeSamples(const can_codec::MessageDesc& msg, const uint8_t* base, const uint32_t* offsets, size_t count,
+                   float* const* out, SimdLevel kernel);
+
+// 메시지 하나의 디코딩 결과 (필드별 배열)
+struct DecodedColumns {
+    std::array<std::vector<float>, can_codec::kMaxFields> values;
+    size_t count{0};
+};
+
+// 수신 배치의 샘플을 메시지(kMessages 인덱스)별로 모았다가 한 번에 디코딩
+// 반응기 스레드 전용. 버퍼는 배치 크기만큼 자란 뒤에는 재할당하지 않는다.
+class CANBatchDecoder {
+public:
+    explicit CANBatchDecoder(SimdLevel kernel = bestSimdLevel());
+
+    void setKernel(SimdLevel kernel);  // 사용할 수 없는 커널이면 스칼라
+    SimdLevel kernel() const { return activeKernel; }
+
+    // 새 배치 시작 (base: 샘플이 들어 있는 수신 버퍼의 시작)
+    void reset(const uint8_t* base);
+    // samples부터 sampleBytes 간격의 샘플 sampleCount개 추가
+    // 반환: columns(messageIndex)에서 첫 샘플의 위치
+    uint32_t add(int messageIndex, const uint8_t* samples, int sampleCount);
+    void decode();
+
+    const DecodedColumns& columns(int messageIndex) const { return decoded[messageIndex]; }
+
+private:
+    SimdLevel activeKernel;
+    const uint8_t* base{nullptr};
+    std::array<std::vector<uint32_t>, can_codec::kMessageCount> offsets;
+    std::array<DecodedColumns, can_codec::kMessageCount> decoded;
+};
+
+#endif // CANBATCHDECODER_H
@@ -0,0 +1,165 @@
+#include "CANBusGroup.h"
+#include "PeriodicScheduler.h"
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+#include <stdexcept>
+#include <sched.h>
+
+CANBusGroup::CANBusGroup(const std::vector<std::string>& interfaces, bool pinWorkers) {
+    if (interfaces.size() > kMaxBuses) {
+        std::cerr << "[오류] CAN 버스 수 초과: " << interfaces.size() << " (최대 " << kMaxBuses << ")" << std::endl;
+        throw std::runtime_error("CAN 버스 수 초과");
+    }
+
+    for (const std::string& name : interfaces) {
+        if (name.empty() || name.size() >= IFNAMSIZ) {
+            std::cerr << "[오류] 잘못된 CAN 인터페이스 이름: '" << name << "'" << std::endl;
+            throw std::runtime_error("잘못된 CAN 인터페이스 이름");
+        }
+    }
+
+    std::vector<int> cpus = pinWorkers ? availableCpus() : std::vector<int>();
+    if (pinWorkers && interfaces.size() > cpus.size()) {
+        std::cerr << "[경고] CAN 버스 " << interfaces.size() << "개가 코어 " << cpus.size()
+                  << "개를 공유함 (선형 확장 불가)" << std::endl;
+    }
+
+    for (size_t i = 0; i < interfaces.size(); ++i) {
+        auto entry = std::make_unique<Bus>();
+        entry->cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+        entry->reactor = std::make_unique<EventReactor>("vsensor-can-" + std::to_string(i));
+        entry->reactor->start(entry->cpu);
+
+        entry->comm = std::make_unique<CANCommunication>(interfaces[i]);
+        entry->comm->setBusIndex(static_cast<uint8_t>(i));
+        entry->comm->setReactor(entry->reactor.get());
+        buses.push_back(std::move(entry));
+    }
+    lastSampleNs = PeriodicScheduler::monotonicNs();
+}
+
+CANBusGroup::~CANBusGroup() {
+    // 채널이 반응기보다 먼저 해제되어야 함 (detach()가 반응기 스레드에서 실행)
+    for (auto& entry : buses) {
+        entry->comm.reset();
+        entry->reactor->stop();
+    }
+}
+
+std::vector<int> CANBusGroup::availableCpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    return cpus;
+}
+
+void CANBusGroup::startAll() {
+    waitAll([this](const BusTransitionCallback& done) { startAllAsync(done); });
+}
+
+void CANBusGroup::stopAll() {
+    waitAll([this](const BusTransitionCallback& done) { stopAllAsync(done); });
+}
+
+void CANBusGroup::startAllAsync(const BusTransitionCallback& done) {
+    for (size_t i = 0; i < buses.size(); ++i) {
+        CANCommunication& comm = *buses[i]->comm;
+        comm.enableCANSend(true);
+        comm.startAsync(done ? [done, i](const ChannelTransition& result) { done(i, result); } : TransitionCallback());
+    }
+}
+
+void CANBusGroup::stopAllAsync(const BusTransitionCallback& done) {
+    for (size_t i = 0; i < buses.size(); ++i) {
+        CANCommunication& comm = *buses[i]->comm;
+        comm.enableCANSend(false);
+        comm.stopAsync(done ? [done, i](const ChannelTransition& result) { done(i, result); } : TransitionCallback());
+    }
+}
+
+void CANBusGroup::waitAll(const std::function<void(const BusTransitionCallback&)>& request) {
+    std::mutex mutex;
+    std::condition_variable finished;
+    size_t remaining = buses.size();
+    request([&](size_t, const ChannelTransition&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--remaining == 0) {
+            finished.notify_one();
+        }
+    });
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return remaining == 0; });
+}
+
+bool CANBusGroup::anyConnected() const {
+    return std::any_of(buses.begin(), buses.end(),
+                       [](const std::unique_ptr<Bus>& entry) { return entry->comm->isConnected(); });
+}
+
+std::vector<CANBusStats> CANBusGroup::sampleStats() {
+    int64_t now = PeriodicScheduler::monotonicNs();
+    double elapsedSec = std::max<int64_t>(now - lastSampleNs, 1) / 1e9;
+    lastSampleNs = now;
+
+    std::vector<CANBusStats> stats;
+    stats.reserve(buses.size());
+    for (auto& entry : buses) {
+        CANTrafficStats traffic = entry->comm->trafficStats();
+        CANBusStats bus;
+        bus.interfaceName = entry->comm->interface();
+        bus.cpu = entry->cpu;
+        bus.traffic = traffic;
+        bus.framesSentPerSec = (traffic.framesSent - entry->lastTraffic.framesSent) / elapsedSec;
+        bus.framesReceivedPerSec = (traffic.framesReceived - entry->lastTraffic.framesReceived) / elapsedSec;
+        entry->lastTraffic = traffic;
+        stats.push_back(bus);
+    }
+    return stats;
+}
+
+CANBusStats CANBusGroup::aggregate(const std::vector<CANBusStats>& stats) {
+    CANBusStats total{};
+    total.interfaceName = "total";
+    total.cpu = -1;
+    for (const CANBusStats& bus : stats) {
+        total.traffic.framesSent += bus.traffic.framesSent;
+        total.traffic.samplesSent += bus.traffic.samplesSent;
+        total.traffic.payloadBytesSent += bus.traffic.payloadBytesSent;
+        total.traffic.framesReceived += bus.traffic.framesReceived;
+        total.traffic.samplesReceived += bus.traffic.samplesReceived;
+        total.traffic.writeFailures += bus.traffic.writeFailures;
+        total.traffic.unknownIDs += bus.traffic.unknownIDs;
+        total.traffic.invalidFrames += bus.traffic.invalidFrames;
+        total.framesSentPerSec += bus.framesSentPerSec;
+        total.framesReceivedPerSec += bus.framesReceivedPerSec;
+    }
+    return total;
+}
+
+std::vector<std::string> CANBusGroup::parseInterfaceList(const std::string& text) {
+    std::vector<std::string> interfaces;
+    std::string current;
+    auto flush = [&] {
+        if (!current.empty() && std::find(interfaces.begin(), interfaces.end(), current) == interfaces.end()) {
+            interfaces.push_back(current);
+        }
+        current.clear();
+    };
+    for (char c : text) {
+        if (c == ',' || c == ' ' || c == '\t' || c == ';') {
+            flush();
+        } else {
+            current += c;
+        }
+    }
+    flush();
+    return interfaces;
+}
@@ -0,0 +1,72 @@
+#ifndef CANBUSGROUP_H
+#define CANBUSGROUP_H
+
+#include "CANCommunication.h"
+#include "EventReactor.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 버스 하나의 처리량 (sampleStats() 호출 간격 기준 초당 값)
+struct CANBusStats {
+    std::string interfaceName;
+    int cpu;                      // 반응기 스레드가 고정된 코어 (-1: 고정 안 함)
+    CANTrafficStats traffic;      // 누적 카운터
+    double framesSentPerSec;
+    double framesReceivedPerSec;
+};
+
+// 여러 CAN 인터페이스를 한 프로세스에서 구동
+// 버스마다 전용 반응기 스레드(자기 코어에 고정)와 자기 소켓 / 링 / 카운터를 가지므로
+// 버스 사이에 공유하는 락이 없다. 수신 레코드에는 버스 인덱스가 기록된다.
+class CANBusGroup {
+public:
+    static constexpr size_t kMaxBuses = 255;  // CommRecord::bus (uint8_t)
+
+    // pinWorkers: 버스 i의 반응기를 사용 가능한 코어 목록의 (i % 코어 수)번째에 고정
+    explicit CANBusGroup(const std::vector<std::string>& interfaces, bool pinWorkers = true);
+    ~CANBusGroup();
+
+    CANBusGroup(const CANBusGroup&) = delete;
+    CANBusGroup& operator=(const CANBusGroup&) = delete;
+
+    size_t size() const { return buses.size(); }
+    CANCommunication& bus(size_t index) { return *buses[index]->comm; }
+    const std::string& interfaceName(size_t index) const { return buses[index]->comm->interface(); }
+    int cpu(size_t index) const { return buses[index]->cpu; }
+
+    using BusTransitionCallback = std::function<void(size_t bus, const ChannelTransition& result)>;
+
+    // 모든 버스에 요청한 뒤 전부 끝날 때까지 대기 (버스마다 자기 반응기에서 동시에 등록 / 해제)
+    void startAll();
+    void stopAll();
+    // 기다리지 않는 시작 / 정지. done은 버스마다 그 버스의 반응기 스레드에서 호출됨
+    void startAllAsync(const BusTransitionCallback& done = nullptr);
+    void stopAllAsync(const BusTransitionCallback& done = nullptr);
+    bool anyConnected() const;
+
+    // 버스별 누적 카운터와 이전 호출 이후 초당 프레임 수 (UI 스레드 전용)
+    std::vector<CANBusStats> sampleStats();
+    static CANBusStats aggregate(const std::vector<CANBusStats>& stats);
+
+    // "vcan0, vcan1 vcan2" -> {"vcan0", "vcan1", "vcan2"} (쉼표 / 세미콜론 / 공백 구분, 중복 제거)
+    static std::vector<std::string> parseInterfaceList(const std::string& text);
+
+private:
+    struct Bus {
+        std::unique_ptr<EventReactor> reactor;
+        std::unique_ptr<CANCommunication> comm;
+        int cpu{-1};
+        CANTrafficStats lastTraffic{};
+    };
+
+    std::vector<std::unique_ptr<Bus>> buses;
+    int64_t lastSampleNs{0};
+
+    static std::vector<int> availableCpus();
+    void waitAll(const std::function<void(const BusTransitionCallback&)>& request);
+};
+
+#endif // CANBUSGROUP_H
@@ -1,233 +1,791 @@
 #include "CANCommunication.h"
+#include "AsyncLogger.h"
 #include <iostream>
 #include <stdexcept>
 #include <chrono>
-#include <thread>
 #include <fcntl.h>
-#include <poll.h>
+#include <sys/epoll.h>
+#include <algorithm>
+#include <ctime>
+#include <linux/net_tstamp.h>
+#include <linux/errqueue.h>
 
-CANCommunication::CANCommunication(const std::string& interfaceName) : interfaceName(interfaceName) {
-    idDataRanges = {
-        {0x19FF1000, {-64.0f, 64.51f}},  // 차량 방향각
-        {0x19FF1001, {-320.0f, 322.55f}}, // 차량 속도
-        {0x19FF1002, {-250.0f, 250.99f}}  // 차량 자세 데이터
-    };
+CANCommunication::CANCommunication(const std::string& interfaceName)
+    : interfaceName(interfaceName), signalSeedValue(std::random_device{}()) {
+    MetricsRegistry::instance().add(this);
 }
 
 CANCommunication::~CANCommunication() {
+    MetricsRegistry::instance().remove(this);
     stop();
     if (socket_fd >= 0) {
-        close(socket_fd);
-        std::cout << "[정보] 소켓 닫힘" << std::endl;
+        closeSocket();
+        AsyncLogger::instance().log(LogLevel::Info, LogChannel::CAN, LogEvent::SocketClosed, 0,
+                                    interfaceName.data(), interfaceName.size());
     }
 }
 
-void CANCommunication::initializeSocket(int& socket_fd, struct sockaddr_can& addr, struct ifreq& ifr) {
-    socket_fd = socket(PF_CAN, SOCK_RAW, CAN_RAW);
-    if (socket_fd < 0) {
+int CANCommunication::initializeSocket() {
+    // 설정이 끝날 때까지 멤버에 공개하지 않음 (필터 설치와 공개는 attach()에서 filterMutex 안에서)
+    struct sockaddr_can addr = {};
+    struct ifreq ifr = {};
+    int fd = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (fd < 0) {
         std::cerr << "[오류] 소켓 생성 실패" << std::endl;
         throw std::runtime_error("소켓 생성 실패");
     }
 
     strcpy(ifr.ifr_name, interfaceName.c_str());
-    if (ioctl(socket_fd, SIOCGIFINDEX, &ifr) < 0) {
+    if (ioctl(fd, SIOCGIFINDEX, &ifr) < 0) {
         std::cerr << "[오류] 인터페이스 설정 실패: " << interfaceName << std::endl;
-        close(socket_fd);
+        close(fd);
         throw std::runtime_error("인터페이스 설정 실패");
     }
 
     addr.can_family = AF_CAN;
     addr.can_ifindex = ifr.ifr_ifindex;
 
-    if (bind(socket_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
         std::cerr << "[오류] 소켓 바인딩 실패" << std::endl;
-        close(socket_fd);
+        close(fd);
         throw std::runtime_error("소켓 바인딩 실패");
     }
 
     // 자신이 보낸 메시지도 수신하도록 설정.
     int recvOwn = 1;
-    if (setsockopt(socket_fd, SOL_CAN_RAW, CAN_RAW_RECV_OWN_MSGS, &recvOwn, sizeof(recvOwn)) < 0) {
+    if (setsockopt(fd, SOL_CAN_RAW, CAN_RAW_RECV_OWN_MSGS, &recvOwn, sizeof(recvOwn)) < 0) {
         std::cerr << "[오류] CAN_RAW_RECV_OWN_MSGS 옵션 설정 실패: " << strerror(errno) << std::endl;
     }
 
-    // std::cout << "[디버깅] CAN 소켓 초기화 완료: socket_fd=" << socket_fd << std::endl;
-    this->socket_fd = socket_fd;
+    // 커널 수신 타임스탬프 (SO_TIMESTAMPING 실패 시 SO_TIMESTAMPNS)
+    int tsFlags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &tsFlags, sizeof(tsFlags)) < 0) {
+        int enableTsNs = 1;
+        if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &enableTsNs, sizeof(enableTsNs)) < 0) {
+            std::cerr << "[경고] 커널 수신 타임스탬프 설정 실패: " << strerror(errno) << std::endl;
+        }
+    }
+
+    // CAN FD 프레임 송수신 허용 (Classic 프레임은 그대로 수신됨)
+    int enableFD = 1;
+    fdFramesEnabled = setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enableFD, sizeof(enableFD)) == 0;
+    if (!fdFramesEnabled) {
+        std::cerr << "[경고] CAN_RAW_FD_FRAMES 옵션 설정 실패: " << strerror(errno) << std::endl;
+    } else if (ioctl(fd, SIOCGIFMTU, &ifr) == 0 && ifr.ifr_mtu != CANFD_MTU) {
+        std::cerr << "[경고] " << interfaceName << " MTU가 CAN FD를 지원하지 않음 (mtu=" << ifr.ifr_mtu
+                  << "), 'ip link set " << interfaceName << " mtu 72' 필요" << std::endl;
+    }
+
+    return fd;
 }
 
-float CANCommunication::generateRandomValue(float minValue, float maxValue) {
-    std::uniform_real_distribution<float> distribution(minValue, maxValue);
-    return distribution(randomEngine);
+void CANCommunication::applyReceiveFilter(int fd) {
+    // 활성화된 메시지 ID마다 정확히 일치하는 필터 하나 (EFF/RTR 비트까지 비교) + 메시지 일정 ID 범위
+    std::vector<struct can_filter> filters;
+    if (receiveAllIDs.load()) {
+        // 마스크 0: 모든 ID 통과
+        filters.push_back({0, 0});
+    } else {
+        uint64_t enabled = enabledMessages.load();
+        for (size_t m = 0; m < can_codec::kMessageCount; ++m) {
+            if (enabled & (1ull << m)) {
+                filters.push_back({can_codec::kMessages[m].id, CAN_EFF_FLAG | CAN_RTR_FLAG | CAN_EFF_MASK});
+            }
+        }
+        filters.insert(filters.end(), scheduleFilters.begin(), scheduleFilters.end());
+    }
+
+    // 필터가 0개이면 모든 프레임 차단
+    if (setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, filters.data(), filters.size() * sizeof(struct can_filter)) < 0) {
+        std::cerr << "[오류] CAN_RAW_FILTER 설정 실패: " << strerror(errno) << std::endl;
+    }
+
+    can_err_mask_t errMask = errorFilterMask.load();
+    if (setsockopt(fd, SOL_CAN_RAW, CAN_RAW_ERR_FILTER, &errMask, sizeof(errMask)) < 0) {
+        std::cerr << "[오류] CAN_RAW_ERR_FILTER 설정 실패: " << strerror(errno) << std::endl;
+    }
 }
 
-int CANCommunication::generateRandomCANID() {
-    std::vector<int> possibleIDs = {0x19FF1000, 0x19FF1001, 0x19FF1002};
-    std::uniform_int_distribution<int> distribution(0, possibleIDs.size() - 1);
-    return possibleIDs[distribution(randomEngine)];
+void CANCommunication::closeSocket() {
+    std::lock_guard<std::mutex> lock(filterMutex);
+    if (socket_fd >= 0) {
+        close(socket_fd);
+        socket_fd = -1;
+    }
 }
 
-void CANCommunication::sendIMUData() {
-    struct can_frame frame;
+namespace {
 
-    while (connected && canSendEnabled) {
-        std::vector<int> sensorIDs = {0x19FF1000, 0x19FF1001, 0x19FF1002};
+int64_t realtimeNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// recvmsg 제어 메시지에서 커널 수신 타임스탬프(CLOCK_REALTIME) 추출, 없으면 0
+int64_t kernelTimestampNs(struct msghdr& msg) {
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET) {
+            continue;
+        }
+        if (cmsg->cmsg_type == SCM_TIMESTAMPING) {
+            struct scm_timestamping tss;
+            memcpy(&tss, CMSG_DATA(cmsg), sizeof(tss));
+            return static_cast<int64_t>(tss.ts[0].tv_sec) * 1000000000LL + tss.ts[0].tv_nsec;  // ts[0]: 소프트웨어 타임스탬프
+        }
+        if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            struct timespec ts;
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+        }
+    }
+    return 0;
+}
+
+// FD 프레임에서 허용되는 데이터 길이 중 bytes 이상인 최소값
+uint8_t fdPayloadLength(size_t bytes) {
+    static const uint8_t validLengths[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
+    for (uint8_t len : validLengths) {
+        if (len >= bytes) {
+            return len;
+        }
+    }
+    return CANFD_MAX_DLEN;
+}
+
+}  // namespace
 
-        for (int canID : sensorIDs) {
-            frame.can_id = canID;
-            frame.can_dlc = 6;  // IMU 데이터는 6바이트
+void CANCommunication::encodeIMUSample(const can_codec::MessageDesc& msg, IMUSignalSet& signalSet, size_t stream,
+                                       uint8_t* out) {
+    // 미리 생성해 둔 센서 값을 변환 (신호 범위 제한은 encode()에서)
+    float values[can_codec::kMaxFields] = {};
+    signalSet.next(stream, values);
+    can_codec::encode(msg, values, out);
+}
+
+int64_t CANCommunication::sampleIntervalNs(uint8_t layout, int64_t periodNs) const {
+    // 샘플 간격 = 송신 주기 / 프레임당 샘플 수 (fillFDFrame과 같은 계산)
+    if (!fdMode.load()) {
+        return periodNs;
+    }
+    int samples = std::min(fdSamplesPerFrame.load(), (CANFD_MAX_DLEN - 1) / can_codec::kMessages[layout].sampleBytes());
+    return periodNs / std::max(samples, 1);
+}
 
-            float scale, offset, minValue, maxValue;
+void CANCommunication::configureCycleSignals() {
+    // 고정 주기 송신은 가상 센서 하나
+    std::vector<IMUSignalStream> streams;
+    for (size_t m = 0; m < can_codec::kMessageCount; ++m) {
+        uint8_t layout = static_cast<uint8_t>(m);
+        streams.push_back({0, layout, sampleIntervalNs(layout, sendScheduler.period())});
+    }
+    cycleSignals.configure(streams, signalSeedValue.load());
+}
 
-            // 센서 ID별 데이터 범위 및 변환값 설정
-            if (canID == 0x19FF1000) {  // Roll/Pitch/Yaw
-                scale = 0.002f; offset = -64.0f;
-                minValue = -64.0f; maxValue = 64.51f;
-            } else if (canID == 0x19FF1001) {  // Accel_X/Y/Z
-                scale = 0.01f; offset = -320.0f;
-                minValue = -320.0f; maxValue = 322.55f;
-            } else if (canID == 0x19FF1002) {  // Gyro_X/Y/Z
-                scale = 1.0f / 128.0f; offset = -250.0f;
-                minValue = -250.0f; maxValue = 250.99f;
+void CANCommunication::configureScheduleSignals() {
+    std::vector<IMUSignalStream> streams;
+    streams.reserve(messageSchedule.size());
+    for (size_t i = 0; i < messageSchedule.size(); ++i) {
+        const ScheduledMessage& message = messageSchedule.message(i);
+        streams.push_back({message.sensor, message.layout, sampleIntervalNs(message.layout, message.periodNs)});
+    }
+    // 고정 주기 송신의 센서 0과 다른 운동이 되도록 시드를 바꿈
+    scheduleSignals.configure(streams, signalSeedValue.load() + 1);
+}
+
+void CANCommunication::onSendTimer() {
+    // Skip 정책이면 1회, CatchUp 정책이면 놓친 주기만큼 연속 송신
+    uint64_t runs = sendScheduler.onTimerExpired(sendTimer);
+    for (uint64_t r = 0; r < runs && canSendEnabled; ++r) {
+        sendIMUCycle();
+    }
+}
+
+void CANCommunication::fillFrame(const can_codec::MessageDesc& msg, canid_t canID, IMUSignalSet& signalSet,
+                                 size_t stream, can_frame& frame) {
+    frame = {};
+    frame.can_id = canID;
+    frame.can_dlc = msg.sampleBytes();
+    encodeIMUSample(msg, signalSet, stream, frame.data);
+}
+
+void CANCommunication::fillFDFrame(const can_codec::MessageDesc& msg, canid_t canID, IMUSignalSet& signalSet,
+                                   size_t stream, canfd_frame& frame) {
+    // FD 프레임 하나에 N개의 샘플을 묶어서 송신
+    int sampleBytes = msg.sampleBytes();
+    int samples = std::min(fdSamplesPerFrame.load(), (CANFD_MAX_DLEN - 1) / sampleBytes);
+
+    frame = {};
+    frame.can_id = canID;
+    frame.flags = fdBitRateSwitch.load() ? CANFD_BRS : 0;
+    frame.data[0] = static_cast<uint8_t>(samples);
+    for (int s = 0; s < samples; ++s) {
+        encodeIMUSample(msg, signalSet, stream, &frame.data[1 + s * sampleBytes]);
+    }
+    frame.len = fdPayloadLength(1 + samples * sampleBytes);
+}
+
+void CANCommunication::sendIMUCycle() {
+    constexpr size_t messageCount = can_codec::kMessageCount;
+    uint64_t enabled = enabledMessages.load(std::memory_order_relaxed);
+    size_t count = 0;
+
+    if (fdMode.load()) {
+        for (size_t n = 0; n < messageCount; ++n) {
+            if (enabled & (1ull << n)) {
+                fillFDFrame(can_codec::kMessages[n], can_codec::kMessages[n].id, cycleSignals, n, txFDFrames[count++]);
             }
+        }
 
-            // 3개의 센서 값 생성
-            float values[3];
-            for (int i = 0; i < 3; i++) {
-                values[i] = generateRandomValue(minValue, maxValue);
+        sendFDFrames(txFDFrames.data(), count);
+    } else {
+        for (size_t n = 0; n < messageCount; ++n) {
+            if (enabled & (1ull << n)) {
+                fillFrame(can_codec::kMessages[n], can_codec::kMessages[n].id, cycleSignals, n, txFrames[count++]);
             }
+        }
+
+        // 한 주기의 프레임을 묶어서 송신 (Batched 모드에서는 sendmmsg 한 번)
+        sendFrames(txFrames.data(), count);
+    }
+    cycleSignals.prepare();  // 다음 송신에 쓸 값은 송신 뒤에 미리 생성
+}
+
+void CANCommunication::startSchedule() {
+    sendTimer.disarm();
+    messageSchedule.start(PeriodicScheduler::monotonicNs());
+    armScheduleTimer();
+}
+
+void CANCommunication::armScheduleTimer() {
+    int64_t deadlineNs = messageSchedule.nextDeadlineNs();
+    if (deadlineNs == INT64_MAX) {
+        scheduleTimer.disarm();  // 이벤트 메시지만 남음 (triggerMessage()에서 다시 설정)
+    } else {
+        scheduleTimer.setAbsolute(deadlineNs, 0);
+    }
+}
+
+void CANCommunication::onScheduleTimer() {
+    scheduleTimer.readExpirations();
+
+    // 송신이 꺼져 있어도 일정은 진행 (다시 켜면 원래 위상 그대로)
+    dueMessages.clear();
+    messageSchedule.advance(PeriodicScheduler::monotonicNs(), dueMessages);
+    if (!dueMessages.empty() && canSendEnabled) {
+        sendScheduledMessages();
+    }
+    armScheduleTimer();
+}
+
+void CANCommunication::sendScheduledMessages() {
+    size_t count = dueMessages.size();
+    if (fdMode.load()) {
+        for (size_t i = 0; i < count; ++i) {
+            const ScheduledMessage& message = messageSchedule.message(dueMessages[i]);
+            fillFDFrame(can_codec::kMessages[message.layout], message.id, scheduleSignals, dueMessages[i],
+                        scheduledFDFrames[i]);
+        }
+        sendFDFrames(scheduledFDFrames.data(), count);
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            const ScheduledMessage& message = messageSchedule.message(dueMessages[i]);
+            fillFrame(can_codec::kMessages[message.layout], message.id, scheduleSignals, dueMessages[i],
+                      scheduledFrames[i]);
+        }
+        sendFrames(scheduledFrames.data(), count);
+    }
+    scheduleSignals.prepare();
+}
 
-            // 변환 후 CAN 프레임에 저장
-            for (int i = 0; i < 3; i++) {
-                int16_t scaledData = static_cast<int16_t>((values[i] - offset) / scale);
-                frame.data[i * 2] = scaledData & 0xFF;
-                frame.data[i * 2 + 1] = (scaledData >> 8) & 0xFF;
+namespace {
+
+// 정렬된 ID 목록 -> 마스크 필터 (연속 구간을 정렬된 2의 거듭제곱 블록으로 덮음)
+// 부하 측정용 일정은 baseId부터 연속이므로 수천 개여도 필터 수십 개로 줄어든다.
+std::vector<struct can_filter> makeRangeFilters(const std::vector<canid_t>& ids) {
+    std::vector<struct can_filter> filters;
+    size_t i = 0;
+    while (i < ids.size()) {
+        // [first, last]: 같은 EFF 플래그의 연속 구간
+        uint32_t first = ids[i];
+        uint32_t last = first;
+        while (++i < ids.size() && ids[i] == last + 1) {
+            last = ids[i];
+        }
+        uint32_t flag = first & CAN_EFF_FLAG;
+        uint64_t low = first & CAN_EFF_MASK;
+        const uint64_t high = last & CAN_EFF_MASK;
+        while (low <= high) {
+            uint64_t size = low == 0 ? (uint64_t(CAN_EFF_MASK) + 1) : (low & (~low + 1));
+            while (low + size - 1 > high) {
+                size >>= 1;
             }
+            filters.push_back({static_cast<canid_t>(flag | low),
+                               static_cast<canid_t>(CAN_EFF_FLAG | CAN_RTR_FLAG | (CAN_EFF_MASK & ~(size - 1)))});
+            low += size;
+        }
+    }
+    return filters;
+}
+
+// 가장 작은 / 큰 ID의 공통 상위 비트만 비교하는 필터 하나 (필터 수 상한을 넘을 때)
+// 범위 안의 다른 ID도 통과하므로 그 프레임은 정의되지 않은 ID로 집계된다.
+struct can_filter makeSpanFilter(canid_t first, canid_t last) {
+    canid_t diff = (first ^ last) & CAN_EFF_MASK;
+    canid_t mask = CAN_EFF_MASK;
+    while (diff != 0) {
+        mask <<= 1;
+        diff >>= 1;
+    }
+    mask &= CAN_EFF_MASK;
+    return {first & (CAN_EFF_FLAG | mask), CAN_EFF_FLAG | CAN_RTR_FLAG | mask};
+}
+
+}  // namespace
 
-            sendData(frame);
+void CANCommunication::setMessageSchedule(const std::vector<ScheduledMessage>& messages, uint64_t seed) {
+    std::vector<ScheduledMessage> valid;
+    valid.reserve(messages.size());
+    for (const ScheduledMessage& message : messages) {
+        if (message.layout >= can_codec::kMessageCount) {
+            std::cerr << "[경고] 정의되지 않은 페이로드 형식 무시: 0x" << std::hex << (message.id & CAN_EFF_MASK)
+                      << std::dec << std::endl;
+            continue;
         }
+        valid.push_back(message);
+        valid.back().id = normalizeCANID(message.id);
+    }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(sendPeriodMs.load()));
+    // 일정 ID -> 형식 (같은 ID가 여러 번이면 처음 것), kMessages ID와 겹치면 kMessages 쪽이 우선
+    std::vector<std::pair<canid_t, uint8_t>> layouts;
+    layouts.reserve(valid.size());
+    for (const ScheduledMessage& message : valid) {
+        layouts.emplace_back(message.id, message.layout);
+    }
+    std::stable_sort(layouts.begin(), layouts.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    layouts.erase(std::unique(layouts.begin(), layouts.end(),
+                              [](const auto& a, const auto& b) { return a.first == b.first; }),
+                  layouts.end());
+
+    std::vector<canid_t> ids;
+    ids.reserve(layouts.size());
+    for (const auto& entry : layouts) {
+        ids.push_back(entry.first);
+    }
+    std::vector<struct can_filter> filters = makeRangeFilters(ids);
+    if (filters.size() + can_codec::kMessageCount > kMaxReceiveFilters) {
+        // 표준 / 확장 ID가 섞여 있으면 종류별로 하나씩
+        std::vector<struct can_filter> spans;
+        auto extended = std::partition_point(ids.begin(), ids.end(), [](canid_t id) { return !(id & CAN_EFF_FLAG); });
+        if (extended != ids.begin()) {
+            spans.push_back(makeSpanFilter(ids.front(), *(extended - 1)));
+        }
+        if (extended != ids.end()) {
+            spans.push_back(makeSpanFilter(*extended, ids.back()));
+        }
+        filters = std::move(spans);
+    }
+
+    auto apply = [this, &valid, &layouts, seed] {
+        messageSchedule.setMessages(valid, seed);
+        scheduledLayouts = std::move(layouts);
+        // 한 번에 모든 메시지가 만료되어도 할당하지 않도록
+        dueMessages.clear();
+        dueMessages.reserve(valid.size());
+        scheduledFrames.resize(valid.size());
+        scheduledFDFrames.resize(valid.size());
+        if (!connected || !scheduleTimer.isOpen()) {
+            return;  // attach()에서 적용
+        }
+        configureScheduleSignals();
+        if (messageSchedule.empty()) {
+            scheduleTimer.disarm();
+            sendScheduler.armTimer(sendTimer);
+        } else {
+            startSchedule();
+        }
+    };
+    if (reactor) {
+        reactor->runSync(apply);
+    } else {
+        apply();
+    }
+
+    // 일정 ID도 커널에서 통과시킴 (형식 조회표를 먼저 바꿨으므로 새 ID가 정의되지 않은 ID로 집계되지 않음)
+    std::lock_guard<std::mutex> lock(filterMutex);
+    scheduleFilters = std::move(filters);
+    if (socket_fd >= 0) {
+        applyReceiveFilter(socket_fd);
     }
 }
 
-void CANCommunication::run() {
-    struct sockaddr_can addr;
-    struct ifreq ifr;
+void CANCommunication::triggerMessage(size_t index) {
+    if (!connected || reactor == nullptr) {
+        return;
+    }
+    reactor->post([this, index] {
+        if (connected && index < messageSchedule.size()) {
+            messageSchedule.trigger(index, PeriodicScheduler::monotonicNs());
+            armScheduleTimer();
+        }
+    });
+}
+
+MessageScheduleStats CANCommunication::messageScheduleStats() const {
+    return messageSchedule.stats();
+}
+
+void CANCommunication::setSignalSeed(uint64_t seed) {
+    signalSeedValue.store(seed);
+    auto apply = [this] {
+        if (connected) {
+            configureCycleSignals();
+            configureScheduleSignals();
+        }
+    };
+    if (reactor) {
+        reactor->runSync(apply);
+    } else {
+        apply();
+    }
+}
+
+uint64_t CANCommunication::signalSeed() const {
+    return signalSeedValue.load();
+}
+
+IMUSignalStats CANCommunication::signalStats() const {
+    IMUSignalStats cycle = cycleSignals.stats();
+    IMUSignalStats schedule = scheduleSignals.stats();
+    return {cycle.streams + schedule.streams, cycle.samples + schedule.samples, cycle.blocks + schedule.blocks,
+            cycle.onDemandBlocks + schedule.onDemandBlocks, cycle.skippedSamples + schedule.skippedSamples};
+}
 
+bool CANCommunication::attach(EventReactor& eventReactor) {
+    int fd = -1;
     try {
-        initializeSocket(socket_fd, addr, ifr);
+        fd = initializeSocket();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
-        return;
+        return false;
+    }
+    {
+        // 설정된 메시지 ID만 커널에서 통과시켜 다른 트래픽이 반응기를 깨우지 않도록 함
+        // 필터 설치와 fd 공개를 한 번에 해야 그 사이에 들어온 필터 변경이 빠지지 않는다.
+        std::lock_guard<std::mutex> lock(filterMutex);
+        applyReceiveFilter(fd);
+        socket_fd = fd;
     }
 
-    std::thread sender(&CANCommunication::sendIMUData, this);
-    std::thread receiver(&CANCommunication::handleIncomingData, this);
-    std::thread statusUpdater(&CANCommunication::updateConnectionStatus, this);
+    // 수신: 소켓 읽기 가능 시 / 송신: 절대 데드라인 timerfd (고정 주기 또는 메시지 일정) / 상태: 1초 timerfd
+    if (!sendTimer.open() || !scheduleTimer.open() || !statusTimer.open()) {
+        std::cerr << "[오류] timerfd 생성 실패: " << strerror(errno) << std::endl;
+        sendTimer.close();
+        scheduleTimer.close();
+        statusTimer.close();
+        closeSocket();
+        return false;
+    }
+    configureCycleSignals();
+    configureScheduleSignals();
+    if (messageSchedule.empty()) {
+        sendScheduler.armTimer(sendTimer);
+    } else {
+        startSchedule();
+    }
+    statusTimer.setRelative(kStatusIntervalNs, kStatusIntervalNs);
 
-    sender.join();
-    receiver.join();
-    statusUpdater.join();
+    eventReactor.add(socket_fd, EPOLLIN, [this](uint32_t events) { handleIncomingData(events); });
+    eventReactor.add(sendTimer.nativeHandle(), EPOLLIN, [this](uint32_t) { onSendTimer(); });
+    eventReactor.add(scheduleTimer.nativeHandle(), EPOLLIN, [this](uint32_t) { onScheduleTimer(); });
+    eventReactor.add(statusTimer.nativeHandle(), EPOLLIN, [this](uint32_t) { updateConnectionStatus(); });
+    return true;
+}
 
-    close(socket_fd);
-    socket_fd = -1;
+void CANCommunication::detach() {
+    reactor->remove(socket_fd);
+    reactor->remove(sendTimer.nativeHandle());
+    reactor->remove(scheduleTimer.nativeHandle());
+    reactor->remove(statusTimer.nativeHandle());
+    sendTimer.close();
+    scheduleTimer.close();
+    statusTimer.close();
+    closeSocket();
 }
 
-void CANCommunication::handleIncomingData() {
-    struct can_frame frame;
-    struct pollfd pfd;
+void CANCommunication::onTransitionFinished(const ChannelTransition& result) {
+    emit transitionFinished(result.connected, result.elapsedNs);
+}
 
-    pfd.fd = socket_fd;
-    pfd.events = POLLIN;  // 읽기 가능 이벤트 감지
+void CANCommunication::handleIncomingData(uint32_t events) {
+    if (events & EPOLLERR) {
+        int error = 0;
+        socklen_t length = sizeof(error);
+        getsockopt(socket_fd, SOL_SOCKET, SO_ERROR, &error, &length);
+        AsyncLogger::instance().log(LogLevel::Error, LogChannel::CAN, LogEvent::ReceiveFailed, 0,
+                                    nullptr, 0, error);
+        receiveFailures.add();
+    }
+
+    // 읽기 가능할 때만 호출되므로 블로킹 없이 읽음
+    if (ioMode.load() == CANIOMode::Batched) {
+        receiveFrameBatch();
+    } else {
+        receiveSingleFrame();
+    }
+}
+
+void CANCommunication::receiveSingleFrame() {
+    struct canfd_frame frame;
+    struct iovec iov = {&frame, sizeof(struct canfd_frame)};
+    alignas(struct cmsghdr) char control[kControlBufferSize];
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t nbytes = recvmsg(socket_fd, &msg, MSG_DONTWAIT);
+
+    if (nbytes == CAN_MTU || nbytes == CANFD_MTU) {
+        int64_t rxTimestamp = kernelTimestampNs(msg);
+        processReceivedData(frame, nbytes == CANFD_MTU, rxTimestamp ? rxTimestamp : realtimeNs(),
+                            (msg.msg_flags & MSG_CONFIRM) != 0);
+    } else if (nbytes >= 0) {
+        AsyncLogger::instance().log(LogLevel::Warning, LogChannel::CAN, LogEvent::InvalidFrame, 0,
+                                    nullptr, 0, static_cast<int32_t>(nbytes));
+        invalidFrames.add();
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        AsyncLogger::instance().log(LogLevel::Error, LogChannel::CAN, LogEvent::ReceiveFailed, 0,
+                                    nullptr, 0, errno);
+        receiveFailures.add();
+    }
+}
 
-    // std::cout << "[디버깅] 수신 스레드 시작됨" << std::endl;
+void CANCommunication::prepareReceiveBuffers(size_t count) {
+    rxFrames.resize(count);
+    rxPending.reserve(count);
+    rxIov.resize(count);
+    rxMsgs.resize(count);
+    rxControl.resize(count);
 
+    for (size_t i = 0; i < count; ++i) {
+        rxIov[i].iov_base = &rxFrames[i];
+        rxIov[i].iov_len = sizeof(struct canfd_frame);
+        rxMsgs[i] = {};
+        rxMsgs[i].msg_hdr.msg_iov = &rxIov[i];
+        rxMsgs[i].msg_hdr.msg_iovlen = 1;
+        rxMsgs[i].msg_hdr.msg_control = rxControl[i].data();
+    }
+}
+
+void CANCommunication::receiveFrameBatch() {
+    size_t count = static_cast<size_t>(batchSize.load());
+    if (rxMsgs.size() != count) {
+        prepareReceiveBuffers(count);
+    }
+
+    // 소켓에 쌓인 프레임을 모두 비울 때까지 반복 (블로킹 없이)
     while (connected) {
-        if (socket_fd < 0) {
-            std::cerr << "[오류] 수신 소켓이 유효하지 않음" << std::endl;
-            break;
+        // 커널이 msg_controllen을 실제 사용 길이로 덮어쓰므로 매번 복원
+        for (size_t i = 0; i < count; ++i) {
+            rxMsgs[i].msg_hdr.msg_controllen = kControlBufferSize;
         }
 
-        // std::cout << "[디버깅] CAN 데이터 수신 대기 중..." << std::endl;
+        int received = recvmmsg(socket_fd, rxMsgs.data(), count, MSG_DONTWAIT, nullptr);
+        if (received < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                AsyncLogger::instance().log(LogLevel::Error, LogChannel::CAN, LogEvent::ReceiveFailed, 0,
+                                            nullptr, 0, errno);
+                receiveFailures.add();
+            }
+            return;
+        }
 
-        // poll()을 사용하여 데이터가 도착했는지 확인 (타임아웃 500ms)
-        int ret = poll(&pfd, 1, 500);
-        if (ret < 0) {
-            std::cerr << "[오류] poll() 실패: " << strerror(errno)
-                << " (errno=" << errno << ")" << std::endl;
-            break;
-        } else if (ret == 0) {
-            // std::cout << "[디버깅] poll() 타임아웃: 데이터 없음" << std::endl;
-            continue;  // 데이터가 없으면 다시 대기
+        rxDecoder.reset(reinterpret_cast<const uint8_t*>(rxFrames.data()));
+        rxPending.clear();
+        int64_t fallbackTimestamp = 0;
+        for (int i = 0; i < received; ++i) {
+            unsigned int len = rxMsgs[i].msg_len;
+            if (len == CAN_MTU || len == CANFD_MTU) {
+                int64_t rxTimestamp = kernelTimestampNs(rxMsgs[i].msg_hdr);
+                if (rxTimestamp == 0) {
+                    if (fallbackTimestamp == 0) {
+                        fallbackTimestamp = realtimeNs();
+                    }
+                    rxTimestamp = fallbackTimestamp;
+                }
+                bool fd = len == CANFD_MTU;
+                const uint8_t* samples = nullptr;
+                int sampleCount = 0;
+                int index = acceptReceivedFrame(rxFrames[i], fd, rxTimestamp,
+                                                (rxMsgs[i].msg_hdr.msg_flags & MSG_CONFIRM) != 0, samples, sampleCount);
+                if (index >= 0) {
+                    uint32_t first = rxDecoder.add(index, samples, sampleCount);
+                    rxPending.push_back({rxTimestamp, static_cast<uint32_t>(i), first, static_cast<uint8_t>(index),
+                                         static_cast<uint8_t>(sampleCount), fd});
+                }
+            }
+        }
+        publishDecodedBatch();
+
+        if (static_cast<size_t>(received) < count) {
+            return;  // 더 이상 대기 중인 프레임 없음
         }
+    }
+}
 
-        // 데이터가 있을 때만 read() 실행
-        ssize_t nbytes = read(socket_fd, &frame, sizeof(struct can_frame));
+int CANCommunication::acceptReceivedFrame(const canfd_frame& frame, bool fd, int64_t rxTimestampNs, bool ownMessage,
+                                          const uint8_t*& samples, int& sampleCount) {
+    // 기록은 필터 / 검증 전의 원본 프레임 (재생 시 같은 입력을 재현)
+    if (recorderTap) {
+        recorderTap->recordCAN(frame, fd, rxTimestampNs);
+    }
 
-        if (nbytes > 0 && nbytes == sizeof(struct can_frame)) {
-            // std::cout << "[디버깅] CAN 데이터 수신됨: ID=0x"
-            //           << std::hex << frame.can_id << std::dec
-            //           << ", 길이=" << (int)frame.can_dlc << std::endl;
+    // CAN_RAW_ERR_FILTER로 허용한 에러 프레임
+    if (frame.can_id & CAN_ERR_FLAG) {
+        AsyncLogger::instance().log(LogLevel::Warning, LogChannel::CAN, LogEvent::ErrorFrame,
+                                    frame.can_id & CAN_ERR_MASK);
+        errorFrames.add();
+        return -1;
+    }
+    idStatsTable.record(frame.can_id, frame.data, frame.len, fd, rxTimestampNs);
 
-            processReceivedData(frame);
-        } else if (nbytes == 0) {
-            std::cerr << "[경고] read() 반환 값이 0 (EOF?)" << std::endl;
-        } else {
-            std::cerr << "[오류] read() 실패: " << strerror(errno)
-                << " (errno=" << errno << ")" << std::endl;
+    // 불변 테이블 조회이므로 락이 필요 없음
+    int index = can_codec::messageIndex(frame.can_id);
+    if (index >= 0 && !(enabledMessages.load(std::memory_order_relaxed) & (1ull << index))) {
+        return -1;  // 필터 재설치 직전에 이미 큐에 들어와 있던 프레임
+    }
+    if (index < 0) {
+        index = layoutIndex(frame.can_id);  // 메시지 일정 ID는 페이로드 형식으로 집계
+    }
+    if (index < 0) {
+        // 모든 ID 수신 모드가 아니면 커널 필터가 걸러내므로 정상 동작에서는 도달하지 않음
+        if (!receiveAllIDs.load(std::memory_order_relaxed)) {
+            AsyncLogger::instance().log(LogLevel::Warning, LogChannel::CAN, LogEvent::UnknownID, frame.can_id);
         }
+        unknownIDs.add();
+        return -1;
     }
+    const can_codec::MessageDesc* msg = &can_codec::kMessages[index];
 
-    // std::cout << "[디버깅] 수신 스레드 종료됨" << std::endl;
+    // 커널 수신 타임스탬프 기준 지연 / 수신 간격 기록
+    lastReceiveNs.store(rxTimestampNs, std::memory_order_relaxed);
+    if (ownMessage) {
+        int64_t txTimestampNs = matchTransmitTime(index, frame);
+        if (txTimestampNs > 0 && rxTimestampNs >= txTimestampNs) {
+            latencyHistograms[index].record(static_cast<uint64_t>(rxTimestampNs - txTimestampNs));
+        }
+    }
+    if (lastRxNs[index] > 0 && rxTimestampNs >= lastRxNs[index]) {
+        interArrivalHistograms[index].record(static_cast<uint64_t>(rxTimestampNs - lastRxNs[index]));
+    }
+    lastRxNs[index] = rxTimestampNs;
+
+    // Classic 프레임은 샘플 1개, FD 프레임은 첫 바이트가 샘플 수
+    const int sampleBytes = msg->sampleBytes();
+    samples = frame.data;
+    sampleCount = 1;
+    if (fd) {
+        sampleCount = frame.data[0];
+        samples = frame.data + 1;
+        if (sampleCount < 1 || 1 + sampleCount * sampleBytes > frame.len) {
+            AsyncLogger::instance().log(LogLevel::Warning, LogChannel::CANFD, LogEvent::InvalidFrame,
+                                        frame.can_id, nullptr, 0, frame.len);
+            invalidFrames.add();
+            return -1;
+        }
+    } else if (frame.len < sampleBytes) {
+        AsyncLogger::instance().log(LogLevel::Warning, LogChannel::CAN, LogEvent::InvalidFrame,
+                                    frame.can_id, nullptr, 0, frame.len);
+        invalidFrames.add();
+        return -1;
+    }
+
+    framesReceived[index].add();
+    samplesReceived.add(sampleCount);
+    return index;
 }
 
-void CANCommunication::processReceivedData(const can_frame& frame) {
-    std::lock_guard<std::mutex> lock(dataMutex);
+void CANCommunication::publishSample(CommRecord& record, const uint8_t* sample, int sampleBytes) {
+    // 데이터 유형과 함께 값 출력 (포맷팅은 로거 백그라운드 스레드에서)
+    AsyncLogger::instance().log(LogLevel::Info,
+                                record.channel == RecordChannel::CANFD ? LogChannel::CANFD : LogChannel::CAN,
+                                LogEvent::FrameReceived, record.id, sample, sampleBytes, record.sampleIndex);
 
-    auto it = idDataRanges.find(frame.can_id);
-    if (it == idDataRanges.end()) {
-        std::cerr << "[경고] 알 수 없는 CAN ID: 0x" << std::hex << frame.can_id << std::endl;
-        return;
-    }
+    // UI 링에 넣기만 하고 포맷팅은 UI 스레드에서 (가득 차면 버림)
+    uiRing.tryPush(record);
+}
 
-    float scale, offset;
-    std::string dataType;
+CommRecord CANCommunication::makeRecord(const canfd_frame& frame, bool fd, int64_t rxTimestampNs, int sampleIndex,
+                                        int sampleCount) const {
+    CommRecord record;
+    record.timestampNs = rxTimestampNs;
+    record.id = frame.can_id;
+    record.channel = fd ? RecordChannel::CANFD : RecordChannel::CAN;
+    record.length = 0;
+    record.sampleIndex = static_cast<uint8_t>(sampleIndex);
+    record.sampleCount = static_cast<uint8_t>(sampleCount);
+    record.bus = busIndex;
+    return record;
+}
 
-    if (frame.can_id == 0x19FF1000) {  // Roll/Pitch/Yaw
-        scale = 0.002f; offset = -64.0f;
-        dataType = "[자세] Roll/Pitch/Yaw";
-    } else if (frame.can_id == 0x19FF1001) {  // Accel_X/Y/Z
-        scale = 0.01f; offset = -320.0f;
-        dataType = "[가속도] Accel_X/Y/Z";
-    } else if (frame.can_id == 0x19FF1002) {  // Gyro_X/Y/Z
-        scale = 1.0f / 128.0f; offset = -250.0f;
-        dataType = "[각속도] Gyro_X/Y/Z";
-    } else {
+void CANCommunication::processReceivedData(const canfd_frame& frame, bool fd, int64_t rxTimestampNs, bool ownMessage) {
+    const uint8_t* samples = nullptr;
+    int sampleCount = 0;
+    int index = acceptReceivedFrame(frame, fd, rxTimestampNs, ownMessage, samples, sampleCount);
+    if (index < 0) {
         return;
     }
+    const can_codec::MessageDesc& msg = can_codec::kMessages[index];
+    const int sampleBytes = msg.sampleBytes();
+    for (int s = 0; s < sampleCount; ++s) {
+        CommRecord record = makeRecord(frame, fd, rxTimestampNs, s, sampleCount);
+        can_codec::decode(msg, samples + s * sampleBytes, record.values);
+        publishSample(record, samples + s * sampleBytes, sampleBytes);
+    }
+}
 
-    float values[3];
-    for (int i = 0; i < 3; i++) {
-        int16_t rawData = frame.data[i * 2] | (frame.data[i * 2 + 1] << 8);
-        values[i] = (rawData * scale) + offset;
+void CANCommunication::publishDecodedBatch() {
+    // 메시지별로 모은 샘플을 한 번에 디코딩한 뒤 수신 순서대로 내보냄
+    rxDecoder.decode();
+    for (const PendingFrame& pending : rxPending) {
+        const canfd_frame& frame = rxFrames[pending.frame];
+        const can_codec::MessageDesc& msg = can_codec::kMessages[pending.index];
+        const DecodedColumns& columns = rxDecoder.columns(pending.index);
+        const int sampleBytes = msg.sampleBytes();
+        const uint8_t* samples = pending.fd ? frame.data + 1 : frame.data;
+        for (int s = 0; s < pending.sampleCount; ++s) {
+            CommRecord record = makeRecord(frame, pending.fd, pending.timestampNs, s, pending.sampleCount);
+            for (int f = 0; f < can_codec::kMaxFields; ++f) {
+                record.values[f] = f < msg.fieldCount ? columns.values[f][pending.first + s] : 0.0f;
+            }
+            publishSample(record, samples + s * sampleBytes, sampleBytes);
+        }
     }
+}
 
-    // 수신 시간 기록 (통신 상태 업데이트용)
-    lastReceiveTime = std::chrono::steady_clock::now();
+size_t CANCommunication::drainRecords(CommRecord* out, size_t maxRecords) {
+    return uiRing.popBatch(out, maxRecords);
+}
 
-    // 데이터 유형과 함께 값 출력
-    std::cout << "[CAN 수신] " << dataType << " | "
-              << "값1=" << values[0] << ", "
-              << "값2=" << values[1] << ", "
-              << "값3=" << values[2] << std::endl;
+uint64_t CANCommunication::droppedRecords() const {
+    return uiRing.dropped();
+}
 
-    QString data = QString("[CAN 수신] %1 | 값1=%2, 값2=%3, 값3=%4")
-        .arg(QString::fromStdString(dataType))
-        .arg(values[0])
-        .arg(values[1])
-        .arg(values[2]);
+QString CANCommunication::formatRecord(const CommRecord& record) {
+    const can_codec::MessageDesc* msg = can_codec::findMessage(record.id);
+    QString prefix = (record.channel == RecordChannel::CANFD)
+        ? QString("[CAN FD 수신] (%1/%2)").arg(record.sampleIndex + 1).arg(record.sampleCount)
+        : QString("[CAN 수신]");
 
-    emit dataReceived(data);
+    return QString("%1 %2 | 값1=%3, 값2=%4, 값3=%5")
+        .arg(prefix)
+        .arg(msg ? msg->name : "알 수 없는 ID")
+        .arg(record.values[0])
+        .arg(record.values[1])
+        .arg(record.values[2]);
 }
 
 void CANCommunication::sendData(const can_frame& frame) {
@@ -236,47 +794,503 @@ void CANCommunication::sendData(const can_frame& frame) {
         return;
     }
 
-    ssize_t nbytes = write(socket_fd, &frame, sizeof(struct can_frame));
+    // 수신 확인이 send() 반환보다 먼저 반응기 스레드에 도착할 수 있으므로 송신 전에 기록하고 실패 시 취소
+    int64_t txNs = realtimeNs();
+    recordTransmitTimes(&frame, 1, txNs);
+    ssize_t nbytes = send(socket_fd, &frame, sizeof(struct can_frame), MSG_DONTWAIT);
     if (nbytes != sizeof(struct can_frame)) {
-        std::cerr << "[오류] 데이터 전송 실패" << std::endl;
+        cancelTransmitTimes(&frame, 1, txNs);
+        AsyncLogger::instance().log(LogLevel::Error, LogChannel::CAN, LogEvent::SendFailed, frame.can_id,
+                                    nullptr, 0, errno);
+        writeFailures.add();
     } else {
-        std::cout << "[CAN 송신] CAN ID: 0x" << std::hex << frame.can_id << " 데이터 길이: " << std::dec << (int)frame.can_dlc << " 데이터: ";
-        for (int i = 0; i < frame.can_dlc; ++i) {
-            std::cout << "0x" << std::hex << (int)frame.data[i] << " ";
+        countSentFrame(frame.can_id, 1, frame.can_dlc);
+        logSentFrame(frame.can_id, frame.data, frame.can_dlc, false);
+    }
+}
+
+void CANCommunication::sendFDData(const canfd_frame& frame) {
+    if (socket_fd < 0) {
+        std::cerr << "[오류] 소켓이 초기화되지 않음" << std::endl;
+        return;
+    }
+    if (!fdFramesEnabled) {
+        std::cerr << "[오류] CAN FD 프레임이 비활성화된 소켓" << std::endl;
+        return;
+    }
+
+    int64_t txNs = realtimeNs();
+    recordTransmitTimes(&frame, 1, txNs);
+    ssize_t nbytes = send(socket_fd, &frame, sizeof(struct canfd_frame), MSG_DONTWAIT);
+    if (nbytes != sizeof(struct canfd_frame)) {
+        cancelTransmitTimes(&frame, 1, txNs);
+        AsyncLogger::instance().log(LogLevel::Error, LogChannel::CANFD, LogEvent::SendFailed, frame.can_id,
+                                    nullptr, 0, errno);
+        writeFailures.add();
+    } else {
+        countSentFrame(frame.can_id, frame.data[0], frame.len);
+        logSentFrame(frame.can_id, frame.data, frame.len, true);
+    }
+}
+
+void CANCommunication::sendFrames(const can_frame* frames, size_t count) {
+    if (ioMode.load() == CANIOMode::Batched) {
+        sendFrameBatch(frames, count);
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        sendData(frames[i]);
+    }
+}
+
+void CANCommunication::sendFDFrames(const canfd_frame* frames, size_t count) {
+    if (ioMode.load() == CANIOMode::Batched) {
+        if (!fdFramesEnabled) {
+            std::cerr << "[오류] CAN FD 프레임이 비활성화된 소켓" << std::endl;
+            return;
         }
-        std::cout << std::endl;
+        sendFrameBatch(frames, count);
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        sendFDData(frames[i]);
     }
 }
 
-void CANCommunication::updateConnectionStatus() {
-    while (connected) {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastReceiveTime).count();
+namespace {
 
-        if (elapsed < 500) {
-            connectionStatus = 2;  // 양호
-        } else if (elapsed < sendPeriodMs) {
-            connectionStatus = 1;  // 미흡
-        } else {
-            connectionStatus = 0;  // 끊김
+// 프레임 타입별 부가 정보 (길이, 샘플 수, FD 여부)
+uint8_t frameLength(const can_frame& frame) { return frame.can_dlc; }
+uint8_t frameLength(const canfd_frame& frame) { return frame.len; }
+uint8_t frameSamples(const can_frame&) { return 1; }
+uint8_t frameSamples(const canfd_frame& frame) { return frame.data[0]; }
+constexpr bool isFDFrame(const can_frame&) { return false; }
+constexpr bool isFDFrame(const canfd_frame&) { return true; }
+
+// 송신 프레임과 수신 확인을 짝짓는 페이로드 해시 (FNV-1a)
+uint32_t payloadTag(const uint8_t* data, int length) {
+    uint32_t hash = 2166136261u ^ static_cast<uint32_t>(length);
+    for (int i = 0; i < length; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+}  // namespace
+
+template <typename Frame>
+void CANCommunication::recordTransmitTimes(const Frame* frames, size_t count, int64_t txNs) {
+    std::lock_guard<std::mutex> lock(txStampMutex);
+    for (size_t i = 0; i < count; ++i) {
+        int index = layoutIndex(frames[i].can_id);
+        if (index < 0) {
+            continue;
+        }
+        TxStampQueue& queue = txStamps[index];
+        if (queue.tail - queue.head == kTxStampCapacity) {
+            ++queue.head;
         }
+        queue.entries[queue.tail++ & (kTxStampCapacity - 1)] =
+            {txNs, frames[i].can_id, payloadTag(frames[i].data, frameLength(frames[i]))};
+    }
+}
+
+template <typename Frame>
+void CANCommunication::cancelTransmitTimes(const Frame* frames, size_t count, int64_t txNs) {
+    std::lock_guard<std::mutex> lock(txStampMutex);
+    for (size_t i = 0; i < count; ++i) {
+        int index = layoutIndex(frames[i].can_id);
+        if (index < 0) {
+            continue;
+        }
+        // 방금 기록한 항목이므로 꼬리부터 찾아 무효화 (ns = 0)
+        TxStampQueue& queue = txStamps[index];
+        const uint32_t tag = payloadTag(frames[i].data, frameLength(frames[i]));
+        for (uint64_t j = queue.tail; j != queue.head; --j) {
+            TxStamp& stamp = queue.entries[(j - 1) & (kTxStampCapacity - 1)];
+            if (stamp.ns == txNs && stamp.id == frames[i].can_id && stamp.tag == tag) {
+                stamp.ns = 0;
+                break;
+            }
+        }
+    }
+}
+
+int64_t CANCommunication::matchTransmitTime(int index, const canfd_frame& frame) {
+    const uint32_t tag = payloadTag(frame.data, frame.len);
+    std::lock_guard<std::mutex> lock(txStampMutex);
+    TxStampQueue& queue = txStamps[index];
+    for (uint64_t i = queue.head; i != queue.tail; ++i) {
+        const TxStamp& stamp = queue.entries[i & (kTxStampCapacity - 1)];
+        if (stamp.ns != 0 && stamp.id == frame.can_id && stamp.tag == tag) {
+            queue.head = i + 1;
+            return stamp.ns;
+        }
+    }
+    return 0;
+}
+
+void CANCommunication::replayFrames(std::vector<can_frame> frames) {
+    // 재생 스레드 -> 반응기 스레드 (detach()가 소켓을 닫는 스레드에서만 송신)
+    if (!connected || reactor == nullptr) {
+        return;
+    }
+    reactor->post([this, frames = std::move(frames)] {
+        if (connected) {
+            sendFrames(frames.data(), frames.size());
+        }
+    });
+}
+
+void CANCommunication::replayFDFrames(std::vector<canfd_frame> frames) {
+    if (!connected || reactor == nullptr) {
+        return;
+    }
+    reactor->post([this, frames = std::move(frames)] {
+        if (connected) {
+            sendFDFrames(frames.data(), frames.size());
+        }
+    });
+}
+
+template <typename Frame>
+void CANCommunication::sendFrameBatch(const Frame* frames, size_t count) {
+    if (socket_fd < 0) {
+        std::cerr << "[오류] 소켓이 초기화되지 않음" << std::endl;
+        return;
+    }
+
+    size_t chunk = static_cast<size_t>(batchSize.load());
+    struct iovec iov[kMaxBatchSize];
+    struct mmsghdr msgs[kMaxBatchSize];
+
+    // 배치 크기 단위로 나누어 sendmmsg() 호출
+    size_t sent = 0;
+    while (sent < count) {
+        size_t n = std::min(chunk, count - sent);
+        for (size_t i = 0; i < n; ++i) {
+            iov[i].iov_base = const_cast<Frame*>(&frames[sent + i]);
+            iov[i].iov_len = sizeof(Frame);
+            msgs[i] = {};
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int64_t txNs = realtimeNs();
+        recordTransmitTimes(frames + sent, n, txNs);
+        // 반응기 스레드를 막지 않도록 송신 큐가 가득 차면(ENOBUFS / EAGAIN) 실패로 기록
+        int ret = sendmmsg(socket_fd, msgs, n, MSG_DONTWAIT);
+        if (ret < static_cast<int>(n)) {
+            size_t accepted = static_cast<size_t>(std::max(ret, 0));
+            cancelTransmitTimes(frames + sent + accepted, n - accepted, txNs);
+        }
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            AsyncLogger::instance().log(LogLevel::Error, isFDFrame(frames[sent]) ? LogChannel::CANFD : LogChannel::CAN,
+                                        LogEvent::SendFailed, frames[sent].can_id, nullptr, 0, errno);
+            writeFailures.add(count - sent);  // 이번 호출에서 보내지 못한 나머지
+            return;
+        }
+
+        for (int i = 0; i < ret; ++i) {
+            const Frame& frame = frames[sent + i];
+            countSentFrame(frame.can_id, frameSamples(frame), frameLength(frame));
+            logSentFrame(frame.can_id, frame.data, frameLength(frame), isFDFrame(frame));
+        }
+
+        if (ret == 0) {
+            AsyncLogger::instance().log(LogLevel::Error, LogChannel::CAN, LogEvent::SendFailed, frames[sent].can_id,
+                                        nullptr, 0, EAGAIN);
+            writeFailures.add(count - sent);
+            return;
+        }
+        sent += static_cast<size_t>(ret);  // 일부만 전송된 경우 나머지를 이어서 전송
+    }
+}
 
-        // 상태를 QString으로 변환
-        QString statusText = (connectionStatus == 2) ? "양호" : (connectionStatus == 1) ? "미흡" : "끊김";
+int CANCommunication::layoutIndex(canid_t canID) const {
+    int index = can_codec::messageIndex(canID);
+    // 일정 조회표는 반응기 스레드 전용 (다른 스레드의 sendData()는 kMessages ID만 구분)
+    if (index >= 0 || (reactor != nullptr && !reactor->isLoopThread())) {
+        return index;
+    }
+    auto it = std::lower_bound(scheduledLayouts.begin(), scheduledLayouts.end(), canID,
+                               [](const std::pair<canid_t, uint8_t>& entry, canid_t id) { return entry.first < id; });
+    return (it != scheduledLayouts.end() && it->first == canID) ? it->second : -1;
+}
 
-        // UI 스레드에서 QLabel을 업데이트 하려면 signal/slot 메커니즘을 이용해야 함
-        emit connectionStatusChanged(statusText); // connectionStatusChanged 시그널을 통해 UI를 업데이트
+void CANCommunication::countSentFrame(canid_t canID, int samples, int length) {
+    int index = layoutIndex(canID);
+    framesSent[index >= 0 ? index : can_codec::kMessageCount].add();
+    samplesSent.add(samples);
+    payloadBytesSent.add(length);
+}
 
-        // 1초마다 상태를 갱신
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+void CANCommunication::logSentFrame(canid_t canID, const uint8_t* data, int length, bool fd) {
+    AsyncLogger::instance().log(LogLevel::Info, fd ? LogChannel::CANFD : LogChannel::CAN, LogEvent::FrameSent,
+                                canID, data, length);
+}
 
+void CANCommunication::updateConnectionStatus() {
+    if (statusTimer.readExpirations() == 0) {
+        return;
+    }
+
+    auto elapsed = (realtimeNs() - lastReceiveNs.load(std::memory_order_relaxed)) / 1000000;
+
+    if (elapsed < 500) {
+        connectionStatus = 2;  // 양호
+    } else if (elapsed < sendScheduler.period() / 1000000) {
+        connectionStatus = 1;  // 미흡
+    } else {
+        connectionStatus = 0;  // 끊김
     }
+
+    // 상태를 QString으로 변환
+    QString statusText = (connectionStatus == 2) ? "양호" : (connectionStatus == 1) ? "미흡" : "끊김";
+
+    // UI 스레드에서 QLabel을 업데이트 하려면 signal/slot 메커니즘을 이용해야 함
+    emit connectionStatusChanged(statusText); // connectionStatusChanged 시그널을 통해 UI를 업데이트
 }
 
 void CANCommunication::enableCANSend(bool enable) {
     canSendEnabled.store(enable);
 }
 
-void CANCommunication::setSendPeriod(int periodMs) {
-    sendPeriodMs.store(periodMs);
+void CANCommunication::setSendPeriodUs(int64_t periodUs) {
+    sendScheduler.setPeriod(periodUs * 1000);
+}
+
+void CANCommunication::setOverrunPolicy(OverrunPolicy policy) {
+    sendScheduler.setPolicy(policy);
+}
+
+SchedulerStats CANCommunication::sendSchedulerStats() const {
+    return sendScheduler.stats();
+}
+
+void CANCommunication::resetSendSchedulerStats() {
+    sendScheduler.resetStats();
+}
+
+void CANCommunication::setIOMode(CANIOMode mode) {
+    ioMode.store(mode);
+}
+
+void CANCommunication::setBatchSize(int frames) {
+    batchSize.store(std::clamp(frames, 1, kMaxBatchSize));
+}
+
+
+void CANCommunication::setFDMode(bool enable) {
+    fdMode.store(enable);
+}
+
+void CANCommunication::setFDSamplesPerFrame(int samples) {
+    fdSamplesPerFrame.store(std::clamp(samples, 1, kMaxFDSamplesPerFrame));
+}
+
+void CANCommunication::setFDBitRateSwitch(bool enable) {
+    fdBitRateSwitch.store(enable);
+}
+
+CANTrafficStats CANCommunication::trafficStats() const {
+    CANTrafficStats stats = {};
+    for (const MetricCounter& counter : framesSent) {
+        stats.framesSent += counter.load();
+    }
+    for (const MetricCounter& counter : framesReceived) {
+        stats.framesReceived += counter.load();
+    }
+    stats.samplesSent = samplesSent.load();
+    stats.payloadBytesSent = payloadBytesSent.load();
+    stats.samplesReceived = samplesReceived.load();
+    stats.writeFailures = writeFailures.load();
+    stats.unknownIDs = unknownIDs.load();
+    stats.invalidFrames = invalidFrames.load();
+    return stats;
+}
+
+void CANCommunication::collectMetrics(MetricsWriter& writer) const {
+    std::string labels;
+    MetricsWriter::label(labels, "interface", interfaceName);
+    MetricsWriter::label(labels, "bus", std::to_string(busIndex));
+
+    for (size_t i = 0; i <= can_codec::kMessageCount; ++i) {
+        std::string idLabels = labels;
+        if (i == can_codec::kMessageCount) {
+            MetricsWriter::label(idLabels, "id", "other");
+            writer.sample("vsensor_can_frames_sent_total", MetricType::Counter, "CAN 송신 프레임 수", idLabels,
+                          framesSent[i].load());
+            break;
+        }
+        char id[16];
+        snprintf(id, sizeof(id), "0x%X", can_codec::kMessages[i].id & CAN_EFF_MASK);
+        MetricsWriter::label(idLabels, "id", id);
+        MetricsWriter::label(idLabels, "message", can_codec::kMessages[i].name);
+        writer.sample("vsensor_can_frames_sent_total", MetricType::Counter, "CAN 송신 프레임 수", idLabels,
+                      framesSent[i].load());
+        writer.sample("vsensor_can_frames_received_total", MetricType::Counter, "CAN 수신 프레임 수", idLabels,
+                      framesReceived[i].load());
+    }
+
+    writer.sample("vsensor_can_samples_sent_total", MetricType::Counter, "송신 IMU 샘플 수", labels,
+                  samplesSent.load());
+    writer.sample("vsensor_can_samples_received_total", MetricType::Counter, "수신 IMU 샘플 수", labels,
+                  samplesReceived.load());
+    writer.sample("vsensor_can_payload_bytes_sent_total", MetricType::Counter, "송신 페이로드 바이트", labels,
+                  payloadBytesSent.load());
+    writer.sample("vsensor_can_write_failures_total", MetricType::Counter, "송신하지 못한 프레임 수", labels,
+                  writeFailures.load());
+    writer.sample("vsensor_can_receive_failures_total", MetricType::Counter, "수신 시스템 호출 오류 수", labels,
+                  receiveFailures.load());
+    writer.sample("vsensor_can_unknown_ids_total", MetricType::Counter, "정의되지 않은 ID 수신 수", labels,
+                  unknownIDs.load());
+    writer.sample("vsensor_can_invalid_frames_total", MetricType::Counter, "길이가 맞지 않는 수신 프레임 수", labels,
+                  invalidFrames.load());
+    writer.sample("vsensor_can_error_frames_total", MetricType::Counter, "수신 에러 프레임 수", labels,
+                  errorFrames.load());
+
+    SchedulerStats scheduler = sendScheduler.stats();
+    writer.sample("vsensor_can_send_overruns_total", MetricType::Counter, "송신 작업이 다음 주기를 넘긴 횟수", labels,
+                  scheduler.overruns);
+    writer.sample("vsensor_can_send_skipped_periods_total", MetricType::Counter, "건너뛴 송신 주기 수", labels,
+                  scheduler.skippedPeriods);
+    MessageScheduleStats schedule = messageSchedule.stats();
+    if (schedule.messages > 0) {
+        writer.sample("vsensor_can_schedule_messages", MetricType::Gauge, "메시지 일정에 등록된 메시지 수", labels,
+                      schedule.messages);
+        writer.sample("vsensor_can_schedule_fired_total", MetricType::Counter, "메시지 일정에서 만료되어 송신한 메시지 수",
+                      labels, schedule.fired);
+        writer.sample("vsensor_can_schedule_skipped_periods_total", MetricType::Counter,
+                      "메시지 일정이 늦어 건너뛴 주기 수", labels, schedule.skippedPeriods);
+    }
+    IMUSignalStats signal = signalStats();
+    writer.sample("vsensor_can_signal_blocks_total", MetricType::Counter, "송신 값 블록 생성 횟수", labels,
+                  signal.blocks);
+    writer.sample("vsensor_can_signal_on_demand_blocks_total", MetricType::Counter,
+                  "미리 생성해 둔 값이 없어 송신 중에 생성한 블록 수", labels, signal.onDemandBlocks);
+    writer.sample("vsensor_can_ui_queue_depth", MetricType::Gauge, "UI 수신 링에 쌓인 레코드 수", labels,
+                  uiRing.size());
+    writer.sample("vsensor_can_ui_queue_dropped_total", MetricType::Counter, "UI 수신 링이 가득 차서 버린 레코드 수",
+                  labels, uiRing.dropped());
+    std::vector<CANIDStats> ids;
+    idStatsTable.snapshot(ids);
+    for (const CANIDStats& stats : ids) {
+        char id[16];
+        // candump처럼 확장 ID는 8자리, 표준 ID는 3자리
+        snprintf(id, sizeof(id), (stats.id & CAN_EFF_FLAG) ? "0x%08X" : "0x%03X", stats.id & CAN_EFF_MASK);
+        std::string idLabels = labels;
+        MetricsWriter::label(idLabels, "id", id);
+        writer.sample("vsensor_can_id_frames_total", MetricType::Counter, "ID별 수신 프레임 수 (ID 통계 표)", idLabels,
+                      stats.frames);
+        writer.sample("vsensor_can_id_interval_seconds", MetricType::Gauge, "ID별 수신 간격 이동 평균", idLabels,
+                      stats.intervalNs / 1e9);
+        writer.sample("vsensor_can_id_jitter_seconds", MetricType::Gauge, "ID별 수신 간격 지터", idLabels,
+                      stats.jitterNs / 1e9);
+        writer.sample("vsensor_can_id_last_seen_timestamp_seconds", MetricType::Gauge, "ID별 마지막 수신 시각 (유닉스 시간)",
+                      idLabels, stats.lastSeenNs / 1e9);
+    }
+    writer.sample("vsensor_can_id_table_entries", MetricType::Gauge, "ID 통계 표에 등록된 ID 수", labels,
+                  idStatsTable.size());
+    writer.sample("vsensor_can_id_table_overflow_total", MetricType::Counter, "ID 통계 표가 가득 차서 기록하지 못한 프레임 수",
+                  labels, idStatsTable.overflow());
+    writer.sample("vsensor_can_connection_status", MetricType::Gauge, "연결 상태 (0: 끊김, 1: 미흡, 2: 양호)", labels,
+                  connected ? connectionStatus.load() : 0);
+}
+
+void CANCommunication::setMessageIDs(const std::vector<canid_t>& ids) {
+    uint64_t enabled = 0;
+    for (canid_t id : ids) {
+        int index = can_codec::messageIndex(id);
+        if (index < 0) {
+            std::cerr << "[경고] 정의되지 않은 CAN ID 무시: 0x" << std::hex << id << std::dec << std::endl;
+            continue;
+        }
+        enabled |= 1ull << index;
+    }
+    enabledMessages.store(enabled);
+
+    std::lock_guard<std::mutex> lock(filterMutex);
+    if (socket_fd >= 0) {
+        applyReceiveFilter(socket_fd);
+    }
+}
+
+void CANCommunication::enableMessage(canid_t id, bool enable) {
+    std::vector<canid_t> ids = messageIDs();
+    auto it = std::find(ids.begin(), ids.end(), normalizeCANID(id));
+    if (enable && it == ids.end()) {
+        ids.push_back(id);
+    } else if (!enable && it != ids.end()) {
+        ids.erase(it);
+    }
+    setMessageIDs(ids);
+}
+
+std::vector<canid_t> CANCommunication::messageIDs() const {
+    std::vector<canid_t> ids;
+    uint64_t enabled = enabledMessages.load();
+    for (size_t m = 0; m < can_codec::kMessageCount; ++m) {
+        if (enabled & (1ull << m)) {
+            ids.push_back(can_codec::kMessages[m].id);
+        }
+    }
+    return ids;
+}
+
+void CANCommunication::setErrorFilter(can_err_mask_t mask) {
+    errorFilterMask.store(mask);
+
+    std::lock_guard<std::mutex> lock(filterMutex);
+    if (socket_fd >= 0) {
+        applyReceiveFilter(socket_fd);
+    }
+}
+
+void CANCommunication::setReceiveAllIDs(bool enable) {
+    receiveAllIDs.store(enable);
+
+    std::lock_guard<std::mutex> lock(filterMutex);
+    if (socket_fd >= 0) {
+        applyReceiveFilter(socket_fd);
+    }
+}
+
+void CANCommunication::idStats(std::vector<CANIDStats>& out) const {
+    idStatsTable.snapshot(out);
+}
+
+void CANCommunication::resetIDStats() {
+    // 표는 반응기 스레드만 쓰므로 지우기도 반응기 스레드에서
+    if (reactor) {
+        reactor->runSync([this] { idStatsTable.clear(); });
+    } else {
+        idStatsTable.clear();
+    }
+}
+
+std::vector<CANLatencyStats> CANCommunication::latencyStats() const {
+    std::vector<CANLatencyStats> stats;
+    for (size_t m = 0; m < can_codec::kMessageCount; ++m) {
+        stats.push_back({can_codec::kMessages[m].id,
+                         latencyHistograms[m].summary(),
+                         interArrivalHistograms[m].summary()});
+    }
+    return stats;
+}
+
+void CANCommunication::resetLatencyStats() {
+    for (size_t m = 0; m < can_codec::kMessageCount; ++m) {
+        latencyHistograms[m].reset();
+        interArrivalHistograms[m].reset();
+    }
+    std::lock_guard<std::mutex> lock(txStampMutex);
+    for (TxStampQueue& queue : txStamps) {
+        queue.head = queue.tail;
+    }
 }
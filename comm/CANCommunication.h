@@ -2,6 +2,16 @@
 #define CANCOMMUNICATION_H
 
 #include "HardwareCommunication.h"
+#include "CANSignalCodec.h"
+#include "CANBatchDecoder.h"
+#include "CANIDStatsTable.h"
+#include "LatencyHistogram.h"
+#include "SPSCRing.h"
+#include "CommRecord.h"
+#include "PeriodicScheduler.h"
+#include "MessageSchedule.h"
+#include "IMUSignalModel.h"
+#include "Metrics.h"
 #include <string>
 #include <linux/can.h>
 #include <linux/can/raw.h>
@@ -11,52 +21,257 @@
 #include <cstring>
 #include <unistd.h>
 #include <random>
+#include <array>
 #include <vector>
-#include <map>
 #include <mutex>
-#include <unordered_map>
 #include <QObject>
 
-class CANCommunication : public QObject, public HardwareCommunication {
+// 송수신 I/O 방식
+enum class CANIOMode {
+    PerFrame,  // 프레임마다 write()/read() 호출
+    Batched    // sendmmsg()/recvmmsg()로 여러 프레임을 한 번에 처리
+};
+
+// 송수신 프레임 / IMU 샘플 누적 카운터 (Classic vs FD 처리량 비교용)
+struct CANTrafficStats {
+    uint64_t framesSent;
+    uint64_t samplesSent;
+    uint64_t payloadBytesSent;
+    uint64_t framesReceived;
+    uint64_t samplesReceived;
+    uint64_t writeFailures;  // 송신하지 못한 프레임
+    uint64_t unknownIDs;     // kMessages에 없는 ID 수신
+    uint64_t invalidFrames;  // 길이가 맞지 않는 수신 프레임
+};
+
+// ID별 송신->수신 지연 / 수신 간격 통계 (커널 수신 타임스탬프 기준)
+struct CANLatencyStats {
+    canid_t id;
+    HistogramSummary latency;       // 송신 직전 시각 -> 커널 수신 타임스탬프 (자기 송신 프레임만)
+    HistogramSummary interArrival;  // 같은 ID 프레임 간 커널 수신 간격
+};
+
+class CANCommunication : public QObject, public HardwareCommunication, public MetricsSource {
     Q_OBJECT
 public:
     explicit CANCommunication(const std::string& interfaceName);
     ~CANCommunication();
 
+    const std::string& interface() const { return interfaceName; }
+    void setBusIndex(uint8_t index) { busIndex = index; }  // 수신 레코드에 기록할 버스 번호 (start() 전에 설정)
+    uint8_t bus() const { return busIndex; }
+
     void sendData(const can_frame& frame);
+    void sendFrames(const can_frame* frames, size_t count);  // 현재 I/O 방식으로 여러 프레임 송신
+    void sendFDData(const canfd_frame& frame);
+    void sendFDFrames(const canfd_frame* frames, size_t count);
+
+    // 캡처 재생: 프레임 묶음을 반응기 스레드에서 송신 (어느 스레드에서나 호출, 연결 중일 때만)
+    void replayFrames(std::vector<can_frame> frames);
+    void replayFDFrames(std::vector<canfd_frame> frames);
 
     void enableCANSend(bool);
     std::atomic<bool> canSendEnabled{false}; // CAN 송신 활성화 여부
-    void setSendPeriod(int);
+    void setSendPeriodUs(int64_t periodUs);       // 최소 100us
+    void setOverrunPolicy(OverrunPolicy policy);  // 송신 작업이 주기를 넘겼을 때 처리 방식
+    SchedulerStats sendSchedulerStats() const;    // 송신 주기 지터 / 초과 통계
+    void resetSendSchedulerStats();
+    // 메시지별 주기 / 위상 / 지터 일정. 비어 있지 않으면 setSendPeriodUs()의 고정 주기 송신 대신
+    // 타이밍 휠에서 만료된 메시지만 송신하고, 같은 틱에 만료된 메시지는 한 번에 묶어 보낸다.
+    // 일정의 ID는 can_codec::kMessages 밖이어도 되며 setMessageIDs()의 영향을 받지 않는다.
+    void setMessageSchedule(const std::vector<ScheduledMessage>& messages, uint64_t seed = 0);
+    void triggerMessage(size_t index);  // 이벤트 메시지 송신 요청 (어느 스레드에서나, 연결 중일 때만)
+    MessageScheduleStats messageScheduleStats() const;
+    // 송신 값 합성 시드 (같은 시드와 설정이면 같은 값 수열, 기본은 무작위). 연결 중이면 값 스트림을 처음부터 다시 시작
+    // 샘플 간격은 시작 시점의 송신 주기 / 메시지 주기와 FD 프레임당 샘플 수로 정한다.
+    void setSignalSeed(uint64_t seed);
+    uint64_t signalSeed() const;
+    IMUSignalStats signalStats() const;  // 고정 주기 송신과 메시지 일정 합계
+    void setIOMode(CANIOMode mode);
+    void setBatchSize(int frames);
+
+    void setFDMode(bool enable);              // CAN FD 프레임으로 IMU 데이터 송신
+    void setFDSamplesPerFrame(int samples);   // FD 프레임 하나에 담을 IMU 샘플(3축) 개수
+    void setFDBitRateSwitch(bool enable);     // FD 프레임에 BRS 플래그 설정
+
+    // 송수신할 메시지 ID 집합 (can_codec::kMessages의 부분집합). 변경 시 커널 필터도 재설치
+    void setMessageIDs(const std::vector<canid_t>& ids);
+    void enableMessage(canid_t id, bool enable);
+    std::vector<canid_t> messageIDs() const;
+    void setErrorFilter(can_err_mask_t mask);  // 수신할 에러 프레임 종류 (기본 0: 수신 안 함)
+    // 메시지 ID 집합 밖의 프레임도 수신 (ID별 통계에만 기록, 해독 / 수신 링은 활성화된 메시지만)
+    void setReceiveAllIDs(bool enable);
+    // ID별 수신 통계 (처음 수신한 순서, 실행 중 조회 가능)
+    void idStats(std::vector<CANIDStats>& out) const;
+    void resetIDStats();
+    CANTrafficStats trafficStats() const;
+    std::vector<CANLatencyStats> latencyStats() const;  // 실행 중 조회 가능
+    void resetLatencyStats();
+    void collectMetrics(MetricsWriter& writer) const override;
+
+    // 수신 레코드 링 (생산자: 반응기 스레드, 소비자: UI 스레드)
+    size_t drainRecords(CommRecord* out, size_t maxRecords);
+    uint64_t droppedRecords() const;
+    static QString formatRecord(const CommRecord& record);
+
+    static constexpr int kMaxBatchSize = 1024;  // UIO_MAXIOV
+    static constexpr size_t kUIRingCapacity = 8192;
+    static constexpr int kIMUSampleBytes = 6;   // 16비트 raw x 3
+    // FD 페이로드: [샘플 수(1바이트)][샘플0][샘플1]... (샘플 크기는 메시지 정의에 따름)
+    static constexpr int kMaxFDSamplesPerFrame = (CANFD_MAX_DLEN - 1) / kIMUSampleBytes;
 
 protected:
-    void run() override;
+    bool attach(EventReactor& eventReactor) override;
+    void detach() override;
+    void onTransitionFinished(const ChannelTransition& result) override;
 
 signals:
-    void dataReceived(const QString &data);  // 수신된 데이터를 CommSimulator에 전달
     void connectionStatusChanged(const QString& status);
+    // startAsync / stopAsync 완료 (반응기 스레드에서 발생하므로 UI에는 큐 연결로 전달됨)
+    void transitionFinished(bool connected, qint64 elapsedNs);
 
 private:
     std::string interfaceName;
+    uint8_t busIndex{0};
     int socket_fd{-1};
-    std::default_random_engine randomEngine;
-    std::map<int, std::pair<float, float>> idDataRanges;
-    std::mutex dataMutex;
-
-    std::unordered_map<int, std::string> idToDataType;
     std::atomic<int> connectionStatus{0};  // 0: 끊김, 1: 미흡, 2: 양호
 
-    std::atomic<int> sendPeriodMs{2000}; // 송신 주기 (기본 100ms)
-    std::chrono::steady_clock::time_point lastReceiveTime;  // 마지막 수신 시간 기록
-
-    void initializeSocket(int& socket_fd, struct sockaddr_can& addr, struct ifreq& ifr);
-    float generateRandomValue(float minValue, float maxValue);
-    void sendIMUData();
-    int generateRandomCANID();
-    void handleIncomingData();
-    void processReceivedData(const can_frame& frame);
-    void displayDataMeaning(const can_frame& frame);
-    void updateConnectionStatus();
+    static_assert(can_codec::kMessageCount < 64, "메시지 활성화 비트마스크 크기 초과");
+    static constexpr uint64_t kAllMessages = (1ull << can_codec::kMessageCount) - 1;
+    std::atomic<uint64_t> enabledMessages{kAllMessages};  // kMessages 인덱스별 활성화 비트
+    std::atomic<can_err_mask_t> errorFilterMask{0};
+    std::atomic<bool> receiveAllIDs{false};
+    std::mutex filterMutex;  // 소켓 닫기와 필터 재설치 직렬화
+
+    PeriodicScheduler sendScheduler{2000000000LL};  // 송신 주기 (기본 2000ms, 절대 데드라인)
+    TimerFd sendTimer;     // sendScheduler가 설정하는 송신 타이머
+    TimerFd statusTimer;   // 연결 상태 갱신 타이머
+    // 메시지 일정 (반응기 스레드 전용, 설정 시에만 버퍼 재할당)
+    MessageSchedule messageSchedule;
+    TimerFd scheduleTimer;  // 다음 만료 시각에 1회성으로 설정
+    std::vector<uint32_t> dueMessages;
+    std::vector<can_frame> scheduledFrames;
+    std::vector<canfd_frame> scheduledFDFrames;
+    // 메시지 일정 ID -> 페이로드 형식 (kMessages 인덱스), ID 순 정렬. 반응기 스레드 전용
+    // 일정 ID로 받은 프레임은 해당 형식의 수신 / 지연 통계에 합산한다.
+    std::vector<std::pair<canid_t, uint8_t>> scheduledLayouts;
+    std::vector<struct can_filter> scheduleFilters;  // 일정 ID 수신 필터 (filterMutex)
+    static constexpr size_t kMaxReceiveFilters = 512;  // 커널 CAN_RAW_FILTER_MAX
+    // 송신 값 (반응기 스레드 전용): 고정 주기 송신은 kMessages 순서, 메시지 일정은 일정 순서의 스트림
+    std::atomic<uint64_t> signalSeedValue;
+    IMUSignalSet cycleSignals;
+    IMUSignalSet scheduleSignals;
+    static constexpr int64_t kStatusIntervalNs = 1000000000LL;
+
+    // 한 주기 송신 프레임 (반응기 스레드 전용, 재사용)
+    std::array<can_frame, can_codec::kMessageCount> txFrames{};
+    std::array<canfd_frame, can_codec::kMessageCount> txFDFrames{};
+    std::atomic<int64_t> lastReceiveNs{0};  // 마지막 수신 시간 기록 (커널 수신 타임스탬프, CLOCK_REALTIME ns)
+
+    // 커널 타임스탬프 기반 지연 측정 (인덱스: can_codec::kMessages)
+    // 같은 ID 프레임이 여러 개 전송 중일 수 있으므로 (CatchUp / sendmmsg / 재생) 송신 직전 시각을 송신 순서대로 쌓아 두고
+    // 자기 송신 프레임의 수신 확인과 ID / 페이로드가 같은 가장 오래된 항목을 짝지음 (그보다 앞선 항목은 유실로 보고 버림)
+    struct TxStamp {
+        int64_t ns;
+        canid_t id;
+        uint32_t tag;  // 페이로드 해시
+    };
+    static constexpr size_t kTxStampCapacity = 1024;  // 형식별, 2의 거듭제곱 (가득 차면 가장 오래된 항목부터 버림)
+    struct TxStampQueue {
+        std::array<TxStamp, kTxStampCapacity> entries;
+        uint64_t head{0};
+        uint64_t tail{0};
+    };
+    std::array<TxStampQueue, can_codec::kMessageCount> txStamps;
+    std::mutex txStampMutex;  // 송신은 반응기 스레드 밖(sendData() 등)에서도 호출됨
+    std::array<int64_t, can_codec::kMessageCount> lastRxNs{};               // 반응기 스레드 전용
+    std::array<LatencyHistogram, can_codec::kMessageCount> latencyHistograms;
+    std::array<LatencyHistogram, can_codec::kMessageCount> interArrivalHistograms;
+    static constexpr size_t kControlBufferSize = 128;  // SCM_TIMESTAMPING(timespec x 3) 수용
+
+    std::atomic<CANIOMode> ioMode{CANIOMode::PerFrame};
+    std::atomic<int> batchSize{32};  // sendmmsg/recvmmsg 한 번에 처리할 최대 프레임 수
+
+    std::atomic<bool> fdMode{false};
+    std::atomic<bool> fdBitRateSwitch{true};
+    std::atomic<int> fdSamplesPerFrame{kMaxFDSamplesPerFrame};
+    bool fdFramesEnabled{false};  // 소켓에 CAN_RAW_FD_FRAMES가 설정되었는지 여부
+
+    // 누적 카운터 (trafficStats()와 MetricsRegistry로 내보냄)
+    // ID별 카운터 인덱스는 can_codec::kMessages, 송신의 마지막 칸은 정의되지 않은 ID
+    std::array<MetricCounter, can_codec::kMessageCount + 1> framesSent;
+    std::array<MetricCounter, can_codec::kMessageCount> framesReceived;
+    MetricCounter samplesSent;
+    MetricCounter payloadBytesSent;
+    MetricCounter samplesReceived;
+    MetricCounter writeFailures;
+    MetricCounter receiveFailures;
+    MetricCounter unknownIDs;
+    MetricCounter invalidFrames;
+    MetricCounter errorFrames;
+
+    // recvmmsg용 수신 버퍼 (반응기 스레드 전용, 배치 크기 변경 시에만 재할당)
+    // Classic 프레임도 canfd_frame 버퍼로 받고 msg_len(CAN_MTU/CANFD_MTU)으로 구분한다.
+    std::vector<canfd_frame> rxFrames;
+    std::vector<struct iovec> rxIov;
+    std::vector<struct mmsghdr> rxMsgs;
+    std::vector<std::array<char, kControlBufferSize>> rxControl;
+
+    // 배치 수신 시 검증을 통과한 프레임 (디코딩은 메시지별로 모아 한 번에, 내보내기는 수신 순서대로)
+    struct PendingFrame {
+        int64_t timestampNs;
+        uint32_t frame;        // rxFrames 위치
+        uint32_t first;        // rxDecoder 결과 열에서 첫 샘플 위치
+        uint8_t index;         // kMessages 인덱스
+        uint8_t sampleCount;
+        bool fd;
+    };
+    std::vector<PendingFrame> rxPending;
+    CANBatchDecoder rxDecoder;
+
+    SPSCRing<CommRecord, kUIRingCapacity> uiRing;  // 반응기 스레드 -> UI
+    CANIDStatsTable idStatsTable;                  // 반응기 스레드가 기록, UI / 지표가 읽음
+
+    int initializeSocket();  // 설정한 소켓 반환 (필터 제외), 실패 시 예외
+    void applyReceiveFilter(int fd);  // filterMutex 안에서 호출
+    void closeSocket();
+    void onSendTimer();
+    void sendIMUCycle();  // 활성화된 메시지 한 주기 분량 송신
+    void onScheduleTimer();
+    void startSchedule();   // 반응기 스레드에서: 고정 주기 타이머 대신 일정 타이머 사용
+    void armScheduleTimer();
+    void sendScheduledMessages();  // dueMessages를 한 번에 송신
+    int64_t sampleIntervalNs(uint8_t layout, int64_t periodNs) const;
+    void configureCycleSignals();
+    void configureScheduleSignals();
+    void fillFrame(const can_codec::MessageDesc& msg, canid_t canID, IMUSignalSet& signalSet, size_t stream,
+                   can_frame& frame);
+    void fillFDFrame(const can_codec::MessageDesc& msg, canid_t canID, IMUSignalSet& signalSet, size_t stream,
+                     canfd_frame& frame);
+    void handleIncomingData(uint32_t events);
+    void receiveSingleFrame();
+    void receiveFrameBatch();
+    void prepareReceiveBuffers(size_t count);
+    template <typename Frame>
+    void sendFrameBatch(const Frame* frames, size_t count);
+    void encodeIMUSample(const can_codec::MessageDesc& msg, IMUSignalSet& signalSet, size_t stream, uint8_t* out);
+    void logSentFrame(canid_t canID, const uint8_t* data, int length, bool fd);
+    template <typename Frame>
+    void recordTransmitTimes(const Frame* frames, size_t count, int64_t txNs);  // 송신 직전 기록
+    template <typename Frame>
+    void cancelTransmitTimes(const Frame* frames, size_t count, int64_t txNs);  // 송신 실패분 무효화
+    int64_t matchTransmitTime(int index, const canfd_frame& frame);  // 짝이 없으면 0
+    int layoutIndex(canid_t canID) const;  // kMessages 또는 메시지 일정 ID -> 형식 인덱스, 없으면 -1
+    void countSentFrame(canid_t canID, int samples, int length);
+    void processReceivedData(const canfd_frame& frame, bool fd, int64_t rxTimestampNs, bool ownMessage);
+    // 기록 / 통계 / 길이 검증까지 (디코딩 전), 반환: kMessages 인덱스 (버릴 프레임이면 -1)
+    int acceptReceivedFrame(const canfd_frame& frame, bool fd, int64_t rxTimestampNs, bool ownMessage,
+                            const uint8_t*& samples, int& sampleCount);
+    CommRecord makeRecord(const canfd_frame& frame, bool fd, int64_t rxTimestampNs, int sampleIndex,
+                          int sampleCount) const;
+    void publishSample(CommRecord& record, const uint8_t* sample, int sampleBytes);
+    void publishDecodedBatch();
+    void updateConnectionStatus();  // 상태 타이머 (1초)
 };
 
 #endif // CANCOMMUNICATION_H
@@ -0,0 +1,150 @@
+#include "CANIDStatsTable.h"
+#include <cstring>
+#include <thread>
+
+static_assert((CANIDStatsTable::kCapacity & (CANIDStatsTable::kCapacity - 1)) == 0, "kCapacity는 2의 거듭제곱이어야 함");
+static_assert(CANIDStatsTable::kMaxEntries <= UINT16_MAX, "order 배열은 16비트 슬롯 인덱스");
+
+namespace {
+
+constexpr int kEwmaShift = 4;  // 지수 이동 평균 가중치 1/16
+
+constexpr int log2(size_t n) { return n <= 1 ? 0 : 1 + log2(n / 2); }
+
+}  // namespace
+
+size_t CANIDStatsTable::slotIndex(uint32_t key) {
+    // 피보나치 해싱: 하위 비트가 비슷한 연속 ID도 고르게 분산
+    return static_cast<size_t>((key * 2654435769u) >> (32 - log2(kCapacity)));
+}
+
+CANIDStatsTable::Slot* CANIDStatsTable::findOrInsert(uint32_t key) {
+    size_t index = slotIndex(key);
+    for (;;) {
+        uint32_t current = table[index].key.load(std::memory_order_relaxed);
+        if (current == key) {
+            return &table[index];
+        }
+        if (current == kEmpty) {
+            break;
+        }
+        index = (index + 1) & (kCapacity - 1);
+    }
+
+    uint32_t count = used.load(std::memory_order_relaxed);
+    if (count >= kMaxEntries) {
+        overflowCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    // 읽는 쪽은 used까지의 order만 보므로 키와 순서를 먼저 기록하고 used를 공개
+    table[index].key.store(key, std::memory_order_relaxed);
+    order[count].store(static_cast<uint16_t>(index), std::memory_order_relaxed);
+    used.store(count + 1, std::memory_order_release);
+    return &table[index];
+}
+
+void CANIDStatsTable::record(canid_t canID, const uint8_t* data, uint8_t length, bool fd, int64_t timestampNs) {
+    Slot* slot = findOrInsert(key(canID));
+    if (slot == nullptr) {
+        return;
+    }
+
+    // 쓰는 스레드가 하나뿐이므로 자기 필드는 relaxed로 읽어도 최신 값
+    uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t frames = slot->frames.load(std::memory_order_relaxed);
+    int64_t lastSeenNs = slot->lastSeenNs.load(std::memory_order_relaxed);
+    if (frames == 0) {
+        slot->firstSeenNs.store(timestampNs, std::memory_order_relaxed);
+    } else if (timestampNs >= lastSeenNs) {
+        int64_t interval = timestampNs - lastSeenNs;
+        int64_t mean = slot->intervalNs.load(std::memory_order_relaxed);
+        int64_t jitter = slot->jitterNs.load(std::memory_order_relaxed);
+        if (frames == 1) {
+            mean = interval;  // 첫 간격으로 초기화
+        } else {
+            int64_t deviation = interval - mean;
+            mean += deviation / (1 << kEwmaShift);
+            jitter += ((deviation < 0 ? -deviation : deviation) - jitter) / (1 << kEwmaShift);
+        }
+        slot->intervalNs.store(mean, std::memory_order_relaxed);
+        slot->jitterNs.store(jitter, std::memory_order_relaxed);
+    }
+    slot->frames.store(frames + 1, std::memory_order_relaxed);
+    slot->lastSeenNs.store(timestampNs, std::memory_order_relaxed);
+    slot->info.store(length | (fd ? 1u << 8 : 0u), std::memory_order_relaxed);
+
+    uint64_t words[kDataWords] = {};
+    memcpy(words, data, length < CANFD_MAX_DLEN ? length : CANFD_MAX_DLEN);
+    for (size_t w = 0; w < (length + sizeof(uint64_t) - 1) / sizeof(uint64_t) && w < kDataWords; ++w) {
+        slot->data[w].store(words[w], std::memory_order_relaxed);
+    }
+
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void CANIDStatsTable::clear() {
+    uint32_t count = used.load(std::memory_order_relaxed);
+    used.store(0, std::memory_order_release);
+    for (uint32_t i = 0; i < count; ++i) {
+        Slot& slot = table[order[i].load(std::memory_order_relaxed)];
+        uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.key.store(kEmpty, std::memory_order_relaxed);
+        slot.frames.store(0, std::memory_order_relaxed);
+        slot.lastSeenNs.store(0, std::memory_order_relaxed);
+        slot.intervalNs.store(0, std::memory_order_relaxed);
+        slot.jitterNs.store(0, std::memory_order_relaxed);
+        for (std::atomic<uint64_t>& word : slot.data) {
+            word.store(0, std::memory_order_relaxed);
+        }
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+    overflowCount.store(0, std::memory_order_relaxed);
+}
+
+void CANIDStatsTable::snapshot(std::vector<CANIDStats>& out) const {
+    out.clear();
+    uint32_t count = used.load(std::memory_order_acquire);
+    out.reserve(count);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const Slot& slot = table[order[i].load(std::memory_order_relaxed)];
+        CANIDStats stats;
+        uint64_t words[kDataWords];
+        uint32_t key;
+        uint32_t info;
+        for (;;) {
+            uint32_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();  // 반응기 스레드가 쓰는 중 (단일 코어에서도 진행되도록 양보)
+                continue;
+            }
+            key = slot.key.load(std::memory_order_relaxed);
+            stats.frames = slot.frames.load(std::memory_order_relaxed);
+            stats.firstSeenNs = slot.firstSeenNs.load(std::memory_order_relaxed);
+            stats.lastSeenNs = slot.lastSeenNs.load(std::memory_order_relaxed);
+            stats.intervalNs = slot.intervalNs.load(std::memory_order_relaxed);
+            stats.jitterNs = slot.jitterNs.load(std::memory_order_relaxed);
+            info = slot.info.load(std::memory_order_relaxed);
+            for (size_t w = 0; w < kDataWords; ++w) {
+                words[w] = slot.data[w].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == before) {
+                break;
+            }
+        }
+        if (key == kEmpty || stats.frames == 0) {
+            continue;  // clear() 도중 또는 첫 기록 전
+        }
+        stats.id = key;
+        stats.length = static_cast<uint8_t>(info & 0xFF);
+        stats.fd = (info >> 8) & 1;
+        memcpy(stats.data, words, sizeof(stats.data));
+        out.push_back(stats);
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef CANIDSTATSTABLE_H
+#define CANIDSTATSTABLE_H
+
+#include "Metrics.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <linux/can.h>
+
+// ID 하나의 수신 통계 스냅샷
+struct CANIDStats {
+    canid_t id;            // 29비트 ID (수신 프레임의 CAN_EFF_FLAG 포함)
+    uint64_t frames;
+    int64_t firstSeenNs;   // 커널 수신 타임스탬프 (CLOCK_REALTIME)
+    int64_t lastSeenNs;
+    int64_t intervalNs;    // 수신 간격 지수 이동 평균 (가중치 1/16)
+    int64_t jitterNs;      // |간격 - 평균 간격|의 지수 이동 평균 (RFC 3550 방식)
+    uint8_t length;
+    bool fd;
+    uint8_t data[CANFD_MAX_DLEN];  // 마지막 페이로드
+};
+
+// CAN ID별 수신 통계 (고정 용량 open addressing, 선형 탐사)
+// 쓰기는 버스의 반응기 스레드 하나만 (락 없음), 읽기는 어느 스레드에서나 항목별 seqlock으로 일관된 스냅샷을 얻는다.
+// 항목은 지우지 않으며 kMaxEntries를 넘는 새 ID는 overflow()로만 센다.
+class CANIDStatsTable {
+public:
+    static constexpr size_t kCapacity = 2048;                 // 2의 거듭제곱
+    static constexpr size_t kMaxEntries = kCapacity * 3 / 4;  // 탐사 길이가 길어지지 않도록 75%까지만 사용
+
+    // 반응기 스레드 전용
+    void record(canid_t canID, const uint8_t* data, uint8_t length, bool fd, int64_t timestampNs);
+    void clear();
+
+    // 어느 스레드에서나: 처음 수신한 순서대로 out을 채움 (쓰는 중인 항목은 끝날 때까지 재시도)
+    void snapshot(std::vector<CANIDStats>& out) const;
+    size_t size() const { return used.load(std::memory_order_acquire); }
+    uint64_t overflow() const { return overflowCount.load(std::memory_order_relaxed); }
+
+    // RTR / ERR 비트는 키에서 제외
+    static uint32_t key(canid_t canID) { return canID & (CAN_EFF_FLAG | CAN_EFF_MASK); }
+
+private:
+    static constexpr uint32_t kEmpty = UINT32_MAX;  // RTR 비트가 빠진 키는 이 값이 될 수 없음
+    static constexpr size_t kDataWords = CANFD_MAX_DLEN / sizeof(uint64_t);
+
+    // 아래 필드는 sequence가 짝수일 때만 일관됨 (값은 relaxed atomic으로 읽고 쓰기)
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<uint32_t> key{kEmpty};
+        std::atomic<uint32_t> sequence{0};  // 홀수: 쓰는 중
+        std::atomic<uint64_t> frames{0};
+        std::atomic<int64_t> firstSeenNs{0};
+        std::atomic<int64_t> lastSeenNs{0};
+        std::atomic<int64_t> intervalNs{0};
+        std::atomic<int64_t> jitterNs{0};
+        std::atomic<uint32_t> info{0};  // 길이 | FD << 8
+        std::atomic<uint64_t> data[kDataWords]{};
+    };
+
+    static size_t slotIndex(uint32_t key);
+    Slot* findOrInsert(uint32_t key);
+
+    Slot table[kCapacity];
+    std::atomic<uint16_t> order[kMaxEntries]{};  // 등록 순서의 슬롯 인덱스 (used보다 먼저 기록)
+    std::atomic<uint32_t> used{0};
+    std::atomic<uint64_t> overflowCount{0};
+};
+
+#endif // CANIDSTATSTABLE_H
@@ -0,0 +1,13 @@
+#ifndef CANID_H
+#define CANID_H
+
+#include <linux/can.h>
+
+// 11비트를 넘는 ID는 확장 프레임이므로 CAN_EFF_FLAG를 붙임 (RTR / ERR 플래그는 그대로)
+// 커널은 송신 / 필터 / 수신 모두 플래그로 표준 / 확장을 구분하므로, 설정이나 명령행에서 플래그 없이 받은
+// 29비트 ID는 프레임 / 필터를 만들거나 비교하기 전에 이 함수를 거쳐야 한다.
+constexpr canid_t normalizeCANID(canid_t id) {
+    return (id & CAN_EFF_MASK) > CAN_SFF_MASK ? (id | CAN_EFF_FLAG) : id;
+}
+
+#endif // CANID_H
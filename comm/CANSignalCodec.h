@@ -0,0 +1,236 @@
+#ifndef CANSIGNALCODEC_H
+#define CANSIGNALCODEC_H
+
+#include "CANId.h"
+#include <linux/can.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// CAN 메시지 / 신호 정의 테이블과 인코딩·디코딩 함수
+// 새 메시지를 추가할 때는 kMessages에 항목 하나만 추가하면 된다. (29비트 ID는 CAN_EFF_FLAG 포함)
+namespace can_codec {
+
+constexpr int kMaxFields = 3;
+
+// raw 값 형식 (샘플 내 little-endian 16비트)
+enum class RawType : uint8_t {
+    UInt16,
+    Int16
+};
+
+// 신호 하나: 샘플 내 byteOffset 위치의 16비트 raw, 물리값 = raw * scale + offset
+// [minValue, maxValue]는 rawType으로 표현할 수 있어야 한다 (static_assert로 확인).
+struct SignalDesc {
+    const char* name;
+    uint8_t byteOffset;
+    float scale;
+    float offset;
+    float minValue;
+    float maxValue;
+    RawType rawType;
+};
+
+// 송신 값 합성에 쓰는 운동 모델 (IMUSignalModel), None이면 신호 범위 내 균등 분포
+enum class MotionKind : uint8_t {
+    None,
+    Attitude,  // 자세각 (deg)
+    Accel,     // 비력 (m/s^2, 정지 시 z = -g)
+    Gyro       // 각속도 (deg/s)
+};
+
+struct MessageDesc {
+    canid_t id;
+    const char* name;    // 표시용 데이터 유형
+    uint8_t fieldCount;
+    SignalDesc fields[kMaxFields];
+    MotionKind motion;
+
+    constexpr uint8_t sampleBytes() const { return fieldCount * 2; }
+};
+
+inline constexpr MessageDesc kMessages[] = {
+    {0x19FF1000 | CAN_EFF_FLAG, "[자세] Roll/Pitch/Yaw", 3, {
+        {"Roll",  0, 0.002f, -64.0f, -64.0f, 64.51f, RawType::UInt16},
+        {"Pitch", 2, 0.002f, -64.0f, -64.0f, 64.51f, RawType::UInt16},
+        {"Yaw",   4, 0.002f, -64.0f, -64.0f, 64.51f, RawType::UInt16}}, MotionKind::Attitude},
+    {0x19FF1001 | CAN_EFF_FLAG, "[가속도] Accel_X/Y/Z", 3, {
+        {"Accel_X", 0, 0.01f, -320.0f, -320.0f, 322.55f, RawType::UInt16},
+        {"Accel_Y", 2, 0.01f, -320.0f, -320.0f, 322.55f, RawType::UInt16},
+        {"Accel_Z", 4, 0.01f, -320.0f, -320.0f, 322.55f, RawType::UInt16}}, MotionKind::Accel},
+    {0x19FF1002 | CAN_EFF_FLAG, "[각속도] Gyro_X/Y/Z", 3, {
+        {"Gyro_X", 0, 1.0f / 128.0f, -250.0f, -250.0f, 250.99f, RawType::UInt16},
+        {"Gyro_Y", 2, 1.0f / 128.0f, -250.0f, -250.0f, 250.99f, RawType::UInt16},
+        {"Gyro_Z", 4, 1.0f / 128.0f, -250.0f, -250.0f, 250.99f, RawType::UInt16}}, MotionKind::Gyro},
+};
+
+constexpr size_t kMessageCount = sizeof(kMessages) / sizeof(kMessages[0]);
+
+namespace detail {
+
+// 메시지 수의 2배 이상인 2의 거듭제곱 크기 (선형 탐사 길이를 짧게 유지)
+constexpr size_t indexSize() {
+    size_t size = 8;
+    while (size < kMessageCount * 2) {
+        size <<= 1;
+    }
+    return size;
+}
+
+constexpr size_t kIndexSize = indexSize();
+
+constexpr size_t hashID(canid_t id) {
+    return static_cast<size_t>(((id & CAN_EFF_MASK) * 0x9E3779B1u) >> 16) & (kIndexSize - 1);
+}
+
+// ID -> kMessages 인덱스 (비어 있으면 -1), 컴파일 시점에 생성
+constexpr std::array<int16_t, kIndexSize> buildIndex() {
+    std::array<int16_t, kIndexSize> index{};
+    for (size_t i = 0; i < kIndexSize; ++i) {
+        index[i] = -1;
+    }
+    for (size_t m = 0; m < kMessageCount; ++m) {
+        size_t slot = hashID(kMessages[m].id);
+        while (index[slot] >= 0) {
+            slot = (slot + 1) & (kIndexSize - 1);
+        }
+        index[slot] = static_cast<int16_t>(m);
+    }
+    return index;
+}
+
+constexpr bool hasUniqueIDs() {
+    for (size_t a = 0; a < kMessageCount; ++a) {
+        for (size_t b = a + 1; b < kMessageCount; ++b) {
+            if (kMessages[a].id == kMessages[b].id) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+constexpr bool hasNormalizedIDs() {
+    for (size_t m = 0; m < kMessageCount; ++m) {
+        if (kMessages[m].id != normalizeCANID(kMessages[m].id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool hasValidLayouts() {
+    for (size_t m = 0; m < kMessageCount; ++m) {
+        if (kMessages[m].fieldCount < 1 || kMessages[m].fieldCount > kMaxFields) {
+            return false;
+        }
+        for (int f = 0; f < kMessages[m].fieldCount; ++f) {
+            if (kMessages[m].fields[f].byteOffset + 2 > kMessages[m].sampleBytes()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+constexpr float rawMin(RawType type) { return type == RawType::Int16 ? -32768.0f : 0.0f; }
+constexpr float rawMax(RawType type) { return type == RawType::Int16 ? 32767.0f : 65535.0f; }
+
+constexpr bool hasRepresentableRanges() {
+    for (size_t m = 0; m < kMessageCount; ++m) {
+        for (int f = 0; f < kMessages[m].fieldCount; ++f) {
+            const SignalDesc& signal = kMessages[m].fields[f];
+            float low = (signal.minValue - signal.offset) / signal.scale;
+            float high = (signal.maxValue - signal.offset) / signal.scale;
+            if (signal.scale <= 0.0f || low < rawMin(signal.rawType) || high > rawMax(signal.rawType)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+inline constexpr std::array<int16_t, kIndexSize> kIndex = buildIndex();
+
+}  // namespace detail
+
+static_assert(detail::hasUniqueIDs(), "kMessages에 중복된 CAN ID가 있음");
+static_assert(detail::hasNormalizedIDs(), "kMessages의 29비트 ID에 CAN_EFF_FLAG가 없음");
+static_assert(detail::hasValidLayouts(), "kMessages의 신호 배치가 샘플 크기를 벗어남");
+static_assert(detail::hasRepresentableRanges(), "kMessages의 신호 범위를 raw 형식으로 표현할 수 없음");
+
+// CAN ID -> kMessages 인덱스, 없으면 -1 (불변 테이블이므로 락 없이 호출 가능)
+// 플래그 없이 받은 29비트 ID도 같은 메시지로 찾음
+constexpr int messageIndex(canid_t id) {
+    id = normalizeCANID(id);
+    size_t slot = detail::hashID(id);
+    for (size_t probe = 0; probe < detail::kIndexSize; ++probe) {
+        int16_t m = detail::kIndex[slot];
+        if (m < 0) {
+            return -1;
+        }
+        if (kMessages[m].id == id) {
+            return m;
+        }
+        slot = (slot + 1) & (detail::kIndexSize - 1);
+    }
+    return -1;
+}
+
+constexpr const MessageDesc* findMessage(canid_t id) {
+    int m = messageIndex(id);
+    return m < 0 ? nullptr : &kMessages[m];
+}
+
+// 물리값 -> raw 비트 (신호 범위로 제한한 뒤 변환, NaN은 최솟값)
+constexpr uint16_t toRaw(const SignalDesc& signal, float value) {
+    if (!(value >= signal.minValue)) {
+        value = signal.minValue;
+    }
+    if (value > signal.maxValue) {
+        value = signal.maxValue;
+    }
+    float raw = (value - signal.offset) / signal.scale;
+    // 범위 끝의 반올림 오차로 형식 범위를 넘지 않도록 한 번 더 제한 (범위 밖 변환은 미정의 동작)
+    raw = raw < detail::rawMin(signal.rawType) ? detail::rawMin(signal.rawType) : raw;
+    raw = raw > detail::rawMax(signal.rawType) ? detail::rawMax(signal.rawType) : raw;
+    // 가장 가까운 raw로 반올림 (복원 오차 scale / 2 이내)
+    if (signal.rawType == RawType::Int16) {
+        int32_t rounded = raw < 0.0f ? -static_cast<int32_t>(0.5f - raw) : static_cast<int32_t>(raw + 0.5f);
+        return static_cast<uint16_t>(static_cast<int16_t>(rounded));
+    }
+    return static_cast<uint16_t>(raw + 0.5f);
+}
+
+// raw 비트 -> 물리값
+constexpr float fromRaw(const SignalDesc& signal, uint16_t raw) {
+    int32_t value = signal.rawType == RawType::Int16 ? static_cast<int16_t>(raw) : static_cast<int32_t>(raw);
+    return (value * signal.scale) + signal.offset;
+}
+
+// 물리값 -> 샘플 바이트 (out은 msg.sampleBytes() 이상)
+template <size_t N>
+void encode(const MessageDesc& msg, const float (&values)[N], uint8_t* out) {
+    static_assert(N >= kMaxFields, "값 배열이 신호 수보다 작음");
+    for (int f = 0; f < msg.fieldCount; ++f) {
+        const SignalDesc& signal = msg.fields[f];
+        uint16_t raw = toRaw(signal, values[f]);
+        out[signal.byteOffset] = raw & 0xFF;
+        out[signal.byteOffset + 1] = (raw >> 8) & 0xFF;
+    }
+}
+
+// 샘플 바이트 -> 물리값
+template <size_t N>
+void decode(const MessageDesc& msg, const uint8_t* in, float (&values)[N]) {
+    static_assert(N >= kMaxFields, "값 배열이 신호 수보다 작음");
+    for (int f = 0; f < msg.fieldCount; ++f) {
+        const SignalDesc& signal = msg.fields[f];
+        uint16_t raw = static_cast<uint16_t>(in[signal.byteOffset] | (in[signal.byteOffset + 1] << 8));
+        values[f] = fromRaw(signal, raw);
+    }
+}
+
+}  // namespace can_codec
+
+#endif // CANSIGNALCODEC_H
@@ -0,0 +1,634 @@
+#include "CaptureFile.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <linux/can.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace capture {
+
+namespace {
+
+int64_t monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+bool writeAll(int fd, const void* data, size_t length) {
+    const char* p = static_cast<const char*>(data);
+    while (length > 0) {
+        ssize_t n = ::write(fd, p, length);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool mapFile(int fd, const uint8_t*& map, uint64_t& length) {
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        return false;
+    }
+    length = static_cast<uint64_t>(st.st_size);
+    if (length == 0) {
+        map = nullptr;
+        return true;
+    }
+    void* p = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        return false;
+    }
+    map = static_cast<const uint8_t*>(p);
+    return true;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// "(sec.usec)" -> ns
+bool parseCandumpTimestamp(std::string_view text, int64_t& ns) {
+    if (text.size() < 3 || text.front() != '(' || text.back() != ')') {
+        return false;
+    }
+    text = text.substr(1, text.size() - 2);
+    size_t dot = text.find('.');
+    if (dot == std::string_view::npos) {
+        return false;
+    }
+
+    int64_t seconds = 0;
+    auto [secEnd, secErr] = std::from_chars(text.data(), text.data() + dot, seconds);
+    if (secErr != std::errc() || secEnd != text.data() + dot) {
+        return false;
+    }
+
+    // 소수부는 자릿수와 상관없이 ns로 (candump은 6자리)
+    int64_t fraction = 0;
+    size_t digits = 0;
+    for (size_t i = dot + 1; i < text.size(); ++i) {
+        char c = text[i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        if (digits < 9) {
+            fraction = fraction * 10 + (c - '0');
+            ++digits;
+        }
+    }
+    while (digits < 9) {
+        fraction *= 10;
+        ++digits;
+    }
+    ns = seconds * 1000000000LL + fraction;
+    return true;
+}
+
+std::string_view nextToken(std::string_view& line) {
+    size_t start = line.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos) {
+        line = {};
+        return {};
+    }
+    size_t end = line.find_first_of(" \t\r\n", start);
+    std::string_view token = line.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+    line = (end == std::string_view::npos) ? std::string_view() : line.substr(end);
+    return token;
+}
+
+}  // namespace
+
+std::string indexPath(const std::string& capturePath) {
+    return capturePath + ".idx";
+}
+
+Writer::~Writer() {
+    close();
+}
+
+bool Writer::open(const std::string& path, const std::vector<std::string>& busNames) {
+    close();
+    dataFd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (dataFd < 0) {
+        std::cerr << "[오류] 캡처 파일 열기 실패: " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+    std::string index = indexPath(path);
+    indexFd = ::open(index.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (indexFd < 0) {
+        std::cerr << "[오류] 캡처 인덱스 열기 실패: " << index << ": " << strerror(errno) << std::endl;
+        ::close(dataFd);
+        dataFd = -1;
+        return false;
+    }
+
+    FileHeader header;
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.busCount = static_cast<uint32_t>(busNames.size());
+    std::vector<char> names(busNames.size() * kBusNameLength, '\0');
+    for (size_t i = 0; i < busNames.size(); ++i) {
+        memcpy(names.data() + i * kBusNameLength, busNames[i].data(), std::min(busNames[i].size(), kBusNameLength - 1));
+    }
+
+    IndexHeader indexHeader;
+    memcpy(indexHeader.magic, kIndexMagic, sizeof(kIndexMagic));
+    indexHeader.version = kVersion;
+    indexHeader.entrySize = sizeof(IndexEntry);
+
+    if (!writeAll(dataFd, &header, sizeof(header)) || !writeAll(dataFd, names.data(), names.size()) ||
+        !writeAll(indexFd, &indexHeader, sizeof(indexHeader))) {
+        std::cerr << "[오류] 캡처 헤더 쓰기 실패: " << path << ": " << strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+
+    dataOffset = sizeof(header) + names.size();
+    maxTimestampNs = std::numeric_limits<int64_t>::min();
+    blockBuffer.clear();
+    blockBuffer.reserve(kBlockBytes + sizeof(Record));
+    records = 0;
+    bytes = dataOffset;
+    blocks = 0;
+    return true;
+}
+
+bool Writer::close() {
+    bool ok = true;
+    if (dataFd >= 0) {
+        ok = sealBlock();
+        ::close(dataFd);
+        dataFd = -1;
+    }
+    if (indexFd >= 0) {
+        ::close(indexFd);
+        indexFd = -1;
+    }
+    return ok;
+}
+
+bool Writer::append(const Record& record) {
+    if (dataFd < 0) {
+        return false;
+    }
+    RecordHeader header = record.header;
+    header.length = static_cast<uint8_t>(std::min<size_t>(header.length, kMaxPayload));
+
+    if (blockBuffer.empty()) {
+        blockHeader = BlockHeader{};
+        blockHeader.firstTimestampNs = header.timestampNs;
+        blockHeader.lastTimestampNs = header.timestampNs;
+        blockOpenedNs = monotonicNs();
+    }
+    blockHeader.firstTimestampNs = std::min(blockHeader.firstTimestampNs, header.timestampNs);
+    blockHeader.lastTimestampNs = std::max(blockHeader.lastTimestampNs, header.timestampNs);
+    size_t bit = idBit(header.id);
+    blockHeader.idBits[bit / 64] |= 1ull << (bit % 64);
+    ++blockHeader.recordCount;
+
+    const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(&header);
+    blockBuffer.insert(blockBuffer.end(), headerBytes, headerBytes + sizeof(header));
+    blockBuffer.insert(blockBuffer.end(), record.payload, record.payload + header.length);
+    ++records;
+    bytes += sizeof(header) + header.length;
+
+    if (blockBuffer.size() >= kBlockBytes) {
+        return sealBlock();
+    }
+    return true;
+}
+
+bool Writer::flush() {
+    if (!blockBuffer.empty() && monotonicNs() - blockOpenedNs >= kMaxBlockAgeNs) {
+        return sealBlock();
+    }
+    return true;
+}
+
+bool Writer::sealBlock() {
+    if (blockBuffer.empty()) {
+        return true;
+    }
+    blockHeader.magic = kBlockMagic;
+    blockHeader.payloadBytes = static_cast<uint32_t>(blockBuffer.size());
+
+    // 블록을 먼저 쓰고 인덱스 항목 추가 (중간에 종료되면 열 때 꼬리 블록을 복구)
+    IndexEntry entry;
+    entry.offset = dataOffset;
+    maxTimestampNs = std::max(maxTimestampNs, blockHeader.lastTimestampNs);
+    entry.maxTimestampNs = maxTimestampNs;
+    entry.block = blockHeader;
+
+    bool ok = writeAll(dataFd, &blockHeader, sizeof(blockHeader)) &&
+              writeAll(dataFd, blockBuffer.data(), blockBuffer.size()) &&
+              writeAll(indexFd, &entry, sizeof(entry));
+    if (ok) {
+        dataOffset += sizeof(blockHeader) + blockBuffer.size();
+        bytes += sizeof(blockHeader);
+        ++blocks;
+    }
+    blockBuffer.clear();
+    return ok;
+}
+
+MappedCapture::~MappedCapture() {
+    close();
+}
+
+bool MappedCapture::open(const std::string& path) {
+    close();
+    dataFd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (dataFd < 0 || !mapFile(dataFd, data, dataLength)) {
+        lastError = path + ": " + strerror(errno);
+        close();
+        return false;
+    }
+
+    FileHeader header;
+    if (dataLength < sizeof(header)) {
+        lastError = path + ": 캡처 파일 형식이 아님";
+        close();
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        lastError = path + ": 캡처 파일 형식이 아님";
+        close();
+        return false;
+    }
+    if (header.version != kVersion) {
+        lastError = path + ": 지원하지 않는 캡처 버전 " + std::to_string(header.version);
+        close();
+        return false;
+    }
+    uint64_t firstBlockOffset = sizeof(header) + static_cast<uint64_t>(header.busCount) * kBusNameLength;
+    if (firstBlockOffset > dataLength) {
+        lastError = path + ": 버스 이름 테이블이 잘림";
+        close();
+        return false;
+    }
+    for (uint32_t i = 0; i < header.busCount; ++i) {
+        const char* name = reinterpret_cast<const char*>(data + sizeof(header) + i * kBusNameLength);
+        buses.emplace_back(name, strnlen(name, kBusNameLength));
+    }
+
+    // 인덱스는 통째로 매핑만 함 (항목은 질의 때 필요한 페이지만 읽힘)
+    std::string index = indexPath(path);
+    indexFd = ::open(index.c_str(), O_RDONLY | O_CLOEXEC);
+    if (indexFd >= 0 && mapFile(indexFd, indexMap, indexLength) && indexLength >= sizeof(IndexHeader)) {
+        IndexHeader indexHeader;
+        memcpy(&indexHeader, indexMap, sizeof(indexHeader));
+        if (memcmp(indexHeader.magic, kIndexMagic, sizeof(kIndexMagic)) == 0 &&
+            indexHeader.version == kVersion && indexHeader.entrySize == sizeof(IndexEntry)) {
+            mappedEntries = reinterpret_cast<const IndexEntry*>(indexMap + sizeof(IndexHeader));
+            mappedEntryCount = (indexLength - sizeof(IndexHeader)) / sizeof(IndexEntry);
+            // 마지막 항목이 데이터 파일보다 앞서 있으면 (데이터 쓰기 전 종료) 버림
+            while (mappedEntryCount > 0) {
+                const IndexEntry& last = mappedEntries[mappedEntryCount - 1];
+                if (last.offset + sizeof(BlockHeader) + last.block.payloadBytes <= dataLength) {
+                    break;
+                }
+                --mappedEntryCount;
+            }
+        }
+    }
+
+    // 인덱스 이후의 블록 (기록 중 종료 / 인덱스 없음)
+    uint64_t tailOffset = firstBlockOffset;
+    int64_t maxTimestamp = std::numeric_limits<int64_t>::min();
+    if (mappedEntryCount > 0) {
+        const IndexEntry& last = mappedEntries[mappedEntryCount - 1];
+        tailOffset = last.offset + sizeof(BlockHeader) + last.block.payloadBytes;
+        maxTimestamp = last.maxTimestampNs;
+    }
+    if (!recoverTail(tailOffset, maxTimestamp)) {
+        uint64_t validEnd = tailOffset;
+        if (blockCount() > 0) {
+            const IndexEntry& last = block(blockCount() - 1);
+            validEnd = last.offset + sizeof(BlockHeader) + last.block.payloadBytes;
+        }
+        lastError = path + ": " + std::to_string(validEnd) + " 이후 블록 손상 (앞부분만 사용)";
+    } else {
+        lastError.clear();
+    }
+    return true;
+}
+
+bool MappedCapture::recoverTail(uint64_t offset, int64_t maxTimestamp) {
+    while (offset + sizeof(BlockHeader) <= dataLength) {
+        IndexEntry entry;
+        memcpy(&entry.block, data + offset, sizeof(BlockHeader));
+        if (entry.block.magic != kBlockMagic ||
+            offset + sizeof(BlockHeader) + entry.block.payloadBytes > dataLength) {
+            return false;  // 쓰다 만 블록
+        }
+        entry.offset = offset;
+        maxTimestamp = std::max(maxTimestamp, entry.block.lastTimestampNs);
+        entry.maxTimestampNs = maxTimestamp;
+        recoveredEntries.push_back(entry);
+        offset += sizeof(BlockHeader) + entry.block.payloadBytes;
+    }
+    return offset == dataLength;
+}
+
+void MappedCapture::close() {
+    if (data) {
+        munmap(const_cast<uint8_t*>(data), dataLength);
+        data = nullptr;
+    }
+    if (indexMap) {
+        munmap(const_cast<uint8_t*>(indexMap), indexLength);
+        indexMap = nullptr;
+    }
+    if (dataFd >= 0) {
+        ::close(dataFd);
+        dataFd = -1;
+    }
+    if (indexFd >= 0) {
+        ::close(indexFd);
+        indexFd = -1;
+    }
+    dataLength = 0;
+    indexLength = 0;
+    mappedEntries = nullptr;
+    mappedEntryCount = 0;
+    recoveredEntries.clear();
+    buses.clear();
+}
+
+size_t MappedCapture::firstBlockFor(int64_t fromNs) const {
+    // maxTimestampNs는 단조 증가: 처음으로 fromNs 이상이 되는 블록
+    size_t low = 0;
+    size_t high = blockCount();
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (block(mid).maxTimestampNs < fromNs) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+void MappedCapture::adviseSequential() const {
+    if (data) {
+        madvise(const_cast<uint8_t*>(data), dataLength, MADV_SEQUENTIAL);
+    }
+}
+
+bool Reader::open(const std::string& path) {
+    blockIndex = 0;
+    blockPosition = 0;
+    lastError.clear();
+    if (!capture.open(path)) {
+        return false;
+    }
+    capture.adviseSequential();
+    return true;
+}
+
+bool Reader::next(Record& record) {
+    while (blockIndex < capture.blockCount()) {
+        const BlockHeader& block = capture.block(blockIndex).block;
+        if (blockPosition + sizeof(RecordHeader) > block.payloadBytes) {
+            ++blockIndex;
+            blockPosition = 0;
+            continue;
+        }
+        const uint8_t* p = capture.blockRecords(blockIndex) + blockPosition;
+        memcpy(&record.header, p, sizeof(RecordHeader));
+        if (record.header.length > kMaxPayload ||
+            blockPosition + sizeof(RecordHeader) + record.header.length > block.payloadBytes) {
+            lastError = "블록 " + std::to_string(blockIndex) + " 손상";
+            blockIndex = capture.blockCount();
+            return false;
+        }
+        memcpy(record.payload, p + sizeof(RecordHeader), record.header.length);
+        blockPosition += sizeof(RecordHeader) + record.header.length;
+        return true;
+    }
+    return false;
+}
+
+bool parseCandumpLine(std::string_view line, Record& record, std::string_view& interfaceName) {
+    std::string_view timestamp = nextToken(line);
+    interfaceName = nextToken(line);
+    std::string_view frame = nextToken(line);
+    if (frame.empty() || !parseCandumpTimestamp(timestamp, record.header.timestampNs)) {
+        return false;
+    }
+
+    size_t hash = frame.find('#');
+    if (hash == 0 || hash == std::string_view::npos) {
+        return false;
+    }
+
+    // ID: 3자리 = 표준, 8자리 = 확장
+    uint32_t id = 0;
+    for (size_t i = 0; i < hash; ++i) {
+        int v = hexValue(frame[i]);
+        if (v < 0) {
+            return false;
+        }
+        id = (id << 4) | static_cast<uint32_t>(v);
+    }
+    if (hash > 3) {
+        id |= CAN_EFF_FLAG;
+    }
+
+    std::string_view data = frame.substr(hash + 1);
+    record.header.kind = RecordKind::CAN;
+    record.header.flags = 0;
+    size_t maxLength = CAN_MAX_DLEN;
+    if (!data.empty() && data.front() == '#') {
+        // CAN FD: "##<flags 1자리><data>"
+        if (data.size() < 2 || hexValue(data[1]) < 0) {
+            return false;
+        }
+        int fdFlags = hexValue(data[1]);
+        record.header.kind = RecordKind::CANFD;
+        if (fdFlags & CANFD_BRS) record.header.flags |= kFlagBRS;
+        if (fdFlags & CANFD_ESI) record.header.flags |= kFlagESI;
+        data = data.substr(2);
+        maxLength = CANFD_MAX_DLEN;
+    } else if (!data.empty() && (data.front() == 'R' || data.front() == 'r')) {
+        // RTR 프레임 (데이터 없음, 뒤에 DLC가 올 수 있음)
+        id |= CAN_RTR_FLAG;
+        data = {};
+    }
+
+    // 데이터는 바이트 사이 '.' 구분자를 허용
+    size_t length = 0;
+    for (size_t i = 0; i < data.size();) {
+        if (data[i] == '.') {
+            ++i;
+            continue;
+        }
+        if (i + 1 >= data.size() || length >= maxLength) {
+            return false;
+        }
+        int high = hexValue(data[i]);
+        int low = hexValue(data[i + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        record.payload[length++] = static_cast<uint8_t>((high << 4) | low);
+        i += 2;
+    }
+
+    record.header.id = id;
+    record.header.bus = 0;
+    record.header.length = static_cast<uint8_t>(length);
+    return true;
+}
+
+bool importCandump(const std::string& logPath, const std::string& capturePath, ImportResult& result) {
+    result = ImportResult{};
+
+    // 1차: 버스 이름 수집 (헤더에 먼저 기록해야 하므로)
+    std::FILE* in = std::fopen(logPath.c_str(), "r");
+    if (!in) {
+        std::cerr << "[오류] candump 로그 열기 실패: " << logPath << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    char line[512];
+    Record record;
+    std::string_view interfaceName;
+    while (std::fgets(line, sizeof(line), in)) {
+        if (parseCandumpLine(line, record, interfaceName) &&
+            std::find(result.busNames.begin(), result.busNames.end(), interfaceName) == result.busNames.end()) {
+            result.busNames.emplace_back(interfaceName);
+        }
+    }
+    if (result.busNames.size() > 255) {
+        std::cerr << "[오류] candump 로그의 인터페이스 수 초과: " << result.busNames.size() << std::endl;
+        std::fclose(in);
+        return false;
+    }
+
+    // 2차: 레코드 변환
+    Writer writer;
+    if (!writer.open(capturePath, result.busNames)) {
+        std::fclose(in);
+        return false;
+    }
+    std::rewind(in);
+    while (std::fgets(line, sizeof(line), in)) {
+        ++result.linesRead;
+        if (!parseCandumpLine(line, record, interfaceName)) {
+            ++result.linesSkipped;
+            continue;
+        }
+        auto it = std::find(result.busNames.begin(), result.busNames.end(), interfaceName);
+        record.header.bus = static_cast<uint8_t>(it - result.busNames.begin());
+        if (!writer.append(record)) {
+            std::cerr << "[오류] 캡처 파일 쓰기 실패: " << capturePath << std::endl;
+            std::fclose(in);
+            return false;
+        }
+        ++result.recordsWritten;
+    }
+    std::fclose(in);
+    return writer.close();
+}
+
+size_t formatCandumpLine(const RecordHeader& header, const uint8_t* payload, std::string_view busName,
+                         char* out, size_t capacity) {
+    static const char kHex[] = "0123456789ABCDEF";
+    int64_t seconds = header.timestampNs / 1000000000LL;
+    int64_t micros = (header.timestampNs % 1000000000LL) / 1000;
+    int n = snprintf(out, capacity, "(%lld.%06lld) %.*s ", static_cast<long long>(seconds),
+                     static_cast<long long>(micros), static_cast<int>(busName.size()), busName.data());
+    if (n < 0 || static_cast<size_t>(n) >= capacity) {
+        return 0;
+    }
+    size_t used = static_cast<size_t>(n);
+    auto put = [&](char c) {
+        if (used + 1 < capacity) {
+            out[used++] = c;
+        }
+    };
+
+    if (header.kind == RecordKind::NMEA) {
+        for (size_t i = 0; i < header.length; ++i) {
+            put(static_cast<char>(payload[i]));
+        }
+        out[used] = '\0';
+        return used;
+    }
+
+    // ID: 표준 3자리 / 확장 8자리
+    bool extended = header.id & CAN_EFF_FLAG;
+    uint32_t id = header.id & (extended ? CAN_EFF_MASK : CAN_SFF_MASK);
+    for (int shift = extended ? 28 : 8; shift >= 0; shift -= 4) {
+        put(kHex[(id >> shift) & 0xF]);
+    }
+    put('#');
+    if (header.kind == RecordKind::CANFD) {
+        put('#');
+        int fdFlags = ((header.flags & kFlagBRS) ? CANFD_BRS : 0) | ((header.flags & kFlagESI) ? CANFD_ESI : 0);
+        put(kHex[fdFlags & 0xF]);
+    } else if (header.id & CAN_RTR_FLAG) {
+        put('R');
+    }
+    for (size_t i = 0; i < header.length; ++i) {
+        put(kHex[payload[i] >> 4]);
+        put(kHex[payload[i] & 0xF]);
+    }
+    out[used] = '\0';
+    return used;
+}
+
+bool rebuildIndex(const std::string& capturePath, std::string& error) {
+    // 인덱스 없이 열면 블록 헤더를 따라가며 전체 인덱스를 메모리에 복구함
+    std::string index = indexPath(capturePath);
+    ::unlink(index.c_str());
+    MappedCapture capture;
+    if (!capture.open(capturePath)) {
+        error = capture.error();
+        return false;
+    }
+
+    int fd = ::open(index.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        error = index + ": " + strerror(errno);
+        return false;
+    }
+    IndexHeader header;
+    memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+    header.version = kVersion;
+    header.entrySize = sizeof(IndexEntry);
+    bool ok = writeAll(fd, &header, sizeof(header));
+    for (size_t b = 0; ok && b < capture.blockCount(); ++b) {
+        ok = writeAll(fd, &capture.block(b), sizeof(IndexEntry));
+    }
+    ::close(fd);
+    if (!ok) {
+        error = index + ": " + strerror(errno);
+        return false;
+    }
+    error = capture.error();  // 손상된 꼬리가 있으면 경고로 전달
+    return true;
+}
+
+}  // namespace capture
@@ -0,0 +1,314 @@
+#ifndef CAPTUREFILE_H
+#define CAPTUREFILE_H
+
+#include "CANId.h"
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 수신 트래픽 캡처 파일 (.vscap) - 추가 전용, 블록 구조
+// 데이터: [FileHeader][버스 이름 테이블][블록...], 블록 = [BlockHeader][레코드...]
+//         레코드 = [RecordHeader][페이로드 length바이트] (정렬 없이 연속 배치)
+// 인덱스: <경로>.idx = [IndexHeader][IndexEntry...] (블록마다 고정 크기 항목 하나)
+// 인덱스 항목에 블록의 시간 범위와 CAN ID 비트맵이 있으므로, 시간 / ID 질의는 인덱스를 이분 탐색하고
+// 해당하는 블록의 페이지만 읽는다. 두 파일 모두 mmap으로 열기 때문에 열기 비용은 파일 크기와 무관하다.
+// 정수는 모두 리틀 엔디언 (x86 / ARM 리눅스 그대로 기록)
+namespace capture {
+
+enum class RecordKind : uint8_t {
+    CAN,
+    CANFD,
+    NMEA
+};
+
+// RecordHeader::flags
+constexpr uint8_t kFlagBRS = 0x01;  // CAN FD bit rate switch
+constexpr uint8_t kFlagESI = 0x02;  // CAN FD error state indicator
+
+constexpr char kMagic[8] = {'V', 'S', 'C', 'A', 'P', '\0', '\0', '\2'};
+constexpr char kIndexMagic[8] = {'V', 'S', 'I', 'D', 'X', '\0', '\0', '\2'};
+constexpr uint32_t kVersion = 2;
+constexpr uint32_t kBlockMagic = 0x4B4C4256;  // "VBLK"
+constexpr size_t kBusNameLength = 16;  // IFNAMSIZ
+constexpr size_t kMaxPayload = 80;     // CAN FD 64바이트, NMEA 문장 80자 (CR/LF 제외)
+constexpr size_t kBlockBytes = 64 * 1024;          // 블록 레코드 영역 목표 크기
+constexpr int64_t kMaxBlockAgeNs = 1000000000LL;   // 트래픽이 적어도 1초마다 블록을 닫음
+// 기록기는 탭별 구간을 병합해 쓰므로 블록 사이 시각 역전은 드레인 주기 수준. 질의는 이만큼 더 살펴본다.
+constexpr int64_t kMaxReorderNs = 1000000000LL;
+constexpr size_t kIdBitmapWords = 8;               // 512비트 ID 비트맵
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t busCount;  // 뒤따르는 버스 이름 수 (kBusNameLength바이트씩, 널 패딩)
+};
+
+struct RecordHeader {
+    int64_t timestampNs;  // 수신 시각 (CLOCK_REALTIME)
+    uint32_t id;          // CAN ID (EFF/RTR 플래그 포함, NMEA는 0)
+    RecordKind kind;
+    uint8_t bus;          // 버스 이름 테이블 인덱스 (NMEA는 0)
+    uint8_t flags;
+    uint8_t length;       // 페이로드 바이트 수
+};
+
+struct BlockHeader {
+    uint32_t magic;          // kBlockMagic (인덱스 복구 시 확인)
+    uint32_t recordCount;
+    uint32_t payloadBytes;   // 뒤따르는 레코드 영역 바이트 수
+    uint32_t reserved;
+    int64_t firstTimestampNs;  // 블록 내 최소 시각
+    int64_t lastTimestampNs;   // 블록 내 최대 시각
+    uint64_t idBits[kIdBitmapWords];  // 블록에 있는 ID의 해시 비트 (false positive만 있음)
+};
+
+struct IndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entrySize;  // sizeof(IndexEntry)
+};
+
+struct IndexEntry {
+    uint64_t offset;         // 데이터 파일 내 BlockHeader 위치
+    int64_t maxTimestampNs;  // 이 블록까지의 최대 시각 (단조 증가, 이분 탐색용)
+    BlockHeader block;
+};
+
+static_assert(sizeof(FileHeader) == 16, "FileHeader는 디스크 형식");
+static_assert(sizeof(RecordHeader) == 16, "RecordHeader는 디스크 형식");
+static_assert(sizeof(BlockHeader) == 96, "BlockHeader는 디스크 형식");
+static_assert(sizeof(IndexHeader) == 16, "IndexHeader는 디스크 형식");
+static_assert(sizeof(IndexEntry) == 112, "IndexEntry는 디스크 형식");
+
+inline size_t idBit(uint32_t id) {
+    return (id * 0x9E3779B1u) >> (32 - 9);  // 피보나치 해시 상위 9비트 (0 ~ 511)
+}
+
+inline bool mayContainId(const BlockHeader& block, uint32_t id) {
+    size_t bit = idBit(id);
+    return (block.idBits[bit / 64] >> (bit % 64)) & 1;
+}
+
+// 메모리 상의 고정 크기 레코드 (링 / 재생 버퍼용)
+struct Record {
+    RecordHeader header;
+    uint8_t payload[kMaxPayload];
+
+    std::string_view text() const {
+        return std::string_view(reinterpret_cast<const char*>(payload), header.length);
+    }
+};
+
+std::string indexPath(const std::string& capturePath);
+
+// 블록 단위 추가 기록 (한 스레드 전용)
+// 레코드는 메모리 블록에 모았다가 kBlockBytes가 차거나 flush()에서 kMaxBlockAgeNs가 지나면
+// 데이터 파일에 블록을 쓰고 인덱스에 항목을 추가한다.
+class Writer {
+public:
+    Writer() = default;
+    ~Writer();
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    bool open(const std::string& path, const std::vector<std::string>& busNames);
+    bool close();  // 마지막 블록 기록
+    bool isOpen() const { return dataFd >= 0; }
+
+    bool append(const Record& record);
+    bool flush();  // 열린 블록이 오래되었으면 닫아서 기록
+
+    uint64_t recordsWritten() const { return records; }
+    uint64_t bytesWritten() const { return bytes; }
+    uint64_t blocksWritten() const { return blocks; }
+
+private:
+    bool sealBlock();
+
+    int dataFd{-1};
+    int indexFd{-1};
+    uint64_t dataOffset{0};
+    int64_t maxTimestampNs{std::numeric_limits<int64_t>::min()};
+
+    std::vector<uint8_t> blockBuffer;
+    BlockHeader blockHeader{};
+    int64_t blockOpenedNs{0};  // 블록 첫 레코드 추가 시각 (CLOCK_MONOTONIC)
+
+    uint64_t records{0};
+    uint64_t bytes{0};
+    uint64_t blocks{0};
+};
+
+// 시간 / ID 질의 조건 (시각은 CLOCK_REALTIME ns, 양 끝 포함)
+struct Query {
+    int64_t fromNs{std::numeric_limits<int64_t>::min()};
+    int64_t toNs{std::numeric_limits<int64_t>::max()};
+    bool filterId{false};
+    uint32_t id{0};
+};
+
+// 질의가 실제로 건드린 범위
+struct QueryStats {
+    uint64_t blocksTotal;
+    uint64_t blocksInRange;     // 인덱스 시간 범위로 고른 블록
+    uint64_t blocksSkippedById; // ID 비트맵으로 건너뛴 블록 (데이터 페이지를 읽지 않음)
+    uint64_t blocksScanned;
+    uint64_t bytesScanned;      // 읽은 데이터 영역 바이트
+    uint64_t recordsMatched;
+};
+
+// mmap으로 연 캡처 파일 (읽기 전용)
+// 인덱스가 데이터보다 짧으면(기록 중 종료) 인덱스 이후 블록만 헤더를 따라가며 복구한다.
+class MappedCapture {
+public:
+    MappedCapture() = default;
+    ~MappedCapture();
+
+    MappedCapture(const MappedCapture&) = delete;
+    MappedCapture& operator=(const MappedCapture&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    const std::vector<std::string>& busNames() const { return buses; }
+    const std::string& error() const { return lastError; }
+    size_t blockCount() const { return mappedEntryCount + recoveredEntries.size(); }
+    const IndexEntry& block(size_t index) const {
+        return index < mappedEntryCount ? mappedEntries[index] : recoveredEntries[index - mappedEntryCount];
+    }
+    size_t recoveredBlocks() const { return recoveredEntries.size(); }
+    uint64_t dataSize() const { return dataLength; }
+    const uint8_t* blockRecords(size_t index) const { return data + block(index).offset + sizeof(BlockHeader); }
+
+    // fromNs 이상의 레코드가 있을 수 있는 첫 블록 (maxTimestampNs 이분 탐색)
+    size_t firstBlockFor(int64_t fromNs) const;
+
+    void adviseSequential() const;  // 전체를 순서대로 읽을 때 (재생)
+
+    // 블록 하나의 레코드를 순서대로 visit(const RecordHeader&, const uint8_t* payload)
+    // visit가 false를 반환하면 중단하고 false 반환
+    template <typename Visitor>
+    bool forEachRecord(size_t blockIndex, Visitor&& visit) const {
+        const uint8_t* p = blockRecords(blockIndex);
+        const uint8_t* end = p + block(blockIndex).block.payloadBytes;
+        RecordHeader header;
+        while (p + sizeof(header) <= end) {
+            memcpy(&header, p, sizeof(header));  // 레코드는 정렬되어 있지 않음
+            p += sizeof(header);
+            if (header.length > kMaxPayload || p + header.length > end) {
+                return false;  // 손상된 블록
+            }
+            if (!visit(header, p)) {
+                return false;
+            }
+            p += header.length;
+        }
+        return true;
+    }
+
+    // 조건에 맞는 레코드를 시각 범위 안의 블록에서만 찾아 visit. visit가 false면 중단
+    template <typename Visitor>
+    QueryStats query(const Query& q, Visitor&& visit) const {
+        QueryStats stats{};
+        stats.blocksTotal = blockCount();
+        // 이전 버전은 29비트 ID를 CAN_EFF_FLAG 없이 기록했으므로 두 형태 모두 찾음
+        const uint32_t id = normalizeCANID(q.id);
+        const uint32_t legacyId = id & CAN_EFF_MASK;
+        const bool hasLegacyId = legacyId > CAN_SFF_MASK;
+        bool stopped = false;
+        for (size_t b = firstBlockFor(q.fromNs); b < blockCount() && !stopped; ++b) {
+            const BlockHeader& header = block(b).block;
+            // 블록 사이 역전 허용 범위를 넘어서면 이후 블록은 모두 toNs 이후
+            if (header.firstTimestampNs > q.toNs) {
+                if (header.firstTimestampNs - q.toNs > kMaxReorderNs) {
+                    break;
+                }
+                continue;
+            }
+            if (header.lastTimestampNs < q.fromNs) {
+                continue;
+            }
+            ++stats.blocksInRange;
+            if (q.filterId && !mayContainId(header, id) && !(hasLegacyId && mayContainId(header, legacyId))) {
+                ++stats.blocksSkippedById;
+                continue;
+            }
+            ++stats.blocksScanned;
+            stats.bytesScanned += header.payloadBytes;
+            forEachRecord(b, [&](const RecordHeader& record, const uint8_t* payload) {
+                if (record.timestampNs < q.fromNs || record.timestampNs > q.toNs ||
+                    (q.filterId && normalizeCANID(record.id) != id)) {
+                    return true;
+                }
+                ++stats.recordsMatched;
+                if (!visit(record, payload)) {
+                    stopped = true;
+                    return false;
+                }
+                return true;
+            });
+        }
+        return stats;
+    }
+
+private:
+    bool recoverTail(uint64_t fromOffset, int64_t maxTimestamp);
+
+    int dataFd{-1};
+    const uint8_t* data{nullptr};
+    uint64_t dataLength{0};
+    int indexFd{-1};
+    const uint8_t* indexMap{nullptr};
+    uint64_t indexLength{0};
+    const IndexEntry* mappedEntries{nullptr};
+    size_t mappedEntryCount{0};
+    std::vector<IndexEntry> recoveredEntries;  // 인덱스에 없는 꼬리 블록
+    std::vector<std::string> buses;
+    std::string lastError;
+};
+
+// 순차 읽기 (재생용, MappedCapture 위의 커서)
+class Reader {
+public:
+    bool open(const std::string& path);
+    void close() { capture.close(); }
+
+    const std::vector<std::string>& busNames() const { return capture.busNames(); }
+    bool next(Record& record);  // 파일 끝 / 손상된 블록에서 false
+    const std::string& error() const { return lastError.empty() ? capture.error() : lastError; }
+
+private:
+    MappedCapture capture;
+    size_t blockIndex{0};
+    uint64_t blockPosition{0};  // 블록 레코드 영역 내 위치
+    std::string lastError;
+};
+
+// candump -l 형식 한 줄: "(1436509052.249713) vcan0 123#11223344" / "vcan0 123##1AABB" (FD) / "123#R" (RTR)
+// 성공 시 record와 인터페이스 이름을 채움 (bus는 호출자가 지정)
+bool parseCandumpLine(std::string_view line, Record& record, std::string_view& interfaceName);
+// parseCandumpLine의 역 (NMEA는 "(시각) <버스 이름> $GP..." 형식). 널 종료, 길이 반환
+size_t formatCandumpLine(const RecordHeader& header, const uint8_t* payload, std::string_view busName,
+                         char* out, size_t capacity);
+
+struct ImportResult {
+    uint64_t linesRead;
+    uint64_t recordsWritten;
+    uint64_t linesSkipped;  // 형식이 맞지 않는 줄
+    std::vector<std::string> busNames;  // 등장 순서대로 버스 인덱스 부여
+};
+
+// candump .log 텍스트를 캡처 파일로 변환
+bool importCandump(const std::string& logPath, const std::string& capturePath, ImportResult& result);
+
+// 데이터 파일의 블록 헤더를 따라가며 인덱스 파일을 다시 만듦 (인덱스 유실 / 손상 시)
+bool rebuildIndex(const std::string& capturePath, std::string& error);
+
+}  // namespace capture
+
+#endif // CAPTUREFILE_H
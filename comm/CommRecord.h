@@ -0,0 +1,32 @@
+#ifndef COMMRECORD_H
+#define COMMRECORD_H
+
+#include <cstdint>
+
+// 통신 스레드 -> UI로 전달하는 고정 크기 수신 레코드
+// 문자열 포맷팅은 UI 스레드에서 화면에 보이는 행에 대해서만 수행한다.
+enum class RecordChannel : uint8_t {
+    CAN,
+    CANFD,
+    RS232
+};
+
+struct CommRecord {
+    static constexpr int kMaxText = 80;  // NMEA 문장 최대 길이 (CR/LF 제외)
+
+    int64_t timestampNs;    // 수신 시각 (CLOCK_REALTIME)
+    uint32_t id;            // CAN ID (RS232는 0)
+    RecordChannel channel;
+    uint8_t length;         // text 길이 (RS232)
+    uint8_t sampleIndex;    // FD 프레임 내 샘플 위치
+    uint8_t sampleCount;    // FD 프레임 내 샘플 수
+    uint8_t bus;            // CAN 버스 인덱스 (CANBusGroup 순서, RS232는 0)
+    union {
+        float values[3];    // CAN: 디코딩된 물리값
+        char text[kMaxText];  // RS232: 수신한 NMEA 문장 (널 종료 없음)
+    };
+};
+
+static_assert(sizeof(CommRecord) == 104, "CommRecord 크기 변경 시 링/히스토리 용량 재검토");
+
+#endif // COMMRECORD_H
@@ -0,0 +1,322 @@
+#include "EventReactor.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace {
+
+struct timespec toTimespec(int64_t ns) {
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1000000000LL);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000LL);
+    return ts;
+}
+
+// epoll_event.data: 상위 32비트 = 등록 세대, 하위 32비트 = fd
+// (핸들러 제거 후 같은 번호로 재사용된 fd에 이전 이벤트가 전달되지 않도록)
+uint64_t packToken(int fd, uint32_t generation) {
+    return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(fd);
+}
+
+}  // namespace
+
+TimerFd::~TimerFd() {
+    close();
+}
+
+bool TimerFd::open() {
+    close();
+    fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    return fd >= 0;
+}
+
+void TimerFd::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+bool TimerFd::setAbsolute(int64_t firstNs, int64_t intervalNs) {
+    struct itimerspec spec;
+    spec.it_value = toTimespec(std::max<int64_t>(firstNs, 1));  // 0은 타이머 해제
+    spec.it_interval = toTimespec(intervalNs);
+    return timerfd_settime(fd, TFD_TIMER_ABSTIME, &spec, nullptr) == 0;
+}
+
+bool TimerFd::setRelative(int64_t delayNs, int64_t intervalNs) {
+    struct itimerspec spec;
+    spec.it_value = toTimespec(std::max<int64_t>(delayNs, 1));
+    spec.it_interval = toTimespec(intervalNs);
+    return timerfd_settime(fd, 0, &spec, nullptr) == 0;
+}
+
+bool TimerFd::disarm() {
+    struct itimerspec spec = {};
+    return timerfd_settime(fd, 0, &spec, nullptr) == 0;
+}
+
+uint64_t TimerFd::readExpirations() {
+    uint64_t expirations = 0;
+    if (::read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+        return 0;  // EAGAIN: 아직 만료되지 않음
+    }
+    return expirations;
+}
+
+CancelEvent::~CancelEvent() {
+    close();
+}
+
+bool CancelEvent::open() {
+    close();
+    fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return fd >= 0;
+}
+
+void CancelEvent::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+void CancelEvent::signal() {
+    uint64_t one = 1;
+    ssize_t ret = ::write(fd, &one, sizeof(one));
+    (void)ret;  // 카운터가 가득 찬 경우(EAGAIN)에도 이미 신호 상태
+}
+
+bool CancelEvent::isSignaled() const {
+    struct pollfd pfd = {fd, POLLIN, 0};
+    return poll(&pfd, 1, 0) > 0;
+}
+
+bool CancelEvent::waitUntil(int64_t deadlineNs) const {
+    // 카운터는 읽지 않으므로 한 번 신호를 받으면 이후 대기는 모두 바로 반환
+    struct pollfd pfd = {fd, POLLIN, 0};
+    for (;;) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        int64_t remainingNs = deadlineNs - (static_cast<int64_t>(now.tv_sec) * 1000000000LL + now.tv_nsec);
+        if (remainingNs <= 0) {
+            return !isSignaled();
+        }
+        struct timespec timeout = toTimespec(remainingNs);
+        int ready = ppoll(&pfd, 1, &timeout, nullptr);
+        if (ready > 0) {
+            return false;
+        }
+        if (ready < 0 && errno != EINTR) {
+            return !isSignaled();
+        }
+    }
+}
+
+EventReactor::EventReactor(std::string name) : reactorName(std::move(name)) {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        std::cerr << "[오류] epoll 생성 실패: " << strerror(errno) << std::endl;
+        throw std::runtime_error("epoll 생성 실패");
+    }
+
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        std::cerr << "[오류] eventfd 생성 실패: " << strerror(errno) << std::endl;
+        ::close(epollFd);
+        throw std::runtime_error("eventfd 생성 실패");
+    }
+
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = packToken(wakeFd, 0);
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+}
+
+EventReactor::~EventReactor() {
+    stop();
+    ::close(wakeFd);
+    ::close(epollFd);
+}
+
+void EventReactor::start(int cpu) {
+    if (loopThread.joinable()) {
+        return;
+    }
+    stopRequested = false;
+    loopThread = std::thread(&EventReactor::loop, this);
+
+    pthread_setname_np(loopThread.native_handle(), reactorName.substr(0, 15).c_str());
+    if (cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        if (pthread_setaffinity_np(loopThread.native_handle(), sizeof(cpus), &cpus) != 0) {
+            std::cerr << "[경고] " << reactorName << " 코어 " << cpu << " 고정 실패" << std::endl;
+        }
+    }
+}
+
+void EventReactor::stop() {
+    if (!loopThread.joinable()) {
+        return;
+    }
+    stopRequested = true;
+    wake();
+    loopThread.join();
+}
+
+bool EventReactor::add(int fd, uint32_t events, Handler handler) {
+    uint32_t generation = nextGeneration++;
+    struct epoll_event event = {};
+    event.events = events;
+    event.data.u64 = packToken(fd, generation);
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        return false;
+    }
+    handlers[fd] = Registration{std::move(handler), generation};
+    registeredCount.store(handlers.size(), std::memory_order_relaxed);
+    return true;
+}
+
+bool EventReactor::modify(int fd, uint32_t events) {
+    auto it = handlers.find(fd);
+    if (it == handlers.end()) {
+        return false;
+    }
+    struct epoll_event event = {};
+    event.events = events;
+    event.data.u64 = packToken(fd, it->second.generation);
+    return epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+void EventReactor::remove(int fd) {
+    auto it = handlers.find(fd);
+    if (it == handlers.end()) {
+        return;
+    }
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    // 자기 자신을 제거하는 핸들러가 실행 중일 수 있으므로 해제는 이번 반복이 끝난 뒤에
+    retiredHandlers.push_back(std::move(it->second.handler));
+    handlers.erase(it);
+    registeredCount.store(handlers.size(), std::memory_order_relaxed);
+}
+
+void EventReactor::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        pendingTasks.push_back(std::move(task));
+    }
+    wake();
+}
+
+void EventReactor::runSync(const std::function<void()>& task) {
+    if (isLoopThread() || !loopThread.joinable()) {
+        task();
+        return;
+    }
+
+    std::promise<void> done;
+    std::future<void> finished = done.get_future();
+    post([&task, &done] {
+        task();
+        done.set_value();
+    });
+    finished.wait();
+}
+
+void EventReactor::wake() {
+    uint64_t one = 1;
+    ssize_t ret = ::write(wakeFd, &one, sizeof(one));
+    (void)ret;  // 카운터가 가득 찬 경우(EAGAIN)에도 이미 깨어날 예정
+}
+
+void EventReactor::runPendingTasks() {
+    uint64_t counter;
+    ssize_t ret = ::read(wakeFd, &counter, sizeof(counter));
+    (void)ret;
+
+    {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        runningTasks.swap(pendingTasks);
+    }
+    for (auto& task : runningTasks) {
+        task();
+    }
+    runningTasks.clear();
+}
+
+void EventReactor::loop() {
+    loopThreadId.store(std::this_thread::get_id());
+    struct epoll_event events[kMaxEventsPerWait];
+
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        int count = epoll_wait(epollFd, events, kMaxEventsPerWait, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "[오류] epoll_wait 실패: " << strerror(errno) << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int fd = static_cast<int>(events[i].data.u64 & 0xFFFFFFFFu);
+            uint32_t generation = static_cast<uint32_t>(events[i].data.u64 >> 32);
+            if (fd == wakeFd) {
+                runPendingTasks();
+                continue;
+            }
+
+            // 같은 배치 안에서 먼저 실행된 핸들러가 제거 / 재등록했을 수 있음
+            auto it = handlers.find(fd);
+            if (it == handlers.end() || it->second.generation != generation) {
+                continue;
+            }
+            it->second.handler(events[i].events);
+        }
+        retiredHandlers.clear();
+    }
+
+    // 종료 직전에 들어온 작업 (runSync 대기자가 멈추지 않도록)
+    runPendingTasks();
+    retiredHandlers.clear();
+    loopThreadId.store(std::thread::id());
+}
+
+ReactorPool& ReactorPool::instance() {
+    static ReactorPool pool;
+    return pool;
+}
+
+ReactorPool::ReactorPool() {
+    size_t count = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), kDefaultMaxReactors);
+    if (const char* value = std::getenv("VSENSOR_REACTOR_THREADS")) {
+        count = static_cast<size_t>(std::max(1, atoi(value)));
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        reactors.push_back(std::make_unique<EventReactor>("vsensor-io-" + std::to_string(i)));
+        reactors.back()->start();
+    }
+}
+
+ReactorPool::~ReactorPool() {
+    for (auto& reactor : reactors) {
+        reactor->stop();
+    }
+}
+
+EventReactor& ReactorPool::next() {
+    return *reactors[nextIndex.fetch_add(1, std::memory_order_relaxed) % reactors.size()];
+}
@@ -0,0 +1,140 @@
+#ifndef EVENTREACTOR_H
+#define EVENTREACTOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// timerfd 래퍼 (CLOCK_MONOTONIC, 논블로킹)
+class TimerFd {
+public:
+    TimerFd() = default;
+    ~TimerFd();
+
+    TimerFd(const TimerFd&) = delete;
+    TimerFd& operator=(const TimerFd&) = delete;
+
+    bool open();
+    void close();
+    bool isOpen() const { return fd >= 0; }
+    int nativeHandle() const { return fd; }
+
+    // firstNs: CLOCK_MONOTONIC 절대 시각, intervalNs: 0이면 1회성
+    bool setAbsolute(int64_t firstNs, int64_t intervalNs);
+    bool setRelative(int64_t delayNs, int64_t intervalNs);
+    bool disarm();
+    uint64_t readExpirations();  // 마지막 읽기 이후 만료 횟수 (없으면 0)
+
+private:
+    int fd{-1};
+};
+
+// eventfd 기반 중단 신호 (전용 스레드의 대기를 다른 스레드에서 즉시 깨움)
+// 시간 단위로 나눠 플래그를 확인하지 않으므로 중단 요청 후 깨어나기까지 지연이 없다.
+class CancelEvent {
+public:
+    CancelEvent() = default;
+    ~CancelEvent();
+
+    CancelEvent(const CancelEvent&) = delete;
+    CancelEvent& operator=(const CancelEvent&) = delete;
+
+    bool open();  // 신호 없는 상태로 (다시) 생성
+    void close();
+    int nativeHandle() const { return fd; }
+
+    void signal();  // 어느 스레드에서나 호출 가능
+    bool isSignaled() const;
+    // deadlineNs(CLOCK_MONOTONIC 절대 시각)까지 대기. 그 전에 신호를 받으면 false
+    bool waitUntil(int64_t deadlineNs) const;
+
+private:
+    int fd{-1};
+};
+
+// epoll 기반 이벤트 루프 (반응기 스레드 하나)
+// 채널은 fd / timerfd를 핸들러와 함께 등록하고, 핸들러는 모두 반응기 스레드에서 실행된다.
+// 핸들러는 블로킹하면 안 된다 (같은 반응기의 다른 채널이 멈춤).
+// add / modify / remove는 반응기 스레드(핸들러 또는 runSync 안)에서만 호출한다.
+class EventReactor {
+public:
+    using Handler = std::function<void(uint32_t events)>;
+
+    explicit EventReactor(std::string name = "vsensor-io");
+    ~EventReactor();
+
+    EventReactor(const EventReactor&) = delete;
+    EventReactor& operator=(const EventReactor&) = delete;
+
+    void start(int cpu = -1);  // cpu >= 0이면 해당 코어에 고정
+    void stop();
+    bool isLoopThread() const { return std::this_thread::get_id() == loopThreadId.load(); }
+
+    bool add(int fd, uint32_t events, Handler handler);
+    bool modify(int fd, uint32_t events);
+    void remove(int fd);  // 반환 후에는 해당 fd 핸들러가 다시 호출되지 않음
+
+    // 어느 스레드에서나 호출 가능. 반응기 스레드에서 실행된다.
+    void post(std::function<void()> task);
+    // 반응기 스레드에서 실행하고 끝날 때까지 대기 (반응기 스레드에서 호출하면 바로 실행)
+    void runSync(const std::function<void()>& task);
+
+    const std::string& name() const { return reactorName; }
+    size_t handlerCount() const { return registeredCount.load(std::memory_order_relaxed); }
+
+    static constexpr int kMaxEventsPerWait = 64;
+
+private:
+    struct Registration {
+        Handler handler;
+        uint32_t generation;
+    };
+
+    void loop();
+    void runPendingTasks();
+    void wake();
+
+    std::string reactorName;
+    int epollFd{-1};
+    int wakeFd{-1};  // eventfd: post() / stop() 알림
+
+    std::unordered_map<int, Registration> handlers;  // 반응기 스레드 전용
+    std::vector<Handler> retiredHandlers;  // 실행 중에 제거된 핸들러 (반복 끝에서 해제)
+    uint32_t nextGeneration{1};
+    std::atomic<size_t> registeredCount{0};
+
+    std::mutex taskMutex;
+    std::vector<std::function<void()>> pendingTasks;
+    std::vector<std::function<void()>> runningTasks;  // 반응기 스레드 전용 (재사용)
+
+    std::atomic<bool> stopRequested{false};
+    std::atomic<std::thread::id> loopThreadId{};
+    std::thread loopThread;
+};
+
+// 채널들이 공유하는 반응기 묶음 (채널은 순서대로 배정)
+// 반응기 수: 환경 변수 VSENSOR_REACTOR_THREADS, 없으면 min(코어 수, kDefaultMaxReactors)
+class ReactorPool {
+public:
+    static ReactorPool& instance();
+
+    EventReactor& next();
+    size_t size() const { return reactors.size(); }
+
+    static constexpr size_t kDefaultMaxReactors = 4;
+
+private:
+    ReactorPool();
+    ~ReactorPool();
+
+    std::vector<std::unique_ptr<EventReactor>> reactors;
+    std::atomic<size_t> nextIndex{0};
+};
+
+#endif // EVENTREACTOR_H
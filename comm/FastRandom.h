@@ -0,0 +1,55 @@
+#ifndef FASTRANDOM_H
+#define FASTRANDOM_H
+
+#include <cstdint>
+
+// xoshiro256** 의사 난수 생성기 (시드가 같으면 항상 같은 수열)
+// NMEA 생성, IMU 신호 합성, 메시지 일정 지터가 함께 쓰므로 호출 지점에서 인라인되도록 헤더에 둔다.
+class FastRandom {
+public:
+    explicit FastRandom(uint64_t seed = 0) { reseed(seed); }
+
+    void reseed(uint64_t seed) {
+        // 시드 하나로 256비트 상태를 채움 (상태가 전부 0이 되지 않음)
+        for (uint64_t& word : state) {
+            word = splitmix64(seed);
+        }
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+
+        return result;
+    }
+
+    // [minValue, maxValue] 범위의 정수 (곱셈-시프트 방식, 나눗셈 없음)
+    int64_t uniform(int64_t minValue, int64_t maxValue) {
+        uint64_t range = static_cast<uint64_t>(maxValue - minValue) + 1;
+        return minValue + static_cast<int64_t>(
+            static_cast<uint64_t>((static_cast<unsigned __int128>(next()) * range) >> 64));
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t state[4];
+};
+
+#endif // FASTRANDOM_H
@@ -1,39 +1,157 @@
 #ifndef HARDWARECOMMUNICATION_H
 #define HARDWARECOMMUNICATION_H
 
+#include "EventReactor.h"
+#include "TrafficRecorder.h"
 #include <thread>
 #include <atomic>
 #include <iostream>
 #include <mutex>
 #include <chrono>
+#include <functional>
 
+// startAsync / stopAsync 완료 보고
+struct ChannelTransition {
+    bool connected;     // 완료 후 연결 상태 (시작 실패 시 false)
+    int64_t elapsedNs;  // 요청부터 반응기 스레드에서 등록 / 해제가 끝날 때까지
+};
+using TransitionCallback = std::function<void(const ChannelTransition&)>;
+
+// 통신 채널 공통 인터페이스
+// 채널은 스레드를 직접 만들지 않고 EventReactor에 fd / 타이머 핸들러를 등록한다.
+// 파생 클래스 소멸자에서 stop()을 호출해야 한다 (detach()가 파생 클래스 멤버를 사용하므로).
 class HardwareCommunication {
 public:
-    virtual ~HardwareCommunication() { stop(); }
+    virtual ~HardwareCommunication() = default;
 
     void start() {
         if (!connected) {
+            assignReactor();
             connected = true;
-            communicationThread = std::thread(&HardwareCommunication::run, this);
+            uint64_t serial = ++transitionSerial;
+
+            // 등록은 반응기 스레드에서 (핸들러와 같은 스레드에서 상태를 초기화)
+            reactor->runSync([this, serial] { attachOnReactor(serial); });
         }
     }
 
     void stop() {
         if (connected) {
             connected = false;
-            if (communicationThread.joinable()) {
-                communicationThread.join();
+            ++transitionSerial;
+            reactor->runSync([this] { detach(); });
+        } else if (pendingTransitions > 0) {
+            reactor->runSync([] {});  // 앞선 stopAsync가 반응기 스레드에서 끝날 때까지 (소멸 전 대기)
+        }
+    }
+
+    // 호출 스레드를 막지 않는 시작 / 정지 (UI 스레드, 자동화 스크립트용)
+    // 등록 / 해제는 반응기 스레드에서 요청 순서대로 실행되므로 완료를 기다리지 않고 연달아 호출해도 된다.
+    // 정지는 connected를 바로 내리므로 반환 즉시 새 송신이 멈춘다.
+    // 완료 보고는 반응기 스레드에서 done과 onTransitionFinished()로 전달된다 (블로킹 금지).
+    void startAsync(TransitionCallback done = nullptr) {
+        int64_t requestNs = steadyNs();
+        assignReactor();
+        ++pendingTransitions;
+        if (connected) {
+            reactor->post([this, done, requestNs] { reportTransition(done, requestNs, true); });
+            return;
+        }
+        connected = true;
+        uint64_t serial = ++transitionSerial;
+        reactor->post([this, done, requestNs, serial] {
+            reportTransition(done, requestNs, attachOnReactor(serial));
+        });
+    }
+
+    void stopAsync(TransitionCallback done = nullptr) {
+        int64_t requestNs = steadyNs();
+        if (reactor == nullptr) {
+            if (done) {
+                done({false, 0});  // 한 번도 시작하지 않은 채널
             }
+            return;
+        }
+        ++pendingTransitions;
+        if (!connected) {
+            reactor->post([this, done, requestNs] { reportTransition(done, requestNs, false); });
+            return;
         }
+        connected = false;
+        ++transitionSerial;
+        reactor->post([this, done, requestNs] {
+            detach();
+            reportTransition(done, requestNs, false);
+        });
     }
 
+    // startAsync / stopAsync 요청 중 반응기 스레드에서 아직 끝나지 않은 것이 있는지
+    bool isTransitioning() const { return pendingTransitions.load() > 0; }
+
     bool isConnected() const { return connected; }
 
+    // 사용할 반응기 지정 (start() 전에 호출, 지정하지 않으면 ReactorPool에서 순서대로 배정)
+    void setReactor(EventReactor* eventReactor) {
+        if (!connected && !isTransitioning()) {
+            reactor = eventReactor;
+        }
+    }
+
+    // 수신 경로를 기록기에 연결 (nullptr: 해제). 반응기 스레드에서 바꾸므로 반환 후에는 이전 탭을 쓰지 않음
+    void setRecorder(TrafficRecorder* recorder, uint8_t bus = 0) {
+        RecorderTap* tap = recorder ? recorder->createTap(bus) : nullptr;
+        if (reactor) {
+            reactor->runSync([this, tap] { recorderTap = tap; });
+        } else {
+            recorderTap = tap;
+        }
+    }
+
 protected:
     std::atomic<bool> connected{false};
-    std::thread communicationThread;
+    std::atomic<uint64_t> transitionSerial{0};  // 시작 / 정지 요청 번호 (마지막 요청이 연결 상태를 결정)
+    std::atomic<int> pendingTransitions{0};
+    EventReactor* reactor{nullptr};
+    RecorderTap* recorderTap{nullptr};  // 반응기 스레드에서만 읽음
+
+    // 반응기 스레드에서 호출: 소켓 / 포트 열기, 핸들러 등록 (실패 시 false)
+    virtual bool attach(EventReactor& eventReactor) = 0;
+    // 반응기 스레드에서 호출: 핸들러 제거, 소켓 / 포트 닫기
+    virtual void detach() = 0;
+    // 반응기 스레드에서 호출: startAsync / stopAsync 완료 (파생 클래스가 시그널로 전달)
+    virtual void onTransitionFinished(const ChannelTransition&) {}
+
+private:
+    void assignReactor() {
+        if (reactor == nullptr) {
+            reactor = &ReactorPool::instance().next();
+        }
+    }
+
+    bool attachOnReactor(uint64_t serial) {
+        if (attach(*reactor)) {
+            return true;
+        }
+        // 실패 후에 들어온 시작 / 정지 요청이 있으면 그 요청이 상태를 정함
+        if (transitionSerial.load() == serial) {
+            connected = false;
+        }
+        return false;
+    }
 
-    virtual void run() = 0;
+    void reportTransition(const TransitionCallback& done, int64_t requestNs, bool isConnected) {
+        ChannelTransition result{isConnected, steadyNs() - requestNs};
+        onTransitionFinished(result);
+        if (done) {
+            done(result);
+        }
+        --pendingTransitions;  // 보고까지 끝난 뒤에 내려야 stop()이 소멸 전에 기다림
+    }
+
+    static int64_t steadyNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
 };
 
 #endif // HARDWARECOMMUNICATION_H
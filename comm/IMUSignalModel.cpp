@@ -0,0 +1,523 @@
+#include "IMUSignalModel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+// 커널은 원소별 곱셈 / 덧셈만 쓰므로 (빌드는 -ffp-contract=off) 묶음 폭(1 / 4 / 8)과 무관하게
+// 레인마다 같은 연산 순서가 되어 스칼라 / SSE2 / AVX2 결과가 비트 단위로 같다.
+
+namespace {
+
+using can_codec::MotionKind;
+
+constexpr size_t kAxes = 3;
+constexpr size_t kMaxLaneWidth = 8;  // AVX2 float 8개, 레인 배열은 이 배수로 맞춤
+constexpr double kPi = 3.14159265358979323846;
+constexpr float kGravity = 9.80665f;
+
+// Irwin-Hall(16비트 균등 분포 4개의 합)을 평균 0, 분산 1로: 합 * 2 - 4 * 65535의 표준편차는 65536 * 2 / sqrt(3)
+constexpr float kGaussScale = 0.8660254037844386f / 65536.0f;
+
+// 형식별 센서 특성 (소비자급 MEMS IMU 수준)
+struct NoiseModel {
+    float whiteSigma;         // 샘플마다 더하는 가우시안 잡음 표준편차
+    float walkSigmaPerRootS;  // 랜덤 워크 (바이어스 불안정성), 1초당 표준편차
+    float biasRange;          // 고정 바이어스 ±범위
+};
+
+constexpr NoiseModel noiseModel(MotionKind kind) {
+    switch (kind) {
+    case MotionKind::Attitude:
+        return {0.05f, 0.01f, 0.2f};     // deg
+    case MotionKind::Accel:
+        return {0.02f, 0.002f, 0.05f};   // m/s^2
+    default:
+        return {0.1f, 0.005f, 0.3f};     // deg/s
+    }
+}
+
+// 센서 운동의 진폭 범위 / 주기 범위 (s): 롤, 피치, 요 (deg), 상하 (m/s^2)
+constexpr double kAmplitudeRange[4][2] = {{2.0, 15.0}, {1.0, 8.0}, {10.0, 45.0}, {0.2, 1.5}};
+constexpr double kPeriodRange[4][2] = {{4.0, 12.0}, {5.0, 15.0}, {20.0, 60.0}, {2.0, 8.0}};
+
+// 형식별 필드의 운동 성분 최댓값 (절댓값)
+constexpr double motionPeak(MotionKind kind, int field) {
+    switch (kind) {
+    case MotionKind::Attitude:
+        return kAmplitudeRange[field][1];
+    case MotionKind::Gyro:
+        return kAmplitudeRange[field][1] * 2.0 * kPi / kPeriodRange[field][0];
+    case MotionKind::Accel:
+        return field < 2 ? kGravity : kGravity + kAmplitudeRange[3][1];
+    default:
+        return 0.0;
+    }
+}
+
+// 합성 값이 신호 범위 안에 있어야 수신 측에서 그대로 복원된다 (범위 밖은 encode()에서 잘림).
+// 운동 최댓값 + 바이어스 + 백색 잡음 8σ + 24시간 랜덤 워크 4σ(sqrt(86400) ~ 294)까지 확인
+constexpr bool fitsSignalRanges() {
+    for (const can_codec::MessageDesc& msg : can_codec::kMessages) {
+        if (msg.motion == MotionKind::None) {
+            continue;
+        }
+        const NoiseModel noise = noiseModel(msg.motion);
+        for (int f = 0; f < msg.fieldCount; ++f) {
+            double envelope = motionPeak(msg.motion, f) + noise.biasRange + 8.0 * noise.whiteSigma +
+                              4.0 * 294.0 * noise.walkSigmaPerRootS;
+            if (envelope > msg.fields[f].maxValue || -envelope < msg.fields[f].minValue) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(fitsSignalRanges(), "IMU 운동 / 잡음 모델이 kMessages 신호 범위를 벗어남");
+
+// 센서 / 스트림마다 독립적인 난수열 시드 (FastRandom이 splitmix64로 섞음)
+uint64_t deriveSeed(uint64_t seed, uint64_t index, uint64_t salt) {
+    return seed ^ (index * 0x9E3779B97F4A7C15ull) ^ (salt * 0xD1B54A32D192ED03ull);
+}
+
+double unitRandom(FastRandom& random) {
+    return static_cast<double>(random.next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double uniformRandom(FastRandom& random, double minValue, double maxValue) {
+    return minValue + (maxValue - minValue) * unitRandom(random);
+}
+
+// 센서 하나의 운동: 축마다 정현파 (롤 / 피치 / 요 각도 deg, 상하 가속도 m/s^2)
+struct SensorMotion {
+    double amplitude[4];
+    double omega[4];  // rad/s
+    double phase[4];
+};
+
+SensorMotion sensorMotion(uint64_t seed, uint32_t sensor) {
+    FastRandom random(deriveSeed(seed, sensor, 1));
+    SensorMotion motion;
+    for (int axis = 0; axis < 4; ++axis) {
+        motion.amplitude[axis] = uniformRandom(random, kAmplitudeRange[axis][0], kAmplitudeRange[axis][1]);
+        motion.omega[axis] = 2.0 * kPi / uniformRandom(random, kPeriodRange[axis][0], kPeriodRange[axis][1]);
+        motion.phase[axis] = uniformRandom(random, 0.0, 2.0 * kPi);
+    }
+    return motion;
+}
+
+// ---------------------------------------------------------------- 합성 커널
+
+// 도우미는 벡터를 참조로만 주고받는다 (값으로 넘기면 AVX 없는 기본 대상에서 ABI 경고)
+
+template <int W>
+struct Lanes {
+    typedef float F __attribute__((vector_size(W * sizeof(float))));
+    typedef uint32_t U __attribute__((vector_size(W * sizeof(uint32_t))));
+    typedef int32_t I __attribute__((vector_size(W * sizeof(int32_t))));
+};
+
+template <typename V, typename T>
+inline __attribute__((always_inline)) void loadLanes(V& value, const T* source) {
+    memcpy(&value, source, sizeof(value));
+}
+
+template <typename V, typename T>
+inline __attribute__((always_inline)) void storeLanes(T* target, const V& value) {
+    memcpy(target, &value, sizeof(value));
+}
+
+// xoshiro128** (SSE2에 32비트 곱셈이 없으므로 x5 / x9는 시프트와 덧셈으로)
+template <typename U>
+inline __attribute__((always_inline)) void nextRandom(U (&state)[4], U& result) {
+    U scaled = state[1] + (state[1] << 2);
+    U rotated = (scaled << 7) | (scaled >> 25);
+    result = rotated + (rotated << 3);
+    U t = state[1] << 9;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = (state[3] << 11) | (state[3] >> 21);
+}
+
+template <int W>
+inline __attribute__((always_inline)) void nextGaussian(typename Lanes<W>::U (&state)[4], typename Lanes<W>::F& out) {
+    typedef typename Lanes<W>::U U;
+    typedef typename Lanes<W>::I I;
+    typedef typename Lanes<W>::F F;
+    U x, y;
+    nextRandom(state, x);
+    nextRandom(state, y);
+    U sum = (x & 0xFFFFu) + (x >> 16) + (y & 0xFFFFu) + (y >> 16);
+    I centered = (I)sum * 2 - 4 * 65535;
+    out = __builtin_convertvector(centered, F) * kGaussScale;
+}
+
+// 묶음 상태 (레인별 배열, 길이는 kMaxLaneWidth의 배수)
+struct BankView {
+    uint32_t* random[4];
+    float* sine[kAxes];
+    float* cosine[kAxes];
+    const float* stepCos[kAxes];
+    const float* stepSin[kAxes];
+    const float* amplitude[kAxes];  // 자세: deg, 각속도: deg/s (진폭 x 각주파수), 가속도: 롤 / 피치 rad, 상하 m/s^2
+    const float* bias[kAxes];
+    float* walk[kAxes];
+    float walkStep;    // 샘플당 랜덤 워크 표준편차
+    float whiteSigma;
+    size_t stride;     // 출력 배열에서 샘플 하나의 간격 (= 레인 수)
+};
+
+// lane부터 W개 레인의 kBlockSamples개 샘플 생성, out[(axis * kBlockSamples + n) * stride + lane]
+template <int W, MotionKind Kind>
+inline __attribute__((always_inline)) void synthesizeLanes(const BankView& bank, size_t lane, float* out) {
+    typedef typename Lanes<W>::F F;
+    typedef typename Lanes<W>::U U;
+    constexpr size_t kSamples = IMUSignalSet::kBlockSamples;
+
+    U random[4];
+    F sine[kAxes], cosine[kAxes], stepCos[kAxes], stepSin[kAxes], amplitude[kAxes], bias[kAxes], walk[kAxes];
+    for (int k = 0; k < 4; ++k) {
+        loadLanes(random[k], bank.random[k] + lane);
+    }
+    for (size_t a = 0; a < kAxes; ++a) {
+        loadLanes(sine[a], bank.sine[a] + lane);
+        loadLanes(cosine[a], bank.cosine[a] + lane);
+        loadLanes(stepCos[a], bank.stepCos[a] + lane);
+        loadLanes(stepSin[a], bank.stepSin[a] + lane);
+        loadLanes(amplitude[a], bank.amplitude[a] + lane);
+        loadLanes(bias[a], bank.bias[a] + lane);
+        loadLanes(walk[a], bank.walk[a] + lane);
+    }
+
+    for (size_t n = 0; n < kSamples; ++n) {
+        F truth[kAxes];
+        if constexpr (Kind == MotionKind::Attitude) {
+            for (size_t a = 0; a < kAxes; ++a) {
+                truth[a] = amplitude[a] * sine[a];
+            }
+        } else if constexpr (Kind == MotionKind::Gyro) {
+            for (size_t a = 0; a < kAxes; ++a) {
+                truth[a] = amplitude[a] * cosine[a];
+            }
+        } else {
+            // 롤 / 피치 각도의 sin / cos는 다항식 근사 (진폭 15도 이하에서 오차 1e-6 미만)
+            F roll = amplitude[0] * sine[0];
+            F pitch = amplitude[1] * sine[1];
+            F heave = amplitude[2] * sine[2];
+            F roll2 = roll * roll;
+            F pitch2 = pitch * pitch;
+            F sinRoll = roll * (1.0f - roll2 * (1.0f / 6.0f - roll2 * (1.0f / 120.0f)));
+            F cosRoll = 1.0f - roll2 * (0.5f - roll2 * (1.0f / 24.0f));
+            F sinPitch = pitch * (1.0f - pitch2 * (1.0f / 6.0f - pitch2 * (1.0f / 120.0f)));
+            F cosPitch = 1.0f - pitch2 * (0.5f - pitch2 * (1.0f / 24.0f));
+            truth[0] = kGravity * sinPitch;
+            truth[1] = -kGravity * sinRoll * cosPitch;
+            truth[2] = heave - kGravity * cosRoll * cosPitch;
+        }
+
+        for (size_t a = 0; a < kAxes; ++a) {
+            F walkNoise, whiteNoise;
+            nextGaussian<W>(random, walkNoise);
+            nextGaussian<W>(random, whiteNoise);
+            walk[a] += bank.walkStep * walkNoise;
+            F value = truth[a] + bias[a] + walk[a] + bank.whiteSigma * whiteNoise;
+            storeLanes(out + (a * kSamples + n) * bank.stride + lane, value);
+
+            // 위상을 한 샘플만큼 회전
+            F nextSine = sine[a] * stepCos[a] + cosine[a] * stepSin[a];
+            cosine[a] = cosine[a] * stepCos[a] - sine[a] * stepSin[a];
+            sine[a] = nextSine;
+        }
+    }
+
+    for (int k = 0; k < 4; ++k) {
+        storeLanes(bank.random[k] + lane, random[k]);
+    }
+    for (size_t a = 0; a < kAxes; ++a) {
+        // 회전을 반복하며 쌓이는 크기 오차를 블록마다 1차 보정 (|(sin, cos)| = 1 유지)
+        F correction = 1.5f - 0.5f * (sine[a] * sine[a] + cosine[a] * cosine[a]);
+        sine[a] *= correction;
+        cosine[a] *= correction;
+        storeLanes(bank.sine[a] + lane, sine[a]);
+        storeLanes(bank.cosine[a] + lane, cosine[a]);
+        storeLanes(bank.walk[a] + lane, walk[a]);
+    }
+}
+
+template <int W, MotionKind Kind>
+inline __attribute__((always_inline)) void synthesizeRange(const BankView& bank, size_t lanes, float* out) {
+    for (size_t lane = 0; lane < lanes; lane += W) {
+        synthesizeLanes<W, Kind>(bank, lane, out);
+    }
+}
+
+template <MotionKind Kind>
+void synthesizeScalar(const BankView& bank, size_t lanes, float* out) {
+    synthesizeRange<1, Kind>(bank, lanes, out);
+}
+
+#ifdef VSENSOR_X86_SIMD
+template <MotionKind Kind>
+void synthesizeSSE2(const BankView& bank, size_t lanes, float* out) {
+    synthesizeRange<4, Kind>(bank, lanes, out);
+}
+
+template <MotionKind Kind>
+__attribute__((target("avx2"))) void synthesizeAVX2(const BankView& bank, size_t lanes, float* out) {
+    synthesizeRange<8, Kind>(bank, lanes, out);
+}
+#endif
+
+template <MotionKind Kind>
+void synthesize(SimdLevel level, const BankView& bank, size_t lanes, float* out) {
+    switch (level) {
+#ifdef VSENSOR_X86_SIMD
+    case SimdLevel::AVX2:
+        synthesizeAVX2<Kind>(bank, lanes, out);
+        return;
+    case SimdLevel::SSE2:
+        synthesizeSSE2<Kind>(bank, lanes, out);
+        return;
+#endif
+    default:
+        synthesizeScalar<Kind>(bank, lanes, out);
+        return;
+    }
+}
+
+}  // namespace
+
+// 형식 / 샘플 간격이 같은 스트림 묶음: 블록 두 개를 번갈아 채움
+// 묶음 안의 스트림은 같은 간격으로 읽히므로 서로 최대 한 블록 안에 있다.
+class IMUSignalBank {
+public:
+    IMUSignalBank(IMUSignalSet& owner, MotionKind kind, int64_t sampleIntervalNs, SimdLevel level)
+        : owner(owner), kind(kind), intervalNs(sampleIntervalNs), level(level) {}
+
+    MotionKind motion() const { return kind; }
+    int64_t sampleIntervalNs() const { return intervalNs; }
+
+    uint32_t addLane(uint64_t seed, uint32_t sensor, uint64_t stream) {
+        const SensorMotion motion = sensorMotion(seed, sensor);
+        const NoiseModel noise = noiseModel(kind);
+        const double dt = static_cast<double>(intervalNs) * 1e-9;
+        FastRandom random(deriveSeed(seed, stream, 2));
+
+        // 가속도는 롤 / 피치 각도(rad)와 상하 운동, 나머지는 롤 / 피치 / 요
+        static const int kAccelAxes[kAxes] = {0, 1, 3};
+        for (size_t a = 0; a < kAxes; ++a) {
+            int axis = kind == MotionKind::Accel ? kAccelAxes[a] : static_cast<int>(a);
+            double amplitude = motion.amplitude[axis];
+            if (kind == MotionKind::Gyro) {
+                amplitude *= motion.omega[axis];
+            } else if (kind == MotionKind::Accel && axis != 3) {
+                amplitude *= kPi / 180.0;
+            }
+            initialSine[a].push_back(static_cast<float>(std::sin(motion.phase[axis])));
+            initialCosine[a].push_back(static_cast<float>(std::cos(motion.phase[axis])));
+            stepCos[a].push_back(static_cast<float>(std::cos(motion.omega[axis] * dt)));
+            stepSin[a].push_back(static_cast<float>(std::sin(motion.omega[axis] * dt)));
+            amplitudes[a].push_back(static_cast<float>(amplitude));
+            biases[a].push_back(static_cast<float>(uniformRandom(random, -noise.biasRange, noise.biasRange)));
+        }
+        for (int k = 0; k < 4; k += 2) {
+            uint64_t word = random.next();
+            initialRandom[k].push_back(static_cast<uint32_t>(word));
+            initialRandom[k + 1].push_back(static_cast<uint32_t>(word >> 32) | 1);  // 상태가 전부 0이 되지 않도록
+        }
+        return static_cast<uint32_t>(lanes++);
+    }
+
+    // 레인 추가가 끝난 뒤 버퍼 할당과 첫 블록 생성
+    void finish() {
+        const NoiseModel noise = noiseModel(kind);
+        const double dt = static_cast<double>(intervalNs) * 1e-9;
+        walkStep = static_cast<float>(noise.walkSigmaPerRootS * std::sqrt(dt));
+        whiteSigma = noise.whiteSigma;
+
+        stride = (lanes + kMaxLaneWidth - 1) / kMaxLaneWidth * kMaxLaneWidth;
+        // 남는 레인은 마지막 레인 복사 (계산만 하고 읽지 않음)
+        for (size_t a = 0; a < kAxes; ++a) {
+            pad(initialSine[a]);
+            pad(initialCosine[a]);
+            pad(stepCos[a]);
+            pad(stepSin[a]);
+            pad(amplitudes[a]);
+            pad(biases[a]);
+            walk[a].assign(stride, 0.0f);
+        }
+        for (int k = 0; k < 4; ++k) {
+            pad(initialRandom[k]);
+        }
+        for (size_t b = 0; b < 2; ++b) {
+            blocks[b].assign(kAxes * IMUSignalSet::kBlockSamples * stride, 0.0f);
+        }
+        cursor.assign(lanes, 0);
+        generated = 0;
+        generate();
+    }
+
+    void read(uint32_t lane, float (&values)[can_codec::kMaxFields]) {
+        constexpr uint64_t kSamples = IMUSignalSet::kBlockSamples;
+        uint64_t index = cursor[lane];
+        if (index >= generated * kSamples) {
+            generate();
+            owner.onDemandCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        uint64_t oldest = generated >= 2 ? (generated - 2) * kSamples : 0;
+        if (index < oldest) {
+            owner.skippedCount.fetch_add(oldest - index, std::memory_order_relaxed);
+            index = oldest;
+        }
+        const float* block = blocks[(index / kSamples) & 1].data();
+        size_t n = index % kSamples;
+        for (size_t a = 0; a < kAxes; ++a) {
+            values[a] = block[(a * kSamples + n) * stride + lane];
+        }
+
+        uint64_t newestStart = (generated - 1) * kSamples;
+        if (cursor[lane] < newestStart && index + 1 >= newestStart) {
+            --behind;
+        }
+        cursor[lane] = index + 1;
+    }
+
+    void prepare() {
+        if (behind == 0) {
+            generate();
+        }
+    }
+
+private:
+    template <typename T>
+    void pad(std::vector<T>& values) {
+        values.resize(stride, values.empty() ? T() : values.back());
+    }
+
+    void generate() {
+        BankView view;
+        for (int k = 0; k < 4; ++k) {
+            view.random[k] = initialRandom[k].data();
+        }
+        for (size_t a = 0; a < kAxes; ++a) {
+            view.sine[a] = initialSine[a].data();
+            view.cosine[a] = initialCosine[a].data();
+            view.stepCos[a] = stepCos[a].data();
+            view.stepSin[a] = stepSin[a].data();
+            view.amplitude[a] = amplitudes[a].data();
+            view.bias[a] = biases[a].data();
+            view.walk[a] = walk[a].data();
+        }
+        view.walkStep = walkStep;
+        view.whiteSigma = whiteSigma;
+        view.stride = stride;
+
+        float* out = blocks[generated & 1].data();
+        size_t count = level == SimdLevel::Scalar ? lanes : stride;
+        switch (kind) {
+        case MotionKind::Attitude:
+            synthesize<MotionKind::Attitude>(level, view, count, out);
+            break;
+        case MotionKind::Accel:
+            synthesize<MotionKind::Accel>(level, view, count, out);
+            break;
+        default:
+            synthesize<MotionKind::Gyro>(level, view, count, out);
+            break;
+        }
+        ++generated;
+
+        // 새 최신 블록 이전에 있는 레인 수 (모두 넘어오면 prepare()에서 다음 블록 생성)
+        uint64_t newestStart = (generated - 1) * IMUSignalSet::kBlockSamples;
+        behind = static_cast<size_t>(
+            std::count_if(cursor.begin(), cursor.end(), [newestStart](uint64_t c) { return c < newestStart; }));
+
+        owner.blockCount.fetch_add(1, std::memory_order_relaxed);
+        owner.sampleCount.fetch_add(lanes * IMUSignalSet::kBlockSamples, std::memory_order_relaxed);
+    }
+
+    IMUSignalSet& owner;
+    MotionKind kind;
+    int64_t intervalNs;
+    SimdLevel level;
+    size_t lanes{0};
+    size_t stride{0};
+
+    // 레인별 상태 (생성할 때마다 갱신되는 위상 / 난수 / 랜덤 워크 포함)
+    std::vector<uint32_t> initialRandom[4];
+    std::vector<float> initialSine[kAxes];
+    std::vector<float> initialCosine[kAxes];
+    std::vector<float> stepCos[kAxes];
+    std::vector<float> stepSin[kAxes];
+    std::vector<float> amplitudes[kAxes];
+    std::vector<float> biases[kAxes];
+    std::vector<float> walk[kAxes];
+    float walkStep{0.0f};
+    float whiteSigma{0.0f};
+
+    std::vector<float> blocks[2];  // blocks[b % 2] = b번째 블록
+    uint64_t generated{0};         // 생성한 블록 수
+    std::vector<uint64_t> cursor;  // 레인별 다음에 읽을 샘플 번호
+    size_t behind{0};
+};
+
+IMUSignalSet::IMUSignalSet() = default;
+IMUSignalSet::~IMUSignalSet() = default;
+
+void IMUSignalSet::configure(const std::vector<IMUSignalStream>& streams, uint64_t seed, SimdLevel level) {
+    simdLevel = simdLevelAvailable(level) ? level : SimdLevel::Scalar;
+    slots.clear();
+    banks.clear();
+    fallbackRandom.reseed(deriveSeed(seed, 0, 3));
+
+    std::map<std::pair<MotionKind, int64_t>, int32_t> bankIndex;
+    slots.reserve(streams.size());
+    for (size_t i = 0; i < streams.size(); ++i) {
+        const IMUSignalStream& stream = streams[i];
+        Slot slot = {-1, 0, stream.layout};
+        MotionKind kind = can_codec::kMessages[stream.layout].motion;
+        if (kind != MotionKind::None && can_codec::kMessages[stream.layout].fieldCount == kAxes) {
+            int64_t intervalNs = stream.sampleIntervalNs > 0 ? stream.sampleIntervalNs : kDefaultSampleIntervalNs;
+            auto found = bankIndex.find({kind, intervalNs});
+            if (found == bankIndex.end()) {
+                found = bankIndex.emplace(std::make_pair(kind, intervalNs), static_cast<int32_t>(banks.size())).first;
+                banks.push_back(std::make_unique<IMUSignalBank>(*this, kind, intervalNs, simdLevel));
+            }
+            slot.bank = found->second;
+            slot.lane = banks[slot.bank]->addLane(seed, stream.sensor, i);
+        }
+        slots.push_back(slot);
+    }
+    for (const std::unique_ptr<IMUSignalBank>& bank : banks) {
+        bank->finish();
+    }
+    streamCount.store(slots.size(), std::memory_order_relaxed);
+}
+
+void IMUSignalSet::next(size_t stream, float (&values)[can_codec::kMaxFields]) {
+    const Slot& slot = slots[stream];
+    if (slot.bank >= 0) {
+        banks[slot.bank]->read(slot.lane, values);
+        return;
+    }
+    const can_codec::MessageDesc& msg = can_codec::kMessages[slot.layout];
+    for (int f = 0; f < msg.fieldCount; ++f) {
+        values[f] = static_cast<float>(uniformRandom(fallbackRandom, msg.fields[f].minValue, msg.fields[f].maxValue));
+    }
+}
+
+void IMUSignalSet::prepare() {
+    for (const std::unique_ptr<IMUSignalBank>& bank : banks) {
+        bank->prepare();
+    }
+}
+
+IMUSignalStats IMUSignalSet::stats() const {
+    return {streamCount.load(std::memory_order_relaxed), sampleCount.load(std::memory_order_relaxed),
+            blockCount.load(std::memory_order_relaxed), onDemandCount.load(std::memory_order_relaxed),
+            skippedCount.load(std::memory_order_relaxed)};
+}
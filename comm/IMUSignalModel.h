@@ -0,0 +1,82 @@
+#ifndef IMUSIGNALMODEL_H
+#define IMUSIGNALMODEL_H
+
+#include "CANSignalCodec.h"
+#include "FastRandom.h"
+#include "SimdDispatch.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// 송신 값 스트림 하나 (CAN 메시지 하나)
+struct IMUSignalStream {
+    uint32_t sensor;           // 같은 센서의 스트림은 같은 자세 궤적을 공유 (자세 / 가속도 / 각속도가 서로 맞음)
+    uint8_t layout;            // can_codec::kMessages 인덱스
+    int64_t sampleIntervalNs;  // 샘플 간격 (송신 주기 / 프레임당 샘플 수), 0 이하면 kDefaultSampleIntervalNs
+};
+
+struct IMUSignalStats {
+    size_t streams;
+    uint64_t samples;          // 생성한 샘플 수 (스트림 x 샘플)
+    uint64_t blocks;           // 블록 생성 횟수
+    uint64_t onDemandBlocks;   // 미리 만들어 둔 블록이 없어 송신 중에 생성한 횟수
+    uint64_t skippedSamples;   // 같은 묶음의 다른 스트림보다 늦게 읽어 건너뛴 샘플 수
+};
+
+class IMUSignalBank;
+
+// 가상 IMU 송신 값 생성기
+// 값 = 운동 + 고정 바이어스 + 랜덤 워크 + 가우시안 잡음 (축마다 독립, 센서마다 매개변수가 다름)
+//  - 운동: 센서마다 주기 / 진폭 / 위상이 다른 정현파 롤 / 피치 / 요 / 상하 운동.
+//    자세는 각도, 각속도는 그 미분, 가속도는 기울기에 따른 중력 성분과 상하 가속도 (NED 기체 좌표계).
+//  - 잡음은 xoshiro128** 16비트 난수 4개의 합(Irwin-Hall)으로 근사한 표준 정규 분포.
+// 형식과 샘플 간격이 같은 스트림을 한 묶음으로 kBlockSamples개씩 SIMD로 미리 생성해 두고
+// 송신 시에는 읽기만 한다. 시드와 스트림 구성이 같으면 SIMD 경로와 무관하게 같은 값이 나온다.
+// 운동 모델이 없는 형식(MotionKind::None)은 신호 범위 내 균등 분포.
+// 반응기 스레드 전용 (stats()는 어느 스레드에서나).
+class IMUSignalSet {
+public:
+    static constexpr size_t kBlockSamples = 32;
+    static constexpr int64_t kDefaultSampleIntervalNs = 10000000;  // 10ms (이벤트 메시지)
+
+    IMUSignalSet();
+    ~IMUSignalSet();
+
+    IMUSignalSet(const IMUSignalSet&) = delete;
+    IMUSignalSet& operator=(const IMUSignalSet&) = delete;
+
+    // 스트림 구성 변경 (모든 스트림이 시각 0부터 다시 시작)
+    void configure(const std::vector<IMUSignalStream>& streams, uint64_t seed, SimdLevel level = bestSimdLevel());
+    size_t size() const { return slots.size(); }
+    SimdLevel level() const { return simdLevel; }
+
+    // 스트림의 다음 샘플 물리값 (kMessages[layout].fieldCount개)
+    void next(size_t stream, float (&values)[can_codec::kMaxFields]);
+    // 모든 스트림이 최신 블록으로 넘어간 묶음은 다음 블록을 미리 생성 (송신 직후 호출)
+    void prepare();
+
+    IMUSignalStats stats() const;
+
+private:
+    struct Slot {
+        int32_t bank;   // -1: 운동 모델 없음 (균등 분포)
+        uint32_t lane;
+        uint8_t layout;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<std::unique_ptr<IMUSignalBank>> banks;
+    FastRandom fallbackRandom;  // 운동 모델이 없는 형식
+    SimdLevel simdLevel{SimdLevel::Scalar};
+
+    std::atomic<size_t> streamCount{0};
+    std::atomic<uint64_t> sampleCount{0};
+    std::atomic<uint64_t> blockCount{0};
+    std::atomic<uint64_t> onDemandCount{0};
+    std::atomic<uint64_t> skippedCount{0};
+
+    friend class IMUSignalBank;
+};
+
+#endif // IMUSIGNALMODEL_H
@@ -0,0 +1,129 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// 결과 요약용 스트리밍 JSON 출력 (Qt 없이 사용하는 도구 / 벤치마크 공용)
+// beginObject / key / value 순서로 호출하면 쉼표와 들여쓰기를 알아서 넣는다.
+class JsonWriter {
+public:
+    explicit JsonWriter(std::ostream& out, bool pretty = true) : out(out), pretty(pretty) {}
+
+    void beginObject() { open('{'); }
+    void endObject() { close('}'); }
+    void beginArray() { open('['); }
+    void endArray() { close(']'); }
+
+    void key(std::string_view name) {
+        separate();
+        writeString(name);
+        out << (pretty ? ": " : ":");
+        afterKey = true;
+    }
+
+    void value(std::string_view text) {
+        separate();
+        writeString(text);
+    }
+    void value(const char* text) { value(std::string_view(text)); }
+    void value(bool flag) {
+        separate();
+        out << (flag ? "true" : "false");
+    }
+    void value(double number) {
+        separate();
+        if (!std::isfinite(number)) {
+            out << "null";
+            return;
+        }
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.15g", number);
+        out << buffer;
+    }
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+    void value(T number) {
+        separate();
+        out << +number;  // char 계열도 숫자로
+    }
+
+    template <typename T>
+    void field(std::string_view name, const T& v) {
+        key(name);
+        value(v);
+    }
+
+private:
+    void open(char bracket) {
+        separate();
+        out << bracket;
+        hasItems.push_back(false);
+    }
+
+    void close(char bracket) {
+        bool nonEmpty = hasItems.back();
+        hasItems.pop_back();
+        if (nonEmpty) {
+            newline();
+        }
+        out << bracket;
+        if (hasItems.empty()) {
+            out << '\n';
+        }
+    }
+
+    // 값 / 키 앞: 같은 단계의 두 번째 항목부터 쉼표, 키 바로 뒤의 값이면 아무것도 안 함
+    void separate() {
+        if (afterKey) {
+            afterKey = false;
+            return;
+        }
+        if (hasItems.empty()) {
+            return;
+        }
+        if (hasItems.back()) {
+            out << ',';
+        }
+        hasItems.back() = true;
+        newline();
+    }
+
+    void newline() {
+        if (pretty) {
+            out << '\n';
+            for (size_t i = 0; i < hasItems.size(); ++i) {
+                out << "  ";
+            }
+        }
+    }
+
+    void writeString(std::string_view text) {
+        static const char kHex[] = "0123456789abcdef";
+        out << '"';
+        for (char c : text) {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if (c == '\n') {
+                out << "\\n";
+            } else if (u < 0x20) {
+                out << "\\u00" << kHex[u >> 4] << kHex[u & 0xF];
+            } else {
+                out << c;  // UTF-8은 그대로
+            }
+        }
+        out << '"';
+    }
+
+    std::ostream& out;
+    bool pretty;
+    bool afterKey{false};
+    std::vector<bool> hasItems;  // 열린 객체 / 배열마다 항목이 있었는지
+};
+
+#endif // JSONWRITER_H
@@ -0,0 +1,79 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+    constexpr uint64_t subBuckets = 1ull << kSubBucketBits;
+    if (value < subBuckets) {
+        return static_cast<size_t>(value);
+    }
+
+    // 최상위 비트 위치로 구간을 정하고, 그 아래 kSubBucketBits 비트로 하위 구간을 정함
+    int exponent = 63 - __builtin_clzll(value);
+    int shift = exponent - kSubBucketBits;
+    return static_cast<size_t>((shift + 1) << kSubBucketBits) + static_cast<size_t>((value >> shift) - subBuckets);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    constexpr uint64_t subBuckets = 1ull << kSubBucketBits;
+    if (index < subBuckets) {
+        return index;
+    }
+
+    int shift = static_cast<int>(index >> kSubBucketBits) - 1;
+    uint64_t mantissa = (index & (subBuckets - 1)) + subBuckets;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t valueNs) {
+    uint64_t value = std::min(valueNs, kMaxValue);
+    buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    totalCount.fetch_add(1, std::memory_order_relaxed);
+    totalSum.fetch_add(value, std::memory_order_relaxed);
+
+    // 기록 스레드가 하나이므로 비교 후 저장으로 충분
+    if (value > maxValue.load(std::memory_order_relaxed)) {
+        maxValue.store(value, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    totalCount.store(0, std::memory_order_relaxed);
+    totalSum.store(0, std::memory_order_relaxed);
+    maxValue.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    // 실행 중 조회 시 버킷 합과 totalCount가 어긋날 수 있으므로 버킷을 직접 합산
+    uint64_t total = 0;
+    for (const auto& bucket : buckets) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t target = static_cast<uint64_t>(q * static_cast<double>(total));
+    target = std::clamp<uint64_t>(target, 1, total);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return std::min(bucketUpperBound(i), max());
+        }
+    }
+    return max();
+}
+
+HistogramSummary LatencyHistogram::summary() const {
+    uint64_t n = count();
+    return {n,
+            percentile(0.50),
+            percentile(0.99),
+            percentile(0.999),
+            max(),
+            n ? static_cast<double>(totalSum.load(std::memory_order_relaxed)) / static_cast<double>(n) : 0.0};
+}
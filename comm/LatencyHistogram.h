@@ -0,0 +1,46 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// 히스토그램 요약 (단위: ns)
+struct HistogramSummary {
+    uint64_t count;
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t p999;
+    uint64_t max;
+    double mean;
+};
+
+// HDR 방식 로그-선형 히스토그램
+// 2의 거듭제곱 구간마다 32개의 하위 구간을 두어 상대 오차 ~3%로 1ns ~ 2^40ns(약 18분)를 기록한다.
+// record()는 기록 스레드 하나에서 호출하고, summary()는 다른 스레드에서 실행 중에 호출할 수 있다.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr int kMaxExponent = 40;
+    static constexpr uint64_t kMaxValue = (1ull << kMaxExponent) - 1;
+    static constexpr size_t kBucketCount = (kMaxExponent - kSubBucketBits + 1) << kSubBucketBits;
+
+    void record(uint64_t valueNs);
+    void reset();
+
+    uint64_t count() const { return totalCount.load(std::memory_order_relaxed); }
+    uint64_t max() const { return maxValue.load(std::memory_order_relaxed); }
+    uint64_t percentile(double q) const;  // q: 0.0 ~ 1.0
+    HistogramSummary summary() const;
+
+private:
+    std::atomic<uint64_t> buckets[kBucketCount] = {};
+    std::atomic<uint64_t> totalCount{0};
+    std::atomic<uint64_t> totalSum{0};
+    std::atomic<uint64_t> maxValue{0};
+
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(size_t index);
+};
+
+#endif // LATENCYHISTOGRAM_H
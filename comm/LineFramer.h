@@ -0,0 +1,54 @@
+#ifndef LINEFRAMER_H
+#define LINEFRAMER_H
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+// 바이트 스트림을 줄 단위로 자르는 증분 프레이머
+// 읽은 조각을 feed()에 넣으면 완성된 줄마다(CR/LF 제외) 콜백을 호출한다.
+// 최대 길이를 넘는 줄은 다음 줄바꿈까지 버린다.
+class LineFramer {
+public:
+    static constexpr size_t kMaxLineLength = 512;
+
+    template <typename Callback>
+    void feed(const char* data, size_t length, Callback&& onLine) {
+        for (size_t i = 0; i < length; ++i) {
+            char ch = data[i];
+            if (ch == '\n' || ch == '\r') {
+                if (!discarding && used > 0) {
+                    onLine(std::string_view(line, used));
+                }
+                used = 0;
+                discarding = false;
+                continue;
+            }
+            if (discarding) {
+                continue;
+            }
+            if (used == kMaxLineLength) {
+                used = 0;
+                discarding = true;
+                ++overflowCount;
+                continue;
+            }
+            line[used++] = ch;
+        }
+    }
+
+    void reset() {
+        used = 0;
+        discarding = false;
+    }
+
+    size_t overflows() const { return overflowCount; }
+
+private:
+    char line[kMaxLineLength];
+    size_t used = 0;
+    bool discarding = false;
+    size_t overflowCount = 0;
+};
+
+#endif // LINEFRAMER_H
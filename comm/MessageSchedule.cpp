@@ -0,0 +1,235 @@
+#include "MessageSchedule.h"
+#include "CANId.h"
+#include <algorithm>
+#include <climits>
+
+std::vector<ScheduledMessage> makeSensorFleet(size_t count, canid_t baseId, const std::vector<int64_t>& periodsNs,
+                                              int64_t jitterNs, uint8_t layoutCount) {
+    std::vector<ScheduledMessage> fleet;
+    if (periodsNs.empty() || layoutCount == 0) {
+        return fleet;
+    }
+    const size_t groups = periodsNs.size();
+    const size_t perGroup = (count + groups - 1) / groups;
+    fleet.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        int64_t periodNs = periodsNs[i % groups];
+        ScheduledMessage message;
+        message.id = normalizeCANID(baseId + static_cast<canid_t>(i));
+        message.layout = static_cast<uint8_t>(i % layoutCount);
+        message.periodNs = periodNs;
+        message.phaseNs = periodNs * static_cast<int64_t>(i / groups) / static_cast<int64_t>(perGroup);
+        message.jitterNs = periodNs > 0 ? jitterNs : 0;
+        message.sensor = static_cast<uint32_t>(i / layoutCount);
+        fleet.push_back(message);
+    }
+    return fleet;
+}
+
+MessageSchedule::MessageSchedule(int64_t tickNs) : tick(std::max<int64_t>(tickNs, 1000)) {
+    for (Level& level : levels) {
+        std::fill(std::begin(level.heads), std::end(level.heads), kNone);
+        std::fill(std::begin(level.occupied), std::end(level.occupied), 0);
+    }
+}
+
+void MessageSchedule::setMessages(const std::vector<ScheduledMessage>& messages, uint64_t seed) {
+    entries.clear();
+    entries.reserve(messages.size());
+    for (const ScheduledMessage& message : messages) {
+        Entry entry = {};
+        entry.message = message;
+        entry.next = kNone;
+        if (message.periodNs > 0) {
+            // 반올림, 최소 1틱
+            entry.periodTicks = std::clamp<uint64_t>(static_cast<uint64_t>((message.periodNs + tick / 2) / tick), 1,
+                                                     kMaxDelayTicks);
+            // 지터는 주기의 절반까지만 (연속한 두 송신의 순서가 바뀌지 않도록)
+            entry.jitterTicks = std::min<uint64_t>(static_cast<uint64_t>(std::max<int64_t>(message.jitterNs, 0) / tick),
+                                                   entry.periodTicks / 2);
+        }
+        entries.push_back(entry);
+    }
+    random.reseed(seed);
+    for (Level& level : levels) {
+        std::fill(std::begin(level.heads), std::end(level.heads), kNone);
+        std::fill(std::begin(level.occupied), std::end(level.occupied), 0);
+    }
+    pendingCount = 0;
+    currentTick = 0;
+    messageCount.store(entries.size(), std::memory_order_relaxed);
+}
+
+uint64_t MessageSchedule::toTick(int64_t ns) const {
+    return ns <= startNs ? 0 : static_cast<uint64_t>((ns - startNs) / tick);
+}
+
+void MessageSchedule::start(int64_t nowNs) {
+    for (Level& level : levels) {
+        std::fill(std::begin(level.heads), std::end(level.heads), kNone);
+        std::fill(std::begin(level.occupied), std::end(level.occupied), 0);
+    }
+    startNs = nowNs;
+    currentTick = 0;
+    pendingCount = 0;
+
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        Entry& entry = entries[i];
+        entry.pending = false;
+        entry.next = kNone;
+        if (entry.periodTicks == 0) {
+            continue;
+        }
+        entry.nominalTick = static_cast<uint64_t>(std::max<int64_t>(entry.message.phaseNs, 0) / tick);
+        int64_t jitter = entry.jitterTicks ? random.uniform(-static_cast<int64_t>(entry.jitterTicks),
+                                                            static_cast<int64_t>(entry.jitterTicks)) : 0;
+        insert(i, static_cast<uint64_t>(std::max<int64_t>(static_cast<int64_t>(entry.nominalTick) + jitter, 0)));
+    }
+}
+
+void MessageSchedule::trigger(size_t index, int64_t nowNs) {
+    Entry& entry = entries[index];
+    if (entry.pending) {
+        return;  // 이미 대기 중인 만료에 합침
+    }
+    uint64_t nowTick = toTick(nowNs);
+    if (pendingCount == 0) {
+        currentTick = std::max(currentTick, nowTick);  // 비어 있으면 시각만 앞당김
+    }
+    insert(static_cast<uint32_t>(index), std::max(currentTick, nowTick));
+}
+
+void MessageSchedule::insert(uint32_t index, uint64_t expiresTick) {
+    entries[index].pending = true;
+    ++pendingCount;
+    place(index, expiresTick);
+}
+
+void MessageSchedule::place(uint32_t index, uint64_t expiresTick) {
+    // 남은 틱 수에 맞는 단계의 슬롯 (단계 k의 슬롯은 만료 틱의 k번째 8비트)
+    expiresTick = std::clamp(expiresTick, currentTick, currentTick + kMaxDelayTicks);
+    uint64_t delta = expiresTick - currentTick;
+    int level = 0;
+    while (level < kLevels - 1 && delta >= (uint64_t(1) << (kLevelBits * (level + 1)))) {
+        ++level;
+    }
+    size_t slot = (expiresTick >> (kLevelBits * level)) & kSlotMask;
+
+    Entry& entry = entries[index];
+    entry.expiresTick = expiresTick;
+    entry.next = levels[level].heads[slot];
+    levels[level].heads[slot] = static_cast<int32_t>(index);
+    levels[level].occupied[slot / 64] |= uint64_t(1) << (slot % 64);
+}
+
+int32_t MessageSchedule::detach(Level& level, size_t slot) {
+    int32_t head = level.heads[slot];
+    level.heads[slot] = kNone;
+    level.occupied[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+    return head;
+}
+
+void MessageSchedule::cascade(int level, size_t slot) {
+    // 이번 구간에 만료되는 상위 단계 항목을 남은 틱 수에 맞는 하위 단계로 내림
+    for (int32_t i = detach(levels[level], slot); i != kNone;) {
+        int32_t next = entries[i].next;
+        place(static_cast<uint32_t>(i), entries[i].expiresTick);
+        i = next;
+    }
+}
+
+void MessageSchedule::fireSlot(size_t slot, std::vector<uint32_t>& due) {
+    for (int32_t i = detach(levels[0], slot); i != kNone;) {
+        int32_t next = entries[i].next;
+        entries[i].pending = false;
+        --pendingCount;
+        due.push_back(static_cast<uint32_t>(i));
+        if (entries[i].periodTicks > 0) {
+            rearm(static_cast<uint32_t>(i));
+        }
+        i = next;
+    }
+}
+
+void MessageSchedule::rearm(uint32_t index) {
+    Entry& entry = entries[index];
+    entry.nominalTick += entry.periodTicks;
+    if (entry.nominalTick <= targetTick) {
+        // 실행이 주기보다 늦어진 경우 놓친 주기는 건너뜀 (한 번에 몰아서 보내지 않음)
+        uint64_t missed = (targetTick - entry.nominalTick) / entry.periodTicks + 1;
+        entry.nominalTick += missed * entry.periodTicks;
+        skippedCount.fetch_add(missed, std::memory_order_relaxed);
+    }
+    int64_t jitter = entry.jitterTicks ? random.uniform(-static_cast<int64_t>(entry.jitterTicks),
+                                                        static_cast<int64_t>(entry.jitterTicks)) : 0;
+    int64_t expires = static_cast<int64_t>(entry.nominalTick) + jitter;
+    insert(index, std::max<uint64_t>(static_cast<uint64_t>(std::max<int64_t>(expires, 0)), targetTick + 1));
+}
+
+uint64_t MessageSchedule::nextPendingTick() const {
+    if (pendingCount == 0) {
+        return UINT64_MAX;
+    }
+    size_t index = currentTick & kSlotMask;
+    if (index == 0) {
+        return currentTick;  // 상위 단계를 내려야 하는 경계
+    }
+    // 이번 구간(현재 위치 ~ 255)에서 점유된 첫 슬롯, 없으면 다음 경계
+    const uint64_t* occupied = levels[0].occupied;
+    size_t word = index / 64;
+    uint64_t bits = occupied[word] & (~uint64_t(0) << (index % 64));
+    for (;;) {
+        if (bits != 0) {
+            return currentTick - index + word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+        }
+        if (++word == kBitmapWords) {
+            return currentTick - index + kSlots;
+        }
+        bits = occupied[word];
+    }
+}
+
+size_t MessageSchedule::advance(int64_t nowNs, std::vector<uint32_t>& due) {
+    size_t before = due.size();
+    const uint64_t target = toTick(nowNs);
+    targetTick = target;
+    uint64_t wakeups = 0;
+
+    while (pendingCount > 0 && currentTick <= target) {
+        size_t index = currentTick & kSlotMask;
+        if (index == 0) {
+            for (int level = 1; level < kLevels; ++level) {
+                size_t slot = (currentTick >> (kLevelBits * level)) & kSlotMask;
+                cascade(level, slot);
+                if (slot != 0) {
+                    break;
+                }
+            }
+        }
+        fireSlot(index, due);
+        ++wakeups;
+        ++currentTick;
+        // 만료 항목이 없는 틱은 건너뜀 (경계는 건너뛰지 않음)
+        currentTick = std::min(nextPendingTick(), target + 1);
+    }
+    if (pendingCount == 0) {
+        currentTick = std::max(currentTick, target + 1);
+    }
+
+    wakeupCount.fetch_add(wakeups, std::memory_order_relaxed);
+    firedCount.fetch_add(due.size() - before, std::memory_order_relaxed);
+    return due.size() - before;
+}
+
+int64_t MessageSchedule::nextDeadlineNs() const {
+    uint64_t next = nextPendingTick();
+    if (next == UINT64_MAX) {
+        return INT64_MAX;
+    }
+    return startNs + static_cast<int64_t>(next) * tick;
+}
+
+MessageScheduleStats MessageSchedule::stats() const {
+    return {messageCount.load(std::memory_order_relaxed), firedCount.load(std::memory_order_relaxed),
+            skippedCount.load(std::memory_order_relaxed), wakeupCount.load(std::memory_order_relaxed)};
+}
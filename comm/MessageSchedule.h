@@ -0,0 +1,113 @@
+#ifndef MESSAGESCHEDULE_H
+#define MESSAGESCHEDULE_H
+
+#include "FastRandom.h"
+#include <linux/can.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 가상 센서 메시지 하나의 송신 일정
+struct ScheduledMessage {
+    canid_t id;         // 송신 CAN ID (29비트 ID는 normalizeCANID()로 CAN_EFF_FLAG를 붙여 사용)
+    uint8_t layout;     // 페이로드 형식 (can_codec::kMessages 인덱스)
+    int64_t periodNs;   // 0이면 이벤트 메시지 (trigger()로만 송신)
+    int64_t phaseNs;    // start() 후 첫 송신까지
+    int64_t jitterNs;   // 송신 시각을 ±jitterNs 안에서 균등 분포로 흔듦 (기준 시각에는 누적되지 않음)
+    uint32_t sensor;    // 가상 센서 번호 (같은 센서의 메시지는 같은 운동을 공유, IMUSignalModel)
+};
+
+struct MessageScheduleStats {
+    size_t messages;
+    uint64_t fired;           // 만료되어 송신 목록에 넣은 수
+    uint64_t skippedPeriods;  // 실행이 늦어 건너뛴 주기 수 (한 번의 advance()에서 메시지마다 최대 1회 송신)
+    uint64_t wakeups;         // advance()에서 실제로 처리한 틱 수 (빈 틱은 건너뜀)
+};
+
+// 부하 측정용 가상 센서 묶음: i번째 메시지는 ID baseId + i, 주기 periodsNs[i % 주기 수] (0이면 이벤트 메시지),
+// 페이로드 형식 i % layoutCount, 센서 i / layoutCount. 같은 주기의 메시지는 위상을 주기 안에 고르게 나눠
+// 한 틱에 몰리지 않게 한다.
+std::vector<ScheduledMessage> makeSensorFleet(size_t count, canid_t baseId, const std::vector<int64_t>& periodsNs,
+                                              int64_t jitterNs, uint8_t layoutCount);
+
+// 계층형 타이밍 휠 (256슬롯 x 4단계, 틱 kDefaultTickNs)
+// 메시지마다 주기 / 위상 / 지터가 다르고 수천 개여도, 만료 처리 비용은 실제로 송신하는 메시지 수와
+// 상위 단계 슬롯을 내리는(cascade) 횟수에만 비례한다. 비어 있는 틱은 점유 비트맵으로 건너뛰므로
+// 타이머는 다음 만료 시각에만 걸면 된다.
+// 실행 쪽 함수는 한 스레드(채널의 반응기 스레드)에서만 호출하고, stats()는 어느 스레드에서나 호출 가능하다.
+class MessageSchedule {
+public:
+    static constexpr int64_t kDefaultTickNs = 100000;  // 100us (PeriodicScheduler::kMinPeriodNs)
+    static constexpr int kLevelBits = 8;
+    static constexpr int kLevels = 4;
+    static constexpr size_t kSlots = size_t(1) << kLevelBits;
+    static constexpr uint64_t kMaxDelayTicks = (uint64_t(1) << (kLevelBits * kLevels)) - 1;
+
+    explicit MessageSchedule(int64_t tickNs = kDefaultTickNs);
+
+    // 일정 교체 (대기 중인 만료는 모두 지워지므로 다시 start() 필요)
+    void setMessages(const std::vector<ScheduledMessage>& messages, uint64_t seed);
+    bool empty() const { return entries.empty(); }
+    size_t size() const { return entries.size(); }
+    const ScheduledMessage& message(size_t index) const { return entries[index].message; }
+    int64_t tickNs() const { return tick; }
+
+    // nowNs(CLOCK_MONOTONIC)를 시작 시각으로 모든 주기 메시지를 위상 위치에 배치
+    void start(int64_t nowNs);
+    // 이벤트 송신: 다음 틱에 한 번 (이미 대기 중이면 그 만료와 합쳐짐)
+    void trigger(size_t index, int64_t nowNs);
+
+    // nowNs까지 만료된 메시지 인덱스를 due에 추가 (같은 호출에서 만료된 메시지는 한 번에 송신하도록)
+    // 반환: 추가한 수
+    size_t advance(int64_t nowNs, std::vector<uint32_t>& due);
+    // 다음에 advance()를 호출해야 하는 시각 (대기 중인 만료가 없으면 INT64_MAX)
+    int64_t nextDeadlineNs() const;
+
+    MessageScheduleStats stats() const;
+
+private:
+    static constexpr int32_t kNone = -1;
+    static constexpr size_t kSlotMask = kSlots - 1;
+    static constexpr size_t kBitmapWords = kSlots / 64;
+
+    struct Entry {
+        ScheduledMessage message;
+        uint64_t periodTicks;   // 0: 이벤트 메시지
+        uint64_t jitterTicks;
+        uint64_t nominalTick;   // 지터를 빼고 주기만 더한 기준 시각
+        uint64_t expiresTick;   // 실제 만료 틱 (기준 시각 + 지터)
+        int32_t next;           // 같은 슬롯의 다음 항목
+        bool pending;
+    };
+
+    struct Level {
+        int32_t heads[kSlots];
+        uint64_t occupied[kBitmapWords];
+    };
+
+    uint64_t toTick(int64_t ns) const;  // startNs 기준 틱 (내림)
+    void insert(uint32_t index, uint64_t expiresTick);
+    void place(uint32_t index, uint64_t expiresTick);  // 슬롯 연결만 (pending 변경 없음)
+    void cascade(int level, size_t slot);
+    void fireSlot(size_t slot, std::vector<uint32_t>& due);
+    void rearm(uint32_t index);
+    uint64_t nextPendingTick() const;  // currentTick 이후 처음 처리할 틱 (없으면 UINT64_MAX)
+    int32_t detach(Level& level, size_t slot);
+
+    int64_t tick;
+    int64_t startNs{0};
+    uint64_t currentTick{0};  // 아직 처리하지 않은 첫 틱
+    uint64_t targetTick{0};   // 진행 중인 advance()의 목표 틱 (이보다 늦은 주기는 건너뜀)
+    size_t pendingCount{0};
+    std::vector<Entry> entries;
+    Level levels[kLevels];
+    FastRandom random;
+
+    std::atomic<size_t> messageCount{0};
+    std::atomic<uint64_t> firedCount{0};
+    std::atomic<uint64_t> skippedCount{0};
+    std::atomic<uint64_t> wakeupCount{0};
+};
+
+#endif // MESSAGESCHEDULE_H
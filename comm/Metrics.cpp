@@ -0,0 +1,82 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+void MetricsWriter::sample(std::string_view name, MetricType type, std::string_view help, std::string_view labels,
+                           double value) {
+    auto it = std::find_if(families.begin(), families.end(), [name](const Family& f) { return f.name == name; });
+    if (it == families.end()) {
+        Family family;
+        family.name = std::string(name);
+        family.header.append("# HELP ").append(name).append(" ").append(help).append("\n");
+        family.header.append("# TYPE ").append(name).append(type == MetricType::Counter ? " counter\n" : " gauge\n");
+        families.push_back(std::move(family));
+        it = families.end() - 1;
+    }
+
+    // 카운터는 2^53까지 정수로 정확히 표현됨
+    char number[32];
+    if (std::isnan(value)) {
+        std::snprintf(number, sizeof(number), "NaN");
+    } else {
+        std::snprintf(number, sizeof(number), "%.17g", value);
+    }
+    std::string& out = it->samples;
+    out.append(name);
+    if (!labels.empty()) {
+        out.append("{").append(labels).append("}");
+    }
+    out.append(" ").append(number).append("\n");
+}
+
+void MetricsWriter::label(std::string& labels, std::string_view name, std::string_view value) {
+    if (!labels.empty()) {
+        labels += ',';
+    }
+    labels.append(name).append("=\"");
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            labels += '\\';
+            labels += c;
+        } else if (c == '\n') {
+            labels += "\\n";
+        } else {
+            labels += c;
+        }
+    }
+    labels += '"';
+}
+
+std::string MetricsWriter::text() const {
+    std::string out;
+    for (const Family& family : families) {
+        out += family.header;
+        out += family.samples;
+    }
+    return out;
+}
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+void MetricsRegistry::add(const MetricsSource* source) {
+    std::lock_guard<std::mutex> lock(sourceMutex);
+    sources.push_back(source);
+}
+
+void MetricsRegistry::remove(const MetricsSource* source) {
+    std::lock_guard<std::mutex> lock(sourceMutex);
+    sources.erase(std::remove(sources.begin(), sources.end(), source), sources.end());
+}
+
+std::string MetricsRegistry::render() const {
+    MetricsWriter writer;
+    std::lock_guard<std::mutex> lock(sourceMutex);
+    for (const MetricsSource* source : sources) {
+        source->collectMetrics(writer);
+    }
+    return writer.text();
+}
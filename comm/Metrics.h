@@ -0,0 +1,74 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 런타임 카운터 / 게이지 (Prometheus 텍스트 형식으로 내보내기, MetricsExporter 참고)
+// 핫 패스는 채널이 가진 MetricCounter만 relaxed로 올리고, 수집은 내보내기 스레드가 읽기만 한다.
+
+constexpr size_t kCacheLineSize = 64;
+
+// 캐시 라인 하나를 차지하는 누적 카운터
+// 보통 채널의 반응기 스레드 하나만 쓰지만 sendData() 등은 다른 스레드에서도 호출되므로 fetch_add,
+// 서로 다른 스레드가 올리는 카운터가 같은 줄을 공유하지 않도록 줄 단위로 배치한다.
+struct alignas(kCacheLineSize) MetricCounter {
+    std::atomic<uint64_t> value{0};
+
+    void add(uint64_t n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t load() const { return value.load(std::memory_order_relaxed); }
+};
+
+static_assert(sizeof(MetricCounter) == kCacheLineSize, "MetricCounter는 캐시 라인 하나 크기");
+
+enum class MetricType { Counter, Gauge };
+
+// Prometheus 텍스트 형식 작성기
+// 같은 이름의 샘플은 여러 채널에서 섞여 들어와도 # HELP / # TYPE 아래에 모아서 출력한다.
+class MetricsWriter {
+public:
+    // labels: 'name="value",...' 형식 (label()로 조립)
+    void sample(std::string_view name, MetricType type, std::string_view help, std::string_view labels, double value);
+
+    static void label(std::string& labels, std::string_view name, std::string_view value);  // 값 이스케이프 포함
+    std::string text() const;
+
+private:
+    struct Family {
+        std::string name;
+        std::string header;   // # HELP / # TYPE
+        std::string samples;
+    };
+    std::vector<Family> families;  // 처음 나온 순서
+};
+
+// 지표를 내보내는 객체 (채널 등)
+class MetricsSource {
+public:
+    virtual ~MetricsSource() = default;
+    // 내보내기 스레드에서 호출: atomic 값과 게이지만 읽어야 함
+    virtual void collectMetrics(MetricsWriter& writer) const = 0;
+};
+
+// 프로세스 전체 지표 소스 목록
+// 소스는 생성자 끝에서 add(), 소멸자 처음에서 remove() (수집 중이면 끝날 때까지 대기)
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance();
+
+    void add(const MetricsSource* source);
+    void remove(const MetricsSource* source);
+    std::string render() const;  // 모든 소스를 수집한 Prometheus 텍스트
+
+private:
+    MetricsRegistry() = default;
+
+    mutable std::mutex sourceMutex;
+    std::vector<const MetricsSource*> sources;
+};
+
+#endif // METRICS_H
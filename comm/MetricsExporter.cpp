@@ -0,0 +1,192 @@
+#include "MetricsExporter.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+int openListenSocket(const std::string& path) {
+    struct sockaddr_un addr = {};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "[오류] 지표 소켓 경로가 너무 김: " << path << std::endl;
+        return -1;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        std::cerr << "[오류] 지표 소켓 생성 실패: " << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    // 이전 실행이 남긴 소켓 파일만 지움 (일반 파일은 건드리지 않음)
+    struct stat st;
+    if (lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+        unlink(path.c_str());
+    }
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, path.c_str(), path.size());
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 || listen(fd, 8) < 0) {
+        std::cerr << "[오류] 지표 소켓 바인딩 실패: " << path << ": " << strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+}  // namespace
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::start(const std::string& textfile, const std::string& socket, int interval) {
+    if (running || (textfile.empty() && socket.empty())) {
+        return false;
+    }
+    textfilePath = textfile;
+    socketPath = socket;
+    intervalMs = interval > 0 ? interval : kDefaultIntervalMs;
+
+    wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd < 0) {
+        std::cerr << "[오류] eventfd 생성 실패: " << strerror(errno) << std::endl;
+        return false;
+    }
+    if (!socketPath.empty()) {
+        listenFd = openListenSocket(socketPath);
+        if (listenFd < 0) {
+            close(wakeFd);
+            wakeFd = -1;
+            return false;
+        }
+    }
+    // 시작 시점에 한 번 써서 경로 오류를 바로 알림
+    if (!textfilePath.empty() && !writeTextfile()) {
+        std::cerr << "[오류] 지표 파일 쓰기 실패: " << textfilePath << ": " << strerror(errno) << std::endl;
+        stop();
+        return false;
+    }
+
+    writeError = false;
+    running = true;
+    exportThread = std::thread(&MetricsExporter::exportLoop, this);
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (running) {
+        running = false;
+        uint64_t one = 1;
+        (void)!write(wakeFd, &one, sizeof(one));
+        exportThread.join();
+        if (!textfilePath.empty()) {
+            writeTextfile();  // 마지막 값
+        }
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        listenFd = -1;
+        unlink(socketPath.c_str());
+    }
+    if (wakeFd >= 0) {
+        close(wakeFd);
+        wakeFd = -1;
+    }
+}
+
+void MetricsExporter::exportLoop() {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point nextWrite = Clock::now() + std::chrono::milliseconds(intervalMs);
+
+    while (running.load(std::memory_order_relaxed)) {
+        int timeoutMs = -1;
+        if (!textfilePath.empty()) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(nextWrite - Clock::now());
+            timeoutMs = static_cast<int>(std::max<int64_t>(remaining.count(), 0));
+        }
+
+        struct pollfd fds[2] = {{wakeFd, POLLIN, 0}, {listenFd, POLLIN, 0}};
+        int ready = poll(fds, listenFd >= 0 ? 2 : 1, timeoutMs);
+        if (ready < 0 && errno != EINTR) {
+            break;
+        }
+        if (ready > 0 && (fds[1].revents & POLLIN)) {
+            serveClient();
+        }
+        if (!textfilePath.empty() && Clock::now() >= nextWrite) {
+            if (!writeTextfile()) {
+                writeError.store(true, std::memory_order_relaxed);
+            }
+            nextWrite += std::chrono::milliseconds(intervalMs);
+            if (nextWrite < Clock::now()) {
+                nextWrite = Clock::now() + std::chrono::milliseconds(intervalMs);  // 밀린 주기는 건너뜀
+            }
+        }
+    }
+}
+
+bool MetricsExporter::writeTextfile() {
+    // 수집기가 쓰다 만 파일을 읽지 않도록 같은 디렉터리의 임시 파일에 쓰고 교체
+    std::string text = MetricsRegistry::instance().render();
+    std::string tempPath = textfilePath + ".tmp";
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = writeAll(fd, text.data(), text.size());
+    ok = (close(fd) == 0) && ok;
+    if (!ok || rename(tempPath.c_str(), textfilePath.c_str()) != 0) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void MetricsExporter::serveClient() {
+    int client = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (client < 0) {
+        return;
+    }
+    // 읽지 않는 클라이언트에 붙잡히지 않도록 송신 시간 제한
+    struct timeval timeout = {1, 0};
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    std::string text = MetricsRegistry::instance().render();
+    size_t offset = 0;
+    while (offset < text.size()) {
+        // 클라이언트가 먼저 끊어도 SIGPIPE로 종료되지 않도록
+        ssize_t n = send(client, text.data() + offset, text.size() - offset, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        offset += static_cast<size_t>(n);
+    }
+    close(client);
+}
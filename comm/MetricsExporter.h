@@ -0,0 +1,45 @@
+#ifndef METRICSEXPORTER_H
+#define METRICSEXPORTER_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+// MetricsRegistry 지표를 별도 스레드에서 내보냄 (채널 반응기 스레드는 관여하지 않음)
+//  - textfile: 주기마다 Prometheus 텍스트 형식 파일을 임시 파일 + rename으로 교체
+//              (node_exporter --collector.textfile.directory에 .prom 파일로 두면 수집됨)
+//  - socket:   Unix 소켓에 연결할 때마다 현재 지표를 한 번 쓰고 닫음
+//              (예: socat - UNIX-CONNECT:/tmp/vsensor.metrics)
+class MetricsExporter {
+public:
+    MetricsExporter() = default;
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // 경로가 비어 있으면 해당 방식은 사용 안 함 (둘 다 비어 있으면 false)
+    bool start(const std::string& textfilePath, const std::string& socketPath, int intervalMs = kDefaultIntervalMs);
+    void stop();
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+    bool writeFailed() const { return writeError.load(std::memory_order_relaxed); }
+
+    static constexpr int kDefaultIntervalMs = 1000;
+
+private:
+    void exportLoop();
+    bool writeTextfile();
+    void serveClient();
+
+    std::string textfilePath;
+    std::string socketPath;
+    int intervalMs{kDefaultIntervalMs};
+    int listenFd{-1};
+    int wakeFd{-1};  // eventfd: stop() 알림
+
+    std::atomic<bool> running{false};
+    std::atomic<bool> writeError{false};
+    std::thread exportThread;
+};
+
+#endif // METRICSEXPORTER_H
@@ -0,0 +1,132 @@
+#include "NMEAGenerator.h"
+#include "NMEAParser.h"
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+constexpr int64_t kTicksPerUnit = 10000;  // 소수점 4자리
+
+}  // namespace
+
+NMEAGenerator::NMEAGenerator(uint64_t seed) {
+    reseed(seed);
+}
+
+void NMEAGenerator::reseed(uint64_t seed) {
+    currentSeed = seed;
+    random.reseed(seed);
+}
+
+std::string_view NMEAGenerator::next() {
+    switch (random.uniform(0, 2)) {
+    case 0:
+        return generateGPGGA();
+    case 1:
+        return generateGPHDT();
+    default:
+        return generateGPVTG();
+    }
+}
+
+std::string_view NMEAGenerator::generateGPGGA() {
+    char* cursor = begin("$GPGGA,");
+
+    // UTC 시간 hhmmss.cc
+    cursor = writePadded2(cursor, static_cast<int>(random.uniform(0, 23)));
+    cursor = writePadded2(cursor, static_cast<int>(random.uniform(0, 59)));
+    cursor = writePadded2(cursor, static_cast<int>(random.uniform(0, 59)));
+    *cursor++ = '.';
+    cursor = writePadded2(cursor, static_cast<int>(random.uniform(0, 99)));
+    *cursor++ = ',';
+
+    cursor = writeFixed4(cursor, randomTicks(0, 90 * kTicksPerUnit));     // 위도
+    *cursor++ = ',';
+    *cursor++ = random.uniform(0, 1) == 0 ? 'N' : 'S';
+    *cursor++ = ',';
+    cursor = writeFixed4(cursor, randomTicks(0, 180 * kTicksPerUnit));    // 경도
+    *cursor++ = ',';
+    *cursor++ = random.uniform(0, 1) == 0 ? 'E' : 'W';
+    *cursor++ = ',';
+
+    cursor = writeInt(cursor, random.uniform(0, 2));                       // 고정 품질
+    *cursor++ = ',';
+    cursor = writeInt(cursor, random.uniform(0, 12));                      // 위성 수
+    *cursor++ = ',';
+    cursor = writeFixed4(cursor, randomTicks(0, 999 * kTicksPerUnit / 10));              // HDOP
+    *cursor++ = ',';
+    cursor = writeFixed4(cursor, randomTicks(-1000 * kTicksPerUnit, 10000 * kTicksPerUnit));  // 고도
+    memcpy(cursor, ",M,", 3);
+    cursor += 3;
+    cursor = writeFixed4(cursor, randomTicks(-99999 * kTicksPerUnit / 10, 99999 * kTicksPerUnit / 10));  // 지오이드 간격
+    memcpy(cursor, ",M,,", 4);  // DGPS 필드는 비워 둠
+    cursor += 4;
+
+    return finish(cursor);
+}
+
+std::string_view NMEAGenerator::generateGPHDT() {
+    char* cursor = begin("$GPHDT,");
+    cursor = writeFixed4(cursor, randomTicks(0, 360 * kTicksPerUnit));     // 헤딩
+    memcpy(cursor, ",T", 2);
+    cursor += 2;
+    return finish(cursor);
+}
+
+std::string_view NMEAGenerator::generateGPVTG() {
+    char* cursor = begin("$GPVTG,");
+    cursor = writeFixed4(cursor, randomTicks(0, 360 * kTicksPerUnit));     // 진북 트랙
+    memcpy(cursor, ",T,", 3);
+    cursor += 3;
+    cursor = writeFixed4(cursor, randomTicks(0, 360 * kTicksPerUnit));     // 자북 트랙
+    memcpy(cursor, ",M,", 3);
+    cursor += 3;
+    cursor = writeFixed4(cursor, randomTicks(0, 9999 * kTicksPerUnit / 10));  // 속도 (노트)
+    memcpy(cursor, ",N,", 3);
+    cursor += 3;
+    // 속도 (km/h) = 노트 * 1.852 (기존과 같이 별도 난수 사용)
+    cursor = writeFixed4(cursor, randomTicks(0, 9999 * kTicksPerUnit / 10) * 1852 / 1000);
+    memcpy(cursor, ",K", 2);
+    cursor += 2;
+    return finish(cursor);
+}
+
+char* NMEAGenerator::begin(const char* header) {
+    size_t length = strlen(header);
+    memcpy(buffer, header, length);
+    return buffer + length;
+}
+
+std::string_view NMEAGenerator::finish(char* cursor) {
+    uint8_t checksum = nmea::xorChecksum(buffer + 1, static_cast<size_t>(cursor - buffer - 1));
+    *cursor++ = '*';
+    nmea::writeChecksum(checksum, cursor);
+    cursor += 2;
+    return std::string_view(buffer, static_cast<size_t>(cursor - buffer));
+}
+
+char* NMEAGenerator::writeInt(char* cursor, int64_t value) {
+    return std::to_chars(cursor, cursor + 20, value).ptr;
+}
+
+char* NMEAGenerator::writePadded2(char* cursor, int value) {
+    cursor[0] = static_cast<char>('0' + value / 10);
+    cursor[1] = static_cast<char>('0' + value % 10);
+    return cursor + 2;
+}
+
+char* NMEAGenerator::writeFixed4(char* cursor, int64_t ticks) {
+    if (ticks < 0) {
+        *cursor++ = '-';
+        ticks = -ticks;
+    }
+    cursor = writeInt(cursor, ticks / kTicksPerUnit);
+    *cursor++ = '.';
+
+    int fraction = static_cast<int>(ticks % kTicksPerUnit);
+    cursor[0] = static_cast<char>('0' + fraction / 1000);
+    cursor[1] = static_cast<char>('0' + fraction / 100 % 10);
+    cursor[2] = static_cast<char>('0' + fraction / 10 % 10);
+    cursor[3] = static_cast<char>('0' + fraction % 10);
+    return cursor + 4;
+}
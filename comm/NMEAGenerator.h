@@ -0,0 +1,40 @@
+#ifndef NMEAGENERATOR_H
+#define NMEAGENERATOR_H
+
+#include "FastRandom.h"
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+// GPGGA / GPHDT / GPVTG 문장 생성기
+// 한 스레드(송신 스레드)에서만 사용한다. 결과는 내부 고정 버퍼를 가리키며
+// 다음 호출 전까지만 유효하다. 실수 필드는 소수점 4자리 고정소수 정수로 뽑아
+// std::to_chars로 바로 기록하므로 할당 / 시스템 호출이 없다.
+class NMEAGenerator {
+public:
+    static constexpr size_t kMaxSentenceLength = 96;
+
+    explicit NMEAGenerator(uint64_t seed);
+
+    void reseed(uint64_t seed);
+    uint64_t seed() const { return currentSeed; }
+
+    std::string_view next();  // 세 종류 중 무작위 선택
+    std::string_view generateGPGGA();
+    std::string_view generateGPHDT();
+    std::string_view generateGPVTG();
+
+private:
+    char* begin(const char* header);              // "$GPxxx," 기록 후 커서 반환
+    std::string_view finish(char* cursor);        // "*HH" 추가
+    static char* writeInt(char* cursor, int64_t value);
+    static char* writePadded2(char* cursor, int value);
+    static char* writeFixed4(char* cursor, int64_t ticks);  // ticks / 10^4 를 "%.4f" 형식으로
+    int64_t randomTicks(int64_t minTicks, int64_t maxTicks) { return random.uniform(minTicks, maxTicks); }
+
+    FastRandom random;
+    uint64_t currentSeed;
+    char buffer[kMaxSentenceLength];
+};
+
+#endif // NMEAGENERATOR_H
@@ -0,0 +1,144 @@
+#include "NMEAParser.h"
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace nmea {
+
+namespace {
+
+int hexValue(char ch) {
+    if (ch >= '0' && ch <= '9') return ch - '0';
+    if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+    if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+    return -1;
+}
+
+SentenceType classify(uint64_t address) {
+    switch (address) {
+    case addressCode("GPGGA"):
+        return SentenceType::GGA;
+    case addressCode("GPHDT"):
+        return SentenceType::HDT;
+    case addressCode("GPVTG"):
+        return SentenceType::VTG;
+    default:
+        return SentenceType::Unknown;
+    }
+}
+
+#if defined(__SSE2__)
+// 16바이트 XOR 누산값을 1바이트로 접기
+uint8_t foldXor(__m128i value) {
+    value = _mm_xor_si128(value, _mm_srli_si128(value, 8));
+    value = _mm_xor_si128(value, _mm_srli_si128(value, 4));
+    value = _mm_xor_si128(value, _mm_srli_si128(value, 2));
+    value = _mm_xor_si128(value, _mm_srli_si128(value, 1));
+    return static_cast<uint8_t>(_mm_cvtsi128_si32(value));
+}
+#endif
+
+}  // namespace
+
+uint8_t xorChecksum(const char* data, size_t length) {
+    uint8_t checksum = 0;
+    size_t i = 0;
+#if defined(__SSE2__)
+    if (length >= 16) {
+        __m128i acc = _mm_setzero_si128();
+        for (; i + 16 <= length; i += 16) {
+            acc = _mm_xor_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+        }
+        checksum = foldXor(acc);
+    }
+#endif
+    for (; i < length; ++i) {
+        checksum ^= static_cast<uint8_t>(data[i]);
+    }
+    return checksum;
+}
+
+ParseResult parse(std::string_view line, Sentence& out) {
+    const char* dollar = static_cast<const char*>(memchr(line.data(), '$', line.size()));
+    if (dollar == nullptr) {
+        return ParseResult::NoStart;
+    }
+
+    const char* body = dollar + 1;
+    size_t remaining = static_cast<size_t>(line.data() + line.size() - body);
+    if (remaining > std::numeric_limits<uint16_t>::max()) {
+        return ParseResult::TooLong;
+    }
+
+    // 체크섬 누적과 ',' 위치 기록을 한 번의 순회로 처리
+    uint8_t checksum = 0;
+    size_t fieldCount = 0;
+    size_t star = std::string_view::npos;
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    // '*'가 없는 16바이트 블록은 비교 마스크로 ','를 찾고 XOR를 벡터로 누적
+    const __m128i commaChar = _mm_set1_epi8(',');
+    const __m128i starChar = _mm_set1_epi8('*');
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 16 <= remaining; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(body + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(block, starChar)) != 0) {
+            break;  // '*'가 있는 블록부터는 스칼라로 마무리
+        }
+        unsigned commaMask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, commaChar)));
+        while (commaMask != 0) {
+            if (fieldCount == Sentence::kMaxFields - 1) {
+                return ParseResult::TooManyFields;
+            }
+            out.fieldEnd[fieldCount++] = static_cast<uint16_t>(i + __builtin_ctz(commaMask));
+            commaMask &= commaMask - 1;
+        }
+        acc = _mm_xor_si128(acc, block);
+    }
+    checksum = foldXor(acc);
+#endif
+
+    for (; i < remaining; ++i) {
+        char ch = body[i];
+        if (ch == '*') {
+            star = i;
+            break;
+        }
+        if (ch == ',') {
+            if (fieldCount == Sentence::kMaxFields - 1) {
+                return ParseResult::TooManyFields;
+            }
+            out.fieldEnd[fieldCount++] = static_cast<uint16_t>(i);
+        }
+        checksum ^= static_cast<uint8_t>(ch);
+    }
+
+    if (star == std::string_view::npos || star == 0) {
+        return ParseResult::NoChecksum;
+    }
+    out.fieldEnd[fieldCount++] = static_cast<uint16_t>(star);  // 마지막 필드는 '*'에서 끝남
+
+    // '*' 뒤는 정확히 16진수 2자리
+    if (remaining - star != 3) {
+        return ParseResult::BadChecksumFormat;
+    }
+    int high = hexValue(body[star + 1]);
+    int low = hexValue(body[star + 2]);
+    if (high < 0 || low < 0) {
+        return ParseResult::BadChecksumFormat;
+    }
+
+    out.body = std::string_view(body, star);
+    out.checksum = static_cast<uint8_t>((high << 4) | low);
+    out.fieldCount = static_cast<uint8_t>(fieldCount);
+    out.address = addressCode(out.field(0));
+    out.type = classify(out.address);
+
+    return (checksum == out.checksum) ? ParseResult::Ok : ParseResult::ChecksumMismatch;
+}
+
+}  // namespace nmea
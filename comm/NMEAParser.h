@@ -0,0 +1,79 @@
+#ifndef NMEAPARSER_H
+#define NMEAPARSER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+// 할당 없는 단일 패스 NMEA 0183 파서
+// "[접두어]$<주소>,<필드>,...*HH" 한 줄을 검사하면서 체크섬 계산과 필드 분리를 동시에 한다.
+// 결과는 원본 버퍼를 가리키는 string_view와 고정 크기 오프셋 배열로만 표현된다.
+namespace nmea {
+
+enum class SentenceType : uint8_t {
+    Unknown,
+    GGA,
+    HDT,
+    VTG
+};
+
+enum class ParseResult : uint8_t {
+    Ok,
+    NoStart,           // '$' 없음
+    NoChecksum,        // '*' 없음 또는 본문이 비어 있음
+    BadChecksumFormat, // '*' 뒤가 16진수 2자리가 아님
+    ChecksumMismatch,
+    TooManyFields,
+    TooLong            // 필드 오프셋(uint16_t)으로 표현할 수 없는 길이
+};
+
+// 주소 필드(토커 + 타입, 예: "GPGGA")를 switch에 쓸 수 있는 정수로 패킹
+constexpr uint64_t addressCode(std::string_view address) {
+    uint64_t code = 0;
+    for (size_t i = 0; i < address.size() && i < 8; ++i) {
+        code = (code << 8) | static_cast<uint8_t>(address[i]);
+    }
+    return code;
+}
+
+struct Sentence {
+    static constexpr size_t kMaxFields = 32;
+
+    std::string_view body;    // '$' 다음부터 '*' 직전까지 (체크섬 계산 범위)
+    uint64_t address;         // addressCode(field(0))
+    SentenceType type;
+    uint8_t checksum;         // 문장에 적힌 체크섬
+    uint8_t fieldCount;       // 필드 0 = 주소 필드
+    uint16_t fieldEnd[kMaxFields];  // body 기준 각 필드의 끝 위치 (',' 또는 '*' 위치)
+
+    std::string_view field(size_t index) const {
+        if (index >= fieldCount) {
+            return {};
+        }
+        size_t begin = (index == 0) ? 0 : fieldEnd[index - 1] + 1u;
+        return body.substr(begin, fieldEnd[index] - begin);
+    }
+};
+
+// '$'~'*' 사이의 XOR 체크섬 (긴 입력은 SSE2로 16바이트씩 처리)
+uint8_t xorChecksum(const char* data, size_t length);
+
+// 체크섬 값을 대문자 16진수 2자리로 기록
+inline void writeChecksum(uint8_t checksum, char* out) {
+    static constexpr char kHex[] = "0123456789ABCDEF";
+    out[0] = kHex[checksum >> 4];
+    out[1] = kHex[checksum & 0x0F];
+}
+
+// line: 줄바꿈이 제거된 한 줄 ('$' 앞의 타임스탬프 등은 무시)
+// Ok가 아니면 out 내용은 정의되지 않는다.
+ParseResult parse(std::string_view line, Sentence& out);
+
+inline bool verify(std::string_view line) {
+    Sentence sentence;
+    return parse(line, sentence) == ParseResult::Ok;
+}
+
+}  // namespace nmea
+
+#endif // NMEAPARSER_H
@@ -0,0 +1,65 @@
+#ifndef PERIODICSCHEDULER_H
+#define PERIODICSCHEDULER_H
+
+#include "LatencyHistogram.h"
+#include "EventReactor.h"
+#include <atomic>
+#include <cstdint>
+
+// 주기 초과(작업 시간 > 주기) 시 처리 방식
+enum class OverrunPolicy {
+    Skip,     // 놓친 주기는 건너뛰고 다음 정렬된 데드라인부터 (기본)
+    CatchUp   // 대기 없이 연속 실행해서 놓친 주기를 따라잡음 (최대 kMaxCatchUpPeriods)
+};
+
+// 주기 스케줄러 통계 (단위: ns)
+struct SchedulerStats {
+    int64_t periodNs;
+    uint64_t ticks;           // 실행된 주기 수
+    uint64_t overruns;        // 작업이 다음 데드라인을 넘긴 횟수
+    uint64_t skippedPeriods;  // Skip 정책 / 따라잡기 한도 초과로 건너뛴 주기 수
+    HistogramSummary wakeupLatency;  // 데드라인 대비 실제 깨어난 시각 (지터)
+};
+
+// 절대 데드라인 기반 주기 실행기
+// 데드라인을 "이전 데드라인 + 주기"로 계산하므로 작업 시간이나 깨어남 지연이 다음 주기에 누적되지 않는다.
+// 이벤트 루프에서 armTimer()로 timerfd를 설정하고 타이머 핸들러에서 onTimerExpired() 호출
+// 실행 쪽 함수는 한 스레드에서만 호출하고, 설정 / 통계 조회는 다른 스레드에서 가능하다.
+class PeriodicScheduler {
+public:
+    static constexpr int64_t kMinPeriodNs = 100000;        // 100us
+    static constexpr int64_t kMaxCatchUpPeriods = 1000;
+
+    explicit PeriodicScheduler(int64_t periodNs, OverrunPolicy policy = OverrunPolicy::Skip);
+
+    void setPeriod(int64_t periodNs);  // kMinPeriodNs 이상으로 제한, 다음 데드라인부터 적용
+    int64_t period() const { return periodNs.load(std::memory_order_relaxed); }
+    void setPolicy(OverrunPolicy policy);
+    OverrunPolicy policy() const { return overrunPolicy.load(std::memory_order_relaxed); }
+
+    // timerfd를 "지금 + 주기"부터 주기 간격으로 설정
+    bool armTimer(TimerFd& timer);
+    // 만료 처리 후 이번에 실행할 작업 횟수 반환 (Skip: 1, CatchUp: 1 + 놓친 주기 수, 만료 전: 0)
+    // 주기가 바뀌었으면 마지막 데드라인 기준으로 timerfd를 다시 설정한다.
+    uint64_t onTimerExpired(TimerFd& timer);
+
+    SchedulerStats stats() const;
+    void resetStats();
+
+    static int64_t monotonicNs();
+
+private:
+    void reset();  // 현재 시각을 기준 데드라인으로 설정
+
+    std::atomic<int64_t> periodNs;
+    std::atomic<OverrunPolicy> overrunPolicy;
+    int64_t deadlineNs{0};  // 실행 스레드 전용
+    int64_t armedPeriodNs{0};  // timerfd에 설정된 주기 (실행 스레드 전용)
+
+    std::atomic<uint64_t> ticks{0};
+    std::atomic<uint64_t> overruns{0};
+    std::atomic<uint64_t> skippedPeriods{0};
+    LatencyHistogram wakeupLatency;
+};
+
+#endif // PERIODICSCHEDULER_H
@@ -1,320 +1,422 @@
 #include "RS232Communication.h"
-#include <fstream>
+#include "NMEAParser.h"
+#include <sys/epoll.h>
+#include <cerrno>
 #include <chrono>
-#include <thread>
-#include <sstream>
-#include <iomanip>
+#include <ctime>
 #include <mutex>
-#include <regex>
+#include <algorithm>
+#include <cstring>
 
 RS232Communication::RS232Communication(const std::string& sendPort, const std::string& receivePort)
-    : sendPort(sendPort), receivePort(receivePort){}
+    : sendPort(sendPort), receivePort(receivePort), generator(std::random_device{}()) {
+    txPending.reserve(kMaxPendingBytes);
+    MetricsRegistry::instance().add(this);
+}
 
 RS232Communication::~RS232Communication() {
+    MetricsRegistry::instance().remove(this);
     stop();
 }
 
 
-void RS232Communication::run() {
-    std::thread sender(&RS232Communication::sendData, this);
-    std::thread receiver(&RS232Communication::receiveData, this);
-    std::thread statusUpdater(&RS232Communication::monitorConnection, this);
+bool RS232Communication::attach(EventReactor& eventReactor) {
+    if (!sendTimer.open() || !statusTimer.open()) {
+        std::cerr << "[오류] timerfd 생성 실패: " << strerror(errno) << std::endl;
+        sendTimer.close();
+        statusTimer.close();
+        return false;
+    }
+    sendScheduler.armTimer(sendTimer);
+    statusTimer.setRelative(kStatusIntervalNs, kStatusIntervalNs);
 
-    sender.join();
-    receiver.join();
-    statusUpdater.join();
-}
+    eventReactor.add(sendTimer.nativeHandle(), EPOLLIN, [this](uint32_t) { onSendTimer(); });
+    eventReactor.add(statusTimer.nativeHandle(), EPOLLIN, [this](uint32_t) { monitorConnection(); });
 
-void RS232Communication::sendData() {
-    while (connected) {
-        std::string data = generateNMEAData();
-        std::string timestamp = getCurrentTimestamp();
+    // 수신 포트를 열지 못하면 상태 타이머에서 다시 시도
+    openReceivePort();
+    return true;
+}
 
-        // 가상 직렬 포트에 데이터 전송
-        std::ofstream serialPort(sendPort);
-        if (serialPort.is_open()) {
-            serialPort << timestamp << " - " << data << std::endl;
-            std::lock_guard<std::mutex> lock(dataMutex);
-            receivedData.push_back(timestamp + " - " + data);
+void RS232Communication::detach() {
+    reactor->remove(sendTimer.nativeHandle());
+    reactor->remove(statusTimer.nativeHandle());
+    sendTimer.close();
+    statusTimer.close();
+    closeReceivePort();
+    closeTransmitPort();
+}
 
-            // 송신 데이터 출력
-            std::cout << "[RS232 송신] " << timestamp << " - " << data << std::endl;
-            serialPort.close();
-        } else {
-            std::cerr << "RS232 포트를 열 수 없습니다: " << sendPort << std::endl;
-        }
+void RS232Communication::onTransitionFinished(const ChannelTransition& result) {
+    emit transitionFinished(result.connected, result.elapsedNs);
+}
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(sendIntervalMs));  // 송신 간격
+bool RS232Communication::ensurePortOpen(SerialPort& port, const std::string& path, LogEvent failureEvent) {
+    if (port.isOpen()) {
+        return true;
+    }
+    if (port.open(path, baudRate.load())) {
+        return true;
     }
+
+    AsyncLogger::instance().log(LogLevel::Error, LogChannel::RS232, failureEvent, 0, nullptr, 0, errno);
+    (failureEvent == LogEvent::SendFailed ? writeFailures : receiveFailures).add();
+    return false;
 }
 
-void RS232Communication::receiveData() {
-    while (connected) {
-        std::ifstream serialPort(receivePort);
-        if (serialPort.is_open()) {
-            std::string receivedMessage;
-            while (std::getline(serialPort, receivedMessage)) {
-                std::string timestamp = getCurrentTimestamp();
-
-                if (verifyChecksum(receivedMessage)) {
-                    std::cout << "[RS232 수신] " << timestamp << " - " << receivedMessage << std::endl;
-                    printNMEAMessage(receivedMessage);
-                    lastReceivedTime = timestamp;
-                    lastReceivedTimestamp = std::chrono::system_clock::now();
-                } else {
-                    std::cerr << "[RS232 수신 오류] 잘못된 체크섬: " << receivedMessage << std::endl;
-                }
-            }
-            serialPort.close();
-        } else {
-            std::cerr << "RS232 포트를 열 수 없습니다: " << receivePort << std::endl;
-        }
+bool RS232Communication::openReceivePort() {
+    if (!ensurePortOpen(rxPort, receivePort, LogEvent::ReceiveFailed)) {
+        return false;
+    }
+    rxFramer.reset();
+    reactor->add(rxPort.nativeHandle(), EPOLLIN, [this](uint32_t events) { handleReceiveReady(events); });
+    return true;
+}
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));  // 수신 대기 시간
+void RS232Communication::closeReceivePort() {
+    if (rxPort.isOpen()) {
+        reactor->remove(rxPort.nativeHandle());
+        rxPort.close();
     }
+    rxFramer.reset();
 }
 
-void RS232Communication::printNMEAMessage(const std::string& message) {
-    std::size_t gpgga_pos = message.find("$GPGGA");
-    std::size_t gphdt_pos = message.find("$GPHDT");
-    std::size_t gpvtg_pos = message.find("$GPVTG");
+void RS232Communication::closeTransmitPort() {
+    if (txWaitingWritable) {
+        reactor->remove(txPort.nativeHandle());
+        txWaitingWritable = false;
+    }
+    txPort.close();
+    txPending.clear();
+    txPendingOffset = 0;
+    txPendingBytes.store(0, std::memory_order_relaxed);
+}
 
-    QString data;
+void RS232Communication::onSendTimer() {
+    // Skip 정책이면 1회, CatchUp 정책이면 놓친 주기만큼 연속 송신
+    uint64_t runs = sendScheduler.onTimerExpired(sendTimer);
+    for (uint64_t r = 0; r < runs && connected && rs232SendEnabled; ++r) {
+        sendSentence();
+    }
+}
 
-    if (gpgga_pos != std::string::npos) {
-        // GPGGA 메시지 처리
-        std::string cleanedMessage = message.substr(gpgga_pos);
-        std::vector<std::string> fields = parseNMEAMessage(cleanedMessage);
+void RS232Communication::sendSentence() {
+    queueSentence(generator.next());
+}
 
-        if (fields.size() >= 15) {
-            data += "[GPGGA 포맷]\n";
-            data += "   - UTC 시간: " + QString::fromStdString(fields[1]) + "\n";
-            data += "   - 위도: " + QString::fromStdString(fields[2]) + " " + QString::fromStdString(fields[3]) + "\n";
-            data += "   - 경도: " + QString::fromStdString(fields[4]) + " " + QString::fromStdString(fields[5]) + "\n";
-            data += "   - 고정 품질: " + QString::fromStdString(fields[6]) + "\n";
-            data += "   - 사용 중 위성 수: " + QString::fromStdString(fields[7]) + "\n";
-            data += "   - HDOP: " + QString::fromStdString(fields[8]) + "\n";
-            data += "   - 고도: " + QString::fromStdString(fields[9]) + " " + QString::fromStdString(fields[10]) + "\n";
-            data += "   - 지구 표면 간격: " + QString::fromStdString(fields[11]) + " " + QString::fromStdString(fields[12]) + "\n";
-            data += "   - DGPS 데이터 지연: " + QString::fromStdString(fields[13]) + "\n";
-            data += "   - DGPS 기준 ID: " + QString::fromStdString(fields[14]) + "\n";
+void RS232Communication::replaySentence(std::string_view sentence) {
+    // 재생 스레드 -> 반응기 스레드 (직렬 포트 속도상 문장 수가 적어 복사 비용은 무시 가능)
+    if (!connected || reactor == nullptr) {
+        return;
+    }
+    reactor->post([this, text = std::string(sentence)] {
+        if (connected) {
+            queueSentence(text);
         }
-    } else if (gphdt_pos != std::string::npos) {
-        // GPHDT 메시지 처리
-        std::string cleanedMessage = message.substr(gphdt_pos);
-        std::vector<std::string> fields = parseNMEAMessage(cleanedMessage);
+    });
+}
 
-        if (fields.size() >= 3) {
-            data += "[GPHDT 포맷]\n";
-            data += "   - 헤딩: " + QString::fromStdString(fields[1]) + " 도\n";
-            data += "   - 방향: " + QString::fromStdString(fields[2]) + "\n";
-        }
-    } else if (gpvtg_pos != std::string::npos) {
-        // GPVTG 메시지 처리
-        std::string cleanedMessage = message.substr(gpvtg_pos);
-        std::vector<std::string> fields = parseNMEAMessage(cleanedMessage);
+void RS232Communication::queueSentence(std::string_view data) {
+    // 가상 직렬 포트 (열린 포트 재사용, 오류 시 닫고 다음 주기에 다시 열기)
+    if (!ensurePortOpen(txPort, sendPort, LogEvent::SendFailed)) {
+        return;
+    }
 
-        if (fields.size() >= 9) {
-            data += "[GPVTG 포맷]\n";
-            data += "   - 진북 기준 트랙 각도: " + QString::fromStdString(fields[1]) + " 도\n";
-            data += "   - 속도 (노트): " + QString::fromStdString(fields[5]) + " 노트\n";
-            data += "   - 속도 (킬로미터/시간): " + QString::fromStdString(fields[7]) + " km/h\n";
-        }
-    } else {
-        data += "[알 수 없는 포맷]\n";
+    // "타임스탬프 - 문장\n"을 고정 버퍼에 조립
+    char line[kMaxTimestampLength + 3 + NMEAGenerator::kMaxSentenceLength + 1];
+    size_t length = formatTimestamp(line, kMaxTimestampLength);
+    memcpy(line + length, " - ", 3);
+    length += 3;
+    data = data.substr(0, NMEAGenerator::kMaxSentenceLength);
+    memcpy(line + length, data.data(), data.size());
+    length += data.size();
+    line[length] = '\n';
+
+    // 상대편이 읽지 않아 대기열이 가득 차면 이번 문장은 버림
+    if (txPending.size() - txPendingOffset + length + 1 > kMaxPendingBytes) {
+        AsyncLogger::instance().log(LogLevel::Warning, LogChannel::RS232, LogEvent::SendFailed, 0,
+                                    nullptr, 0, ENOBUFS);
+        sentencesDropped.add();
+        return;
     }
+    txPending.insert(txPending.end(), line, line + length + 1);
+    sentencesSent.add();
+
+    sentSentences.append(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::system_clock::now().time_since_epoch()).count(),
+                         data);
+
+    // 송신 데이터 출력 (포맷팅은 로거 백그라운드 스레드에서)
+    AsyncLogger::instance().log(LogLevel::Info, LogChannel::RS232, LogEvent::SentenceSent, 0,
+                                data.data(), data.size());
 
-    emit dataReceived(data);
+    flushTransmit();
 }
 
-std::vector<std::string> RS232Communication::parseNMEAMessage(const std::string& message) {
-    std::vector<std::string> fields;
-    std::stringstream ss(message);
-    std::string field;
-    while (std::getline(ss, field, ',')) {
-        if (field.empty()) {
-            fields.push_back("<빈 값>");
-        } else {
-            fields.push_back(field);
+void RS232Communication::flushTransmit() {
+    while (txPendingOffset < txPending.size()) {
+        ssize_t written = txPort.writeSome(txPending.data() + txPendingOffset, txPending.size() - txPendingOffset);
+        if (written < 0) {
+            AsyncLogger::instance().log(LogLevel::Error, LogChannel::RS232, LogEvent::SendFailed, 0,
+                                        nullptr, 0, errno);
+            writeFailures.add();
+            closeTransmitPort();
+            return;
         }
+        if (written == 0) {
+            break;  // 출력 버퍼 가득 참
+        }
+        txPendingOffset += static_cast<size_t>(written);
+    }
+    txPendingBytes.store(txPending.size() - txPendingOffset, std::memory_order_relaxed);
+
+    if (txPendingOffset == txPending.size()) {
+        txPending.clear();
+        txPendingOffset = 0;
+        if (txWaitingWritable) {
+            reactor->remove(txPort.nativeHandle());
+            txWaitingWritable = false;
+        }
+    } else if (!txWaitingWritable) {
+        // 쓸 수 있게 되면 나머지를 이어서 씀
+        txWaitingWritable = reactor->add(txPort.nativeHandle(), EPOLLOUT, [this](uint32_t events) {
+            if (events & (EPOLLERR | EPOLLHUP)) {
+                AsyncLogger::instance().log(LogLevel::Error, LogChannel::RS232, LogEvent::SendFailed, 0,
+                                            nullptr, 0, EIO);
+                writeFailures.add();
+                closeTransmitPort();
+                return;
+            }
+            flushTransmit();
+        });
     }
-    return fields;
 }
 
-std::string RS232Communication::generateNMEAData() {
-    std::random_device rd;
-    std::uniform_int_distribution<> dist(0, 2);
+void RS232Communication::handleReceiveReady(uint32_t events) {
+    char buffer[4096];
+
+    bool portError = (events & EPOLLERR) != 0;
+    if (events & (EPOLLIN | EPOLLHUP)) {
+        // 데이터가 도착하는 즉시 읽어 프레이머에 전달
+        ssize_t n = 0;
+        for (int reads = 0; reads < kMaxReadsPerEvent; ++reads) {
+            n = rxPort.readAvailable(buffer, sizeof(buffer));
+            if (n <= 0) {
+                break;
+            }
+            rxFramer.feed(buffer, static_cast<size_t>(n), [this](std::string_view line) {
+                handleReceivedLine(line);
+            });
+        }
+        // EPOLLHUP인데 읽을 데이터가 없으면 상대편이 닫힌 것 (레벨 트리거로 계속 깨어나지 않도록 닫음)
+        portError = portError || n < 0 || ((events & EPOLLHUP) && n == 0);
+    }
 
-    switch (dist(rd)) {
-    case 0:
-        return generateGPGGA();
-    case 1:
-        return generateGPHDT();
-    case 2:
-        return generateGPVTG();
-    default:
-        return "";
+    if (portError) {
+        // 연결 끊김 / 오류: 닫고 상태 타이머에서 다시 열기
+        AsyncLogger::instance().log(LogLevel::Error, LogChannel::RS232, LogEvent::ReceiveFailed, 0,
+                                    nullptr, 0, errno);
+        receiveFailures.add();
+        closeReceivePort();
     }
 }
 
-std::string RS232Communication::generateGPGGA() {
-    int hours = generateRandomInt(0, 23);
-    int minutes = generateRandomInt(0, 59);
-    int seconds = generateRandomInt(0, 59);
-    int milliseconds = generateRandomInt(0, 99);
-
-    double latitude = generateRandomDouble(0.0, 90.0);
-    char lat_dir = (generateRandomInt(0, 1) == 0) ? 'N' : 'S';
-    double longitude = generateRandomDouble(0.0, 180.0);
-    char lon_dir = (generateRandomInt(0, 1) == 0) ? 'E' : 'W';
-
-    std::string fix = std::to_string(generateRandomInt(0, 2));
-    std::string nsat = std::to_string(generateRandomInt(0, 12));
-    std::string hdop = formatDouble(generateRandomDouble(0.0, 99.9));
-    std::string altitude = formatDouble(generateRandomDouble(-1000.0, 10000.0));
-    std::string sep = formatDouble(generateRandomDouble(-9999.9, 9999.9));
-    std::string dgps_age = formatDouble(generateRandomDouble(0.0, 999.9));
-    std::string dgps_id = std::to_string(generateRandomInt(0, 1023));
-
-    std::ostringstream oss;
-    oss << "$GPGGA,"
-        << std::setw(2) << std::setfill('0') << hours
-        << std::setw(2) << std::setfill('0') << minutes
-        << std::setw(2) << std::setfill('0') << seconds
-        << "." << std::setw(2) << std::setfill('0') << milliseconds << ","
-        << std::fixed << std::setprecision(4) << latitude << "," << lat_dir << ","
-        << std::fixed << std::setprecision(4) << longitude << "," << lon_dir << ","
-        << fix << ","
-        << nsat << ","
-        << hdop << ","
-        << altitude << ",M," << sep << ",M,,"
-        << "*" << calculateChecksum(oss.str());
-
-    return oss.str();
-}
-
-std::string RS232Communication::generateGPHDT() {
-    std::random_device rd;
-    std::uniform_real_distribution<> dist(0.0, 360.0);
-    std::ostringstream oss;
-    oss << "$GPHDT," << formatDouble(dist(rd)) << ",T*" << calculateChecksum(oss.str());
-    return oss.str();
-}
-
-std::string RS232Communication::generateGPVTG() {
-    std::random_device rd;
-    std::uniform_real_distribution<> dist(0.0, 360.0);
-    std::uniform_real_distribution<> speedDist(0.0, 999.9);
-    std::ostringstream oss;
-    oss << "$GPVTG," << formatDouble(dist(rd)) << ",T,"
-        << formatDouble(dist(rd)) << ",M,"
-        << formatDouble(speedDist(rd)) << ",N,"
-        << formatDouble(speedDist(rd) * 1.852) << ",K*"
-        << calculateChecksum(oss.str());
-    return oss.str();
-}
-
-std::string RS232Communication::getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&now_c), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
-}
+void RS232Communication::handleReceivedLine(std::string_view receivedMessage) {
+    // 기록은 체크섬 검증 전의 NMEA 문장 원문 ('$' 앞의 송신 타임스탬프 제외)
+    if (recorderTap) {
+        size_t start = receivedMessage.find('$');
+        recorderTap->recordNMEA(receivedMessage.substr(start == std::string_view::npos ? 0 : start),
+                                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::system_clock::now().time_since_epoch()).count());
+    }
 
-void RS232Communication::monitorConnection() {
-    while (connected) {
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        auto now = std::chrono::system_clock::now();
-        std::chrono::duration<double> elapsed_seconds = now - lastReceivedTimestamp;
-
-        QString statusText;
-        if (elapsed_seconds.count() < 2) {
-            statusText = "양호";
-        } else if (elapsed_seconds.count() < 5) {
-            statusText = "미흡";
-        } else {
-            statusText = "끊김";
-        }
 
-        // 시그널 발송
-        emit connectionStatusChanged(statusText);
+    if (verifyChecksum(receivedMessage)) {
+        AsyncLogger::instance().log(LogLevel::Info, LogChannel::RS232, LogEvent::SentenceReceived, 0,
+                                    receivedMessage.data(), receivedMessage.size());
+        pushReceivedRecord(receivedMessage);
+        sentencesReceived.add();
+        char timestamp[kMaxTimestampLength];
+        lastReceivedTime.assign(timestamp, formatTimestamp(timestamp, sizeof(timestamp)));
+        lastReceivedTimestamp = std::chrono::system_clock::now();
+    } else {
+        AsyncLogger::instance().log(LogLevel::Warning, LogChannel::RS232, LogEvent::ChecksumMismatch, 0,
+                                    receivedMessage.data(), receivedMessage.size());
+        checksumErrors.add();
     }
 }
 
-std::string RS232Communication::formatDouble(double val) {
-    std::stringstream ss;
-    ss << std::fixed << std::setprecision(4) << val;
-    return ss.str();
+void RS232Communication::pushReceivedRecord(std::string_view message) {
+    CommRecord record;
+    record.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    record.id = 0;
+    record.channel = RecordChannel::RS232;
+    record.sampleIndex = 0;
+    record.sampleCount = 1;
+    record.bus = 0;
+
+    // '$' 앞의 타임스탬프 부분은 버리고 NMEA 문장만 저장
+    size_t start = message.find('$');
+    if (start == std::string_view::npos) {
+        start = 0;
+    }
+    size_t length = std::min<size_t>(message.size() - start, CommRecord::kMaxText);
+    record.length = static_cast<uint8_t>(length);
+    memcpy(record.text, message.data() + start, length);
+
+    // UI 링에 넣기만 하고 포맷팅은 UI 스레드에서 (가득 차면 버림)
+    uiRing.tryPush(record);
 }
 
-int RS232Communication::generateRandomInt(int min, int max) {
-    std::random_device rd;
-    std::uniform_int_distribution<> dist(min, max);
-    return dist(rd);
+size_t RS232Communication::drainRecords(CommRecord* out, size_t maxRecords) {
+    return uiRing.popBatch(out, maxRecords);
 }
 
-double RS232Communication::generateRandomDouble(double min, double max) {
-    std::random_device rd;
-    std::uniform_real_distribution<> dist(min, max);
-    return dist(rd);
+uint64_t RS232Communication::droppedRecords() const {
+    return uiRing.dropped();
 }
 
-std::string RS232Communication::calculateChecksum(const std::string& sentence) {
-    unsigned char checksum = 0;
-    bool start = false;
+RS232TrafficStats RS232Communication::trafficStats() const {
+    return {sentencesSent.load(), sentencesDropped.load(), sentencesReceived.load(), checksumErrors.load(),
+            writeFailures.load()};
+}
 
-    for (char ch : sentence) {
-        if (ch == '$') {
-            start = true;
-            continue;
-        }
-        if (ch == '*') break;
+void RS232Communication::collectMetrics(MetricsWriter& writer) const {
+    std::string labels;
+    MetricsWriter::label(labels, "send_port", sendPort);
+    MetricsWriter::label(labels, "receive_port", receivePort);
+
+    writer.sample("vsensor_rs232_sentences_sent_total", MetricType::Counter, "송신 대기열에 넣은 NMEA 문장 수",
+                  labels, sentencesSent.load());
+    writer.sample("vsensor_rs232_sentences_dropped_total", MetricType::Counter, "송신 대기열이 가득 차서 버린 문장 수",
+                  labels, sentencesDropped.load());
+    writer.sample("vsensor_rs232_sentences_received_total", MetricType::Counter, "체크섬이 맞는 수신 문장 수",
+                  labels, sentencesReceived.load());
+    writer.sample("vsensor_rs232_checksum_failures_total", MetricType::Counter, "체크섬 불일치 수신 문장 수",
+                  labels, checksumErrors.load());
+    writer.sample("vsensor_rs232_write_failures_total", MetricType::Counter, "송신 포트 열기 / 쓰기 실패 수",
+                  labels, writeFailures.load());
+    writer.sample("vsensor_rs232_receive_failures_total", MetricType::Counter, "수신 포트 열기 / 읽기 실패 수",
+                  labels, receiveFailures.load());
+    writer.sample("vsensor_rs232_tx_pending_bytes", MetricType::Gauge, "포트에 아직 쓰지 못한 송신 바이트", labels,
+                  txPendingBytes.load(std::memory_order_relaxed));
+
+    SchedulerStats scheduler = sendScheduler.stats();
+    writer.sample("vsensor_rs232_send_overruns_total", MetricType::Counter, "송신 작업이 다음 주기를 넘긴 횟수",
+                  labels, scheduler.overruns);
+    writer.sample("vsensor_rs232_send_skipped_periods_total", MetricType::Counter, "건너뛴 송신 주기 수", labels,
+                  scheduler.skippedPeriods);
+    SentenceHistoryStats history = sentSentences.stats();
+    writer.sample("vsensor_rs232_history_entries", MetricType::Gauge, "송신 히스토리에 보관 중인 문장 수", labels,
+                  history.entries);
+    writer.sample("vsensor_rs232_history_bytes", MetricType::Gauge, "송신 히스토리에 보관 중인 문장 바이트 수",
+                  labels, history.bytes);
+    writer.sample("vsensor_rs232_history_evicted_total", MetricType::Counter,
+                  "송신 히스토리 상한을 넘어 버린 문장 수", labels, history.evicted);
+    writer.sample("vsensor_rs232_ui_queue_depth", MetricType::Gauge, "UI 수신 링에 쌓인 레코드 수", labels,
+                  uiRing.size());
+    writer.sample("vsensor_rs232_ui_queue_dropped_total", MetricType::Counter,
+                  "UI 수신 링이 가득 차서 버린 레코드 수", labels, uiRing.dropped());
+}
 
-        if (start) checksum ^= static_cast<unsigned char>(ch);
+QString RS232Communication::formatRecord(const CommRecord& record) {
+    return formatNMEAMessage(std::string_view(record.text, record.length));
+}
+
+QString RS232Communication::formatNMEAMessage(std::string_view message) {
+    nmea::Sentence sentence;
+    if (nmea::parse(message, sentence) != nmea::ParseResult::Ok) {
+        return "[알 수 없는 포맷]\n";
     }
 
-    std::ostringstream hexStream;
-    hexStream << std::uppercase << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(checksum);
-    return hexStream.str();
-}
+    // 빈 필드는 "<빈 값>"으로 표시
+    auto field = [&sentence](size_t index) {
+        std::string_view value = sentence.field(index);
+        return value.empty() ? QString("<빈 값>") : QString::fromLatin1(value.data(), static_cast<int>(value.size()));
+    };
 
-bool RS232Communication::verifyChecksum(const std::string& sentence) {
-    // 타임스탬프 분리
-    size_t pos = sentence.find("$");  // 첫 번째 '$' 위치 찾기
-    if (pos == std::string::npos) {
-        std::cerr << "NMEA Sentence 없음: " << sentence << std::endl;
-        return false;
+    QString data;
+
+    switch (sentence.type) {
+    case nmea::SentenceType::GGA:
+        // GPGGA 메시지 처리
+        if (sentence.fieldCount >= 15) {
+            data += "[GPGGA 포맷]\n";
+            data += "   - UTC 시간: " + field(1) + "\n";
+            data += "   - 위도: " + field(2) + " " + field(3) + "\n";
+            data += "   - 경도: " + field(4) + " " + field(5) + "\n";
+            data += "   - 고정 품질: " + field(6) + "\n";
+            data += "   - 사용 중 위성 수: " + field(7) + "\n";
+            data += "   - HDOP: " + field(8) + "\n";
+            data += "   - 고도: " + field(9) + " " + field(10) + "\n";
+            data += "   - 지구 표면 간격: " + field(11) + " " + field(12) + "\n";
+            data += "   - DGPS 데이터 지연: " + field(13) + "\n";
+            data += "   - DGPS 기준 ID: " + field(14) + "\n";
+        }
+        break;
+    case nmea::SentenceType::HDT:
+        // GPHDT 메시지 처리
+        if (sentence.fieldCount >= 3) {
+            data += "[GPHDT 포맷]\n";
+            data += "   - 헤딩: " + field(1) + " 도\n";
+            data += "   - 방향: " + field(2) + "\n";
+        }
+        break;
+    case nmea::SentenceType::VTG:
+        // GPVTG 메시지 처리
+        if (sentence.fieldCount >= 9) {
+            data += "[GPVTG 포맷]\n";
+            data += "   - 진북 기준 트랙 각도: " + field(1) + " 도\n";
+            data += "   - 속도 (노트): " + field(5) + " 노트\n";
+            data += "   - 속도 (킬로미터/시간): " + field(7) + " km/h\n";
+        }
+        break;
+    default:
+        data += "[알 수 없는 포맷]\n";
+        break;
     }
 
-    std::string timestamp = sentence.substr(0, pos);  // 앞쪽은 타임스탬프
-    std::string nmeaSentence = sentence.substr(pos);  // '$'부터 시작하는 NMEA 문장
+    return data;
+}
 
-    // 정규식 적용 (NMEA 문장만 검사)
-    std::regex checksumRegex("^(\\$[^*]+)\\*([0-9A-Fa-f]{2})$");
-    std::smatch match;
+size_t RS232Communication::formatTimestamp(char* out, size_t capacity) {
+    // "%Y-%m-%d %H:%M:%S" (localtime_r + strftime, 할당 없음)
+    time_t now = time(nullptr);
+    struct tm local;
+    localtime_r(&now, &local);
+    return strftime(out, capacity, "%Y-%m-%d %H:%M:%S", &local);
+}
 
-    // std::cout << "타임스탬프: [" << timestamp << "]" << std::endl;
-    // std::cout << "NMEA Sentence: [" << nmeaSentence << "]" << std::endl;
+void RS232Communication::monitorConnection() {
+    if (statusTimer.readExpirations() == 0) {
+        return;
+    }
 
-    if (std::regex_match(nmeaSentence, match, checksumRegex)) {
-        // std::cout << "정규식 매칭 성공!" << std::endl;
-        // std::cout << "본문: [" << match[1].str() << "]" << std::endl;
-        // std::cout << "받은 체크섬: [" << match[2].str() << "]" << std::endl;
+    // 닫힌 수신 포트 다시 열기
+    if (!rxPort.isOpen()) {
+        openReceivePort();
+    }
 
-        // 체크섬 검증
-        if (calculateChecksum(match[1].str()) == match[2].str()) {
-            // std::cout << "체크섬 검증 성공!" << std::endl;
-            return true;
-        } else {
-            std::cerr << "[RS232] 체크섬 불일치! 예상: [" << calculateChecksum(match[1].str())
-                << "] / 받은 값: [" << match[2].str() << "]" << std::endl;
-        }
+    auto now = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsed_seconds = now - lastReceivedTimestamp;
+
+    QString statusText;
+    if (elapsed_seconds.count() < 2) {
+        statusText = "양호";
+    } else if (elapsed_seconds.count() < 5) {
+        statusText = "미흡";
     } else {
-        std::cerr << "정규식 매칭 실패!" << std::endl;
+        statusText = "끊김";
     }
 
-    return false;
+    // 시그널 발송
+    emit connectionStatusChanged(statusText);
+}
+
+bool RS232Communication::verifyChecksum(std::string_view sentence) {
+    // '$' 앞의 타임스탬프는 건너뛰고 "$...*HH" 형식과 체크섬을 한 번에 검사
+    return nmea::verify(sentence);
 }
 
 void RS232Communication::enableRS232Send(bool enable) {
@@ -322,6 +424,34 @@ void RS232Communication::enableRS232Send(bool enable) {
 }
 
 
-void RS232Communication::setSendPeriod(int intervalMs) {
-    sendIntervalMs.store(intervalMs);
+void RS232Communication::setSendPeriodUs(int64_t periodUs) {
+    sendScheduler.setPeriod(periodUs * 1000);
+}
+
+void RS232Communication::setOverrunPolicy(OverrunPolicy policy) {
+    sendScheduler.setPolicy(policy);
+}
+
+SchedulerStats RS232Communication::sendSchedulerStats() const {
+    return sendScheduler.stats();
+}
+
+void RS232Communication::resetSendSchedulerStats() {
+    sendScheduler.resetStats();
+}
+
+void RS232Communication::setGeneratorSeed(uint64_t seed) {
+    generator.reseed(seed);
+}
+
+uint64_t RS232Communication::generatorSeed() const {
+    return generator.seed();
+}
+
+void RS232Communication::setSentHistoryLimits(size_t maxEntries, size_t arenaBytes) {
+    sentSentences.setLimits(maxEntries, arenaBytes);
+}
+
+void RS232Communication::setBaudRate(int baud) {
+    baudRate.store(baud);
 }
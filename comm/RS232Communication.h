@@ -2,6 +2,16 @@
 #define RS232COMMUNICATION_H
 
 #include "HardwareCommunication.h"
+#include "AsyncLogger.h"
+#include "SPSCRing.h"
+#include "CommRecord.h"
+#include "SerialPort.h"
+#include "LineFramer.h"
+#include "NMEAGenerator.h"
+#include "PeriodicScheduler.h"
+#include "Metrics.h"
+#include "SentenceHistory.h"
+#include <string_view>
 #include <string>
 #include <thread>
 #include <random>
@@ -9,52 +19,118 @@
 #include <mutex>
 #include <QObject>
 
-class RS232Communication : public QObject, public HardwareCommunication {
+// 송수신 문장 누적 카운터
+struct RS232TrafficStats {
+    uint64_t sentencesSent;      // 송신 대기열에 넣은 문장
+    uint64_t sentencesDropped;   // 송신 대기열이 가득 차서 버린 문장
+    uint64_t sentencesReceived;  // 체크섬이 맞는 수신 문장
+    uint64_t checksumErrors;
+    uint64_t writeFailures;      // 포트 열기 / 쓰기 실패
+};
+
+class RS232Communication : public QObject, public HardwareCommunication, public MetricsSource {
     Q_OBJECT
 public:
     RS232Communication(const std::string& sendPort, const std::string& receivePort);
     ~RS232Communication();
 
-    void sendData();  // 데이터 송신 함수
-    void receiveData();  // 데이터 수신 함수
-    void monitorConnection();  // 연결 상태 모니터링 함수
-
     void enableRS232Send(bool);
     std::atomic<bool> rs232SendEnabled{false}; // RS232 송신 활성화 여부
 
-    void setSendPeriod(int);
+    void setSendPeriodUs(int64_t periodUs);       // 최소 100us
+    void setOverrunPolicy(OverrunPolicy policy);  // 송신 작업이 주기를 넘겼을 때 처리 방식
+    SchedulerStats sendSchedulerStats() const;    // 송신 주기 지터 / 초과 통계
+    void resetSendSchedulerStats();
+    void setBaudRate(int baud);  // 다음 포트 열기부터 적용
+
+    // 같은 시드면 같은 NMEA 문장 수열을 생성 (start() 전에 호출)
+    void setGeneratorSeed(uint64_t seed);
+    uint64_t generatorSeed() const;
+
+    RS232TrafficStats trafficStats() const;
+    void collectMetrics(MetricsWriter& writer) const override;
+
+    // 수신 레코드 링 (생산자: 반응기 스레드, 소비자: UI 스레드)
+    size_t drainRecords(CommRecord* out, size_t maxRecords);
+    uint64_t droppedRecords() const;
+    static QString formatRecord(const CommRecord& record);
+
+    // 송신 문장 히스토리 (항목 수 / 바이트 상한, 오래된 것부터 버림). 통계는 UI / 헤드리스 요약에서 조회
+    const SentenceHistory& sentHistory() const { return sentSentences; }
+    void setSentHistoryLimits(size_t maxEntries, size_t arenaBytes);  // 보관 중인 문장은 지워짐
+
+    // 캡처 재생: 문장 하나를 송신 경로로 보냄 (어느 스레드에서나 호출, 연결 중일 때만)
+    void replaySentence(std::string_view sentence);
+
+    static constexpr size_t kUIRingCapacity = 4096;
 
 protected:
-    void run() override;  // 통신 루프
+    bool attach(EventReactor& eventReactor) override;
+    void detach() override;
+    void onTransitionFinished(const ChannelTransition& result) override;
 
 signals:
-    void dataReceived(const QString &data);  // 수신된 데이터를 CommSimulator에 전달
     void connectionStatusChanged(const QString& status);
+    // startAsync / stopAsync 완료 (반응기 스레드에서 발생하므로 UI에는 큐 연결로 전달됨)
+    void transitionFinished(bool connected, qint64 elapsedNs);
 
 private:
     std::string sendPort;  // 송신 포트
     std::string receivePort;  // 수신 포트
 
-    std::atomic<int> sendIntervalMs{500}; // 송신 주기 (기본 100ms)
+    PeriodicScheduler sendScheduler{500000000LL};  // 송신 주기 (기본 500ms, 절대 데드라인)
+    std::atomic<int> baudRate{115200};
+
+    TimerFd sendTimer;     // sendScheduler가 설정하는 송신 타이머
+    TimerFd statusTimer;   // 연결 상태 갱신 / 닫힌 수신 포트 다시 열기
+    static constexpr int64_t kStatusIntervalNs = 1000000000LL;
+
+    // 포트는 한 번 열어 유지하고 오류 시에만 다시 연다 (반응기 스레드 전용)
+    SerialPort txPort;
+    SerialPort rxPort;
+    LineFramer rxFramer;
+    static constexpr size_t kMaxTimestampLength = 32;
+    static constexpr int kMaxReadsPerEvent = 16;  // 한 번에 너무 오래 붙잡지 않도록 (레벨 트리거로 다시 호출됨)
+
+    // 쓰지 못한 송신 데이터 (출력 버퍼가 가득 차면 EPOLLOUT으로 이어서 씀)
+    static constexpr size_t kMaxPendingBytes = 16 * 1024;
+    std::vector<char> txPending;
+    size_t txPendingOffset{0};
+    bool txWaitingWritable{false};
+
+    NMEAGenerator generator;  // 반응기 스레드 전용
     // int intervalMs;  // 송신 주기 (ms)
     // bool connectionStatus;  // 연결 상태
-    std::mutex dataMutex;  // 수신된 데이터 보호용 뮤텍스
     std::string lastReceivedTime;  // 마지막 수신 시간
     std::chrono::system_clock::time_point lastReceivedTimestamp; // 마지막 수신 타임스탬프
-    std::vector<std::string> receivedData;  // 수신된 데이터 저장
-
-    void printNMEAMessage(const std::string&); // 메시지 포맷 변경 후 출력
-    std::vector<std::string> parseNMEAMessage(const std::string&);
-    std::string generateNMEAData();  // NMEA 데이터 생성 함수
-    std::string generateGPGGA();  // GPGGA 포맷 데이터 생성
-    std::string generateGPHDT();  // GPHDT 포맷 데이터 생성
-    std::string generateGPVTG();  // GPVTG 포맷 데이터 생성
-    std::string getCurrentTimestamp();  // 현재 시간 타임스탬프 생성
-    std::string formatDouble(double val);               // 실수 포맷팅 함수
-    int generateRandomInt(int min, int max);
-    double generateRandomDouble(double min, double max);
-    std::string calculateChecksum(const std::string&);
-    bool verifyChecksum(const std::string&);
+    SentenceHistory sentSentences;  // 송신 문장 (쓰기: 반응기 스레드)
+
+    SPSCRing<CommRecord, kUIRingCapacity> uiRing;  // 수신 스레드 -> UI
+
+    // 누적 카운터 (trafficStats()와 MetricsRegistry로 내보냄)
+    MetricCounter sentencesSent;
+    MetricCounter sentencesDropped;
+    MetricCounter sentencesReceived;
+    MetricCounter checksumErrors;
+    MetricCounter writeFailures;
+    MetricCounter receiveFailures;
+    std::atomic<uint64_t> txPendingBytes{0};  // 송신 대기열 크기 게이지 (반응기 스레드가 갱신)
+
+    bool ensurePortOpen(SerialPort& port, const std::string& path, LogEvent failureEvent);
+    bool openReceivePort();
+    void closeReceivePort();
+    void closeTransmitPort();
+    void onSendTimer();
+    void sendSentence();       // 문장 하나 생성 후 송신 대기열에 추가
+    void queueSentence(std::string_view data);  // 타임스탬프를 붙여 송신 대기열에 추가
+    void flushTransmit();
+    void handleReceiveReady(uint32_t events);
+    void monitorConnection();  // 상태 타이머 (1초)
+    void handleReceivedLine(std::string_view message);
+    void pushReceivedRecord(std::string_view message);
+    static QString formatNMEAMessage(std::string_view); // 메시지 포맷 변경
+    static size_t formatTimestamp(char* out, size_t capacity);  // 현재 시간 타임스탬프 생성
+    static bool verifyChecksum(std::string_view);
 };
 
 #endif  // RS232COMMUNICATION_H
@@ -0,0 +1,59 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 고정 크기 단일 생산자 / 단일 소비자 락프리 링 버퍼
+// 생산자는 할당이나 블로킹 없이 tryPush()하고, 가득 차면 버리고 dropped 카운터를 올린다.
+template <typename T, size_t Capacity>
+class SPSCRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity는 2의 거듭제곱이어야 함");
+
+public:
+    // 생산자 스레드 전용
+    bool tryPush(const T& item) {
+        size_t head = writeIndex.load(std::memory_order_relaxed);
+        if (head - cachedReadIndex == Capacity) {
+            cachedReadIndex = readIndex.load(std::memory_order_acquire);
+            if (head - cachedReadIndex == Capacity) {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        buffer[head & (Capacity - 1)] = item;
+        writeIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 소비자 스레드 전용: 최대 maxItems개를 out에 복사하고 개수 반환
+    size_t popBatch(T* out, size_t maxItems) {
+        size_t tail = readIndex.load(std::memory_order_relaxed);
+        size_t available = writeIndex.load(std::memory_order_acquire) - tail;
+        size_t n = available < maxItems ? available : maxItems;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = buffer[(tail + i) & (Capacity - 1)];
+        }
+        readIndex.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    size_t size() const {
+        return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire);
+    }
+
+    uint64_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    // 생산자 / 소비자 인덱스를 서로 다른 캐시 라인에 배치 (false sharing 방지)
+    alignas(64) std::atomic<size_t> writeIndex{0};
+    size_t cachedReadIndex{0};  // 생산자가 마지막으로 본 readIndex
+    alignas(64) std::atomic<size_t> readIndex{0};
+    alignas(64) std::atomic<uint64_t> droppedCount{0};
+    alignas(64) T buffer[Capacity];
+};
+
+#endif // SPSCRING_H
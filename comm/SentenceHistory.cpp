@@ -0,0 +1,90 @@
+#include "SentenceHistory.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr size_t kMinArenaBytes = CommRecord::kMaxText;
+constexpr size_t kMaxArenaBytes = UINT32_MAX;  // Entry::offset은 32비트
+
+}  // namespace
+
+SentenceHistory::SentenceHistory(size_t maxEntries, size_t arenaBytes) {
+    setLimits(maxEntries, arenaBytes);
+}
+
+void SentenceHistory::setLimits(size_t newMaxEntries, size_t newArenaBytes) {
+    newMaxEntries = std::max<size_t>(newMaxEntries, 1);
+    newArenaBytes = std::clamp(newArenaBytes, kMinArenaBytes, kMaxArenaBytes);
+
+    // 할당은 잠금 밖에서
+    std::unique_ptr<Entry[]> newEntries(new Entry[newMaxEntries]);
+    std::unique_ptr<char[]> newArena(new char[newArenaBytes]);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.swap(newEntries);
+    arena.swap(newArena);
+    maxEntries = newMaxEntries;
+    arenaBytes = newArenaBytes;
+    first = 0;
+    count = 0;
+    writeOffset = 0;
+    liveBytes = 0;
+}
+
+void SentenceHistory::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    first = 0;
+    count = 0;
+    writeOffset = 0;
+    liveBytes = 0;
+}
+
+void SentenceHistory::evictOldest() {
+    liveBytes -= entries[first].length;
+    first = (first + 1) % maxEntries;
+    --count;
+    ++evictedCount;
+}
+
+void SentenceHistory::append(int64_t timestampNs, std::string_view sentence) {
+    if (sentence.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t length = std::min(sentence.size(), arenaBytes);
+    if (count == maxEntries) {
+        evictOldest();
+    }
+
+    // 문장은 아레나 끝에서 나누지 않는다. 끝에 남은 공간이 모자라면 앞에서 다시 시작하고,
+    // 그 전에 끝 구간에 남은 이전 바퀴의 문장(가장 오래된 것들)을 버린다.
+    // 살아 있는 문장은 오래된 것부터 writeOffset까지 원형으로 연속이므로,
+    // 가장 오래된 문장이 writeOffset 뒤에 있으면 그것이 이전 바퀴의 문장이다.
+    if (writeOffset + length > arenaBytes) {
+        while (count > 0 && entries[first].offset >= writeOffset) {
+            evictOldest();
+        }
+        writeOffset = 0;
+    }
+    // 새 문장이 덮을 구간 [writeOffset, writeOffset + length)에서 시작하는 문장을 버림
+    while (count > 0 && entries[first].offset >= writeOffset && entries[first].offset < writeOffset + length) {
+        evictOldest();
+    }
+
+    memcpy(arena.get() + writeOffset, sentence.data(), length);
+    Entry& entry = entries[(first + count) % maxEntries];
+    entry.timestampNs = timestampNs;
+    entry.offset = static_cast<uint32_t>(writeOffset);
+    entry.length = static_cast<uint32_t>(length);
+    ++count;
+    writeOffset += length;
+    liveBytes += length;
+    ++appendedCount;
+}
+
+SentenceHistoryStats SentenceHistory::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return {count, liveBytes, maxEntries, arenaBytes, appendedCount, evictedCount};
+}
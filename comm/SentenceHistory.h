@@ -0,0 +1,65 @@
+#ifndef SENTENCEHISTORY_H
+#define SENTENCEHISTORY_H
+
+#include "CommRecord.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+struct SentenceHistoryStats {
+    size_t entries;        // 보관 중인 문장 수
+    size_t bytes;          // 보관 중인 문장 바이트 수
+    size_t maxEntries;
+    size_t arenaBytes;
+    uint64_t appended;     // 누적 추가 수
+    uint64_t evicted;      // 용량 초과로 버린 오래된 문장 수
+};
+
+// 문장 히스토리 (항목 수 / 바이트 상한, 가득 차면 가장 오래된 문장부터 버림)
+// 항목은 정수 시각과 아레나 위치만 가지며, 문장 바이트는 원형 아레나에 연속으로 저장한다.
+// 메모리는 생성 시 한 번만 할당하므로 송신 속도나 실행 시간과 무관하게 일정하다.
+// 쓰기는 채널의 반응기 스레드, 통계 조회는 UI / 헤드리스 요약 등 어느 스레드에서나 (짧은 뮤텍스, 잠금 중 할당 없음)
+class SentenceHistory {
+public:
+    static constexpr size_t kDefaultMaxEntries = 65536;
+    static constexpr size_t kDefaultArenaBytes = 4 * 1024 * 1024;
+
+    SentenceHistory(size_t maxEntries = kDefaultMaxEntries, size_t arenaBytes = kDefaultArenaBytes);
+
+    SentenceHistory(const SentenceHistory&) = delete;
+    SentenceHistory& operator=(const SentenceHistory&) = delete;
+
+    // 상한 변경 (보관 중인 문장은 모두 지워짐)
+    void setLimits(size_t maxEntries, size_t arenaBytes);
+
+    // 빈 문장은 무시, 아레나보다 긴 문장은 잘라서 저장
+    void append(int64_t timestampNs, std::string_view sentence);
+    void clear();
+
+    SentenceHistoryStats stats() const;
+
+private:
+    struct Entry {
+        int64_t timestampNs;
+        uint32_t offset;  // 아레나 내 시작 위치
+        uint32_t length;
+    };
+
+    void evictOldest();
+
+    mutable std::mutex mutex;
+    std::unique_ptr<Entry[]> entries;
+    std::unique_ptr<char[]> arena;
+    size_t maxEntries{0};
+    size_t arenaBytes{0};
+
+    size_t first{0};       // 가장 오래된 항목 위치
+    size_t count{0};
+    size_t writeOffset{0}; // 다음 문장을 쓸 아레나 위치
+    size_t liveBytes{0};
+    uint64_t appendedCount{0};
+    uint64_t evictedCount{0};
+};
+
+#endif // SENTENCEHISTORY_H
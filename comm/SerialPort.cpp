@@ -0,0 +1,117 @@
+#include "SerialPort.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+
+speed_t toSpeed(int baudRate) {
+    switch (baudRate) {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default: return B0;  // 지원하지 않는 속도
+    }
+}
+
+}  // namespace
+
+SerialPort::~SerialPort() {
+    close();
+}
+
+bool SerialPort::isSupportedBaudRate(int baudRate) {
+    return toSpeed(baudRate) != B0;
+}
+
+bool SerialPort::open(const std::string& path, int baudRate) {
+    close();
+
+    // 다른 속도로 조용히 여는 대신 실패로 알림
+    if (!isSupportedBaudRate(baudRate)) {
+        errno = EINVAL;
+        return false;
+    }
+
+    int newFd = ::open(path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (newFd < 0) {
+        return false;
+    }
+
+    // raw 모드, 8N1, 흐름 제어 없음
+    struct termios tty;
+    if (tcgetattr(newFd, &tty) == 0) {
+        cfmakeraw(&tty);
+        tty.c_cflag &= ~(PARENB | CSTOPB | CSIZE | CRTSCTS);
+        tty.c_cflag |= CS8 | CLOCAL | CREAD;
+        tty.c_iflag &= ~(IXON | IXOFF | IXANY);
+        tty.c_cc[VMIN] = 1;   // 논블로킹 fd + poll로 구동하므로 read()는 즉시 반환
+        tty.c_cc[VTIME] = 0;
+        cfsetispeed(&tty, toSpeed(baudRate));
+        cfsetospeed(&tty, toSpeed(baudRate));
+        if (tcsetattr(newFd, TCSANOW, &tty) != 0) {
+            int savedErrno = errno;
+            ::close(newFd);
+            errno = savedErrno;
+            return false;
+        }
+    } else if (errno != ENOTTY) {
+        int savedErrno = errno;
+        ::close(newFd);
+        errno = savedErrno;
+        return false;
+    }
+    // ENOTTY: 일반 파일 / FIFO는 termios 없이 사용
+
+    fd = newFd;
+    portPath = path;
+    return true;
+}
+
+void SerialPort::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+ssize_t SerialPort::writeSome(const char* data, size_t length) {
+    for (;;) {
+        ssize_t written = ::write(fd, data, length);
+        if (written >= 0) {
+            return written;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 0;
+        }
+        return -1;
+    }
+}
+
+ssize_t SerialPort::readAvailable(char* buffer, size_t capacity) {
+    for (;;) {
+        ssize_t n = ::read(fd, buffer, capacity);
+        if (n > 0) {
+            return n;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return 0;
+        }
+        if (n == 0) {
+            errno = EPIPE;  // 상대편이 닫힘
+        }
+        return -1;
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef SERIALPORT_H
+#define SERIALPORT_H
+
+#include <string>
+#include <cstddef>
+#include <sys/types.h>
+
+// termios raw 모드(8N1)로 한 번 열어 유지하는 논블로킹 직렬 포트
+class SerialPort {
+public:
+    SerialPort() = default;
+    ~SerialPort();
+
+    SerialPort(const SerialPort&) = delete;
+    SerialPort& operator=(const SerialPort&) = delete;
+
+    bool open(const std::string& path, int baudRate);  // 실패 시 false (errno 유지, 지원하지 않는 속도는 EINVAL)
+    void close();
+    bool isOpen() const { return fd >= 0; }
+    int nativeHandle() const { return fd; }
+    const std::string& path() const { return portPath; }
+
+    // 지금 쓸 수 있는 만큼 씀. 0: 출력 버퍼 가득 참, -1: 오류
+    ssize_t writeSome(const char* data, size_t length);
+
+    // 지금 읽을 수 있는 만큼 읽음. 0: 데이터 없음, -1: 오류/연결 끊김
+    ssize_t readAvailable(char* buffer, size_t capacity);
+
+    static bool isSupportedBaudRate(int baudRate);  // 9600 ~ 921600의 표준 속도
+
+private:
+    int fd{-1};
+    std::string portPath;
+};
+
+#endif // SERIALPORT_H
@@ -0,0 +1,34 @@
+#include "SimdDispatch.h"
+
+bool simdLevelAvailable(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return true;
+#ifdef VSENSOR_X86_SIMD
+    case SimdLevel::SSE2:
+        return true;
+    case SimdLevel::AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+SimdLevel bestSimdLevel() {
+    static const SimdLevel best = simdLevelAvailable(SimdLevel::AVX2)   ? SimdLevel::AVX2
+                                  : simdLevelAvailable(SimdLevel::SSE2) ? SimdLevel::SSE2
+                                                                        : SimdLevel::Scalar;
+    return best;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::SSE2:
+        return "sse2";
+    case SimdLevel::AVX2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
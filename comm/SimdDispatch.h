@@ -0,0 +1,22 @@
+#ifndef SIMDDISPATCH_H
+#define SIMDDISPATCH_H
+
+#include <cstdint>
+
+#if defined(__x86_64__)
+#define VSENSOR_X86_SIMD 1
+#endif
+
+// 실행 중 선택하는 SIMD 경로 (x86-64에서는 SSE2가 기본, AVX2는 CPU 확인 후 사용)
+// 커널은 경로와 무관하게 같은 결과를 내도록 작성한다 (빌드는 -ffp-contract=off).
+enum class SimdLevel : uint8_t {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+SimdLevel bestSimdLevel();
+bool simdLevelAvailable(SimdLevel level);
+const char* simdLevelName(SimdLevel level);
+
+#endif // SIMDDISPATCH_H
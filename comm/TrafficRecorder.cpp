@@ -0,0 +1,144 @@
+#include "TrafficRecorder.h"
+#include "PeriodicScheduler.h"
+#include <algorithm>
+#include <cstring>
+#include <linux/can.h>
+
+void RecorderTap::recordCAN(const canfd_frame& frame, bool fd, int64_t timestampNs) {
+    capture::Record record;
+    record.header.timestampNs = timestampNs;
+    record.header.id = frame.can_id;
+    record.header.kind = fd ? capture::RecordKind::CANFD : capture::RecordKind::CAN;
+    record.header.bus = bus;
+    record.header.flags = 0;
+    if (fd) {
+        if (frame.flags & CANFD_BRS) record.header.flags |= capture::kFlagBRS;
+        if (frame.flags & CANFD_ESI) record.header.flags |= capture::kFlagESI;
+    }
+    record.header.length = std::min<uint8_t>(frame.len, fd ? CANFD_MAX_DLEN : CAN_MAX_DLEN);
+    memcpy(record.payload, frame.data, record.header.length);
+    ring.tryPush(record);
+}
+
+void RecorderTap::recordNMEA(std::string_view sentence, int64_t timestampNs) {
+    capture::Record record;
+    record.header.timestampNs = timestampNs;
+    record.header.id = 0;
+    record.header.kind = capture::RecordKind::NMEA;
+    record.header.bus = bus;
+    record.header.flags = 0;
+    record.header.length = static_cast<uint8_t>(std::min(sentence.size(), capture::kMaxPayload));
+    memcpy(record.payload, sentence.data(), record.header.length);
+    ring.tryPush(record);
+}
+
+TrafficRecorder::~TrafficRecorder() {
+    stop();
+}
+
+bool TrafficRecorder::start(const std::string& path, const std::vector<std::string>& busNames) {
+    if (running) {
+        return false;
+    }
+    if (!writer.open(path, busNames)) {
+        return false;
+    }
+    {
+        // 이전 기록의 탭은 채널이 이미 놓았음
+        std::lock_guard<std::mutex> lock(tapMutex);
+        taps.clear();
+    }
+    if (!stopEvent.open()) {
+        writer.close();
+        return false;
+    }
+    recordsWritten = 0;
+    bytesWritten = writer.bytesWritten();
+    writeError = false;
+    running = true;
+    writerThread = std::thread(&TrafficRecorder::writerLoop, this);
+    return true;
+}
+
+void TrafficRecorder::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    stopEvent.signal();
+    writerThread.join();
+    if (!writer.close()) {
+        writeError = true;
+    }
+}
+
+RecorderTap* TrafficRecorder::createTap(uint8_t bus) {
+    std::lock_guard<std::mutex> lock(tapMutex);
+    taps.push_back(std::unique_ptr<RecorderTap>(new RecorderTap(bus)));
+    return taps.back().get();
+}
+
+RecorderStats TrafficRecorder::stats() const {
+    uint64_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(tapMutex);
+        for (const auto& tap : taps) {
+            dropped += tap->ring.dropped();
+        }
+    }
+    return {recordsWritten.load(std::memory_order_relaxed),
+            bytesWritten.load(std::memory_order_relaxed),
+            dropped,
+            writeError.load(std::memory_order_relaxed)};
+}
+
+void TrafficRecorder::writerLoop() {
+    while (running.load(std::memory_order_relaxed)) {
+        drainOnce();
+        stopEvent.waitUntil(PeriodicScheduler::monotonicNs() + kFlushIntervalMs * 1000000LL);
+    }
+    // 종료 전에 남은 레코드 기록 (마지막 블록은 stop()의 close()에서 봉인)
+    drainOnce();
+}
+
+size_t TrafficRecorder::drainOnce() {
+    // 탭마다 한 구간 (각 구간은 시각 순), 구간끼리 병합해서 기록
+    size_t count = 0;
+    runEnds.clear();
+    {
+        std::lock_guard<std::mutex> lock(tapMutex);
+        mergeBuffer.resize(taps.size() * RecorderTap::kRingCapacity);
+        for (const auto& tap : taps) {
+            count += tap->ring.popBatch(mergeBuffer.data() + count, RecorderTap::kRingCapacity);
+            runEnds.push_back(count);
+        }
+    }
+    if (count == 0) {
+        // 트래픽이 끊겨도 열린 블록은 kMaxBlockAgeNs 안에 봉인되어 인덱스에 보이도록
+        if (!writer.flush()) {
+            writeError.store(true, std::memory_order_relaxed);
+        }
+        return 0;
+    }
+
+    auto byTime = [](const capture::Record& a, const capture::Record& b) {
+        return a.header.timestampNs < b.header.timestampNs;
+    };
+    for (size_t i = 1; i < runEnds.size(); ++i) {
+        std::inplace_merge(mergeBuffer.begin(), mergeBuffer.begin() + runEnds[i - 1],
+                           mergeBuffer.begin() + runEnds[i], byTime);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!writer.append(mergeBuffer[i])) {
+            writeError.store(true, std::memory_order_relaxed);
+            break;
+        }
+    }
+    if (!writer.flush()) {
+        writeError.store(true, std::memory_order_relaxed);
+    }
+    recordsWritten.store(writer.recordsWritten(), std::memory_order_relaxed);
+    bytesWritten.store(writer.bytesWritten(), std::memory_order_relaxed);
+    return count;
+}
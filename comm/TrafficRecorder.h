@@ -0,0 +1,83 @@
+#ifndef TRAFFICRECORDER_H
+#define TRAFFICRECORDER_H
+
+#include "CaptureFile.h"
+#include "EventReactor.h"
+#include "SPSCRing.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+struct canfd_frame;
+
+// 채널 하나의 수신 경로 탭 (생산자: 채널의 반응기 스레드, 소비자: 기록 스레드)
+// 반응기 스레드는 고정 크기 레코드를 링에 넣기만 하고, 가득 차면 버린다.
+class RecorderTap {
+public:
+    void recordCAN(const canfd_frame& frame, bool fd, int64_t timestampNs);
+    void recordNMEA(std::string_view sentence, int64_t timestampNs);
+
+    static constexpr size_t kRingCapacity = 8192;
+
+private:
+    friend class TrafficRecorder;
+    explicit RecorderTap(uint8_t bus) : bus(bus) {}
+
+    uint8_t bus;
+    SPSCRing<capture::Record, kRingCapacity> ring;
+};
+
+struct RecorderStats {
+    uint64_t recordsWritten;
+    uint64_t bytesWritten;
+    uint64_t dropped;  // 탭 링이 가득 차서 버린 레코드 수
+    bool writeError;
+};
+
+// 수신 트래픽을 캡처 파일(.vscap)로 기록
+// 채널은 HardwareCommunication::setRecorder()로 탭을 받아 수신 경로에서 원본 프레임 / 문장을 넘긴다.
+// 기록 스레드가 주기적으로 모든 탭을 비우고 시각 순으로 병합해 파일에 쓴다.
+class TrafficRecorder {
+public:
+    TrafficRecorder() = default;
+    ~TrafficRecorder();
+
+    TrafficRecorder(const TrafficRecorder&) = delete;
+    TrafficRecorder& operator=(const TrafficRecorder&) = delete;
+
+    // busNames: CAN 버스 인덱스 순서의 인터페이스 이름 (파일 헤더에 기록)
+    // 이전 기록에서 만든 탭은 모두 해제된다 (채널을 연결하기 전에 호출)
+    bool start(const std::string& path, const std::vector<std::string>& busNames);
+    // 채널이 setRecorder(nullptr)로 탭을 놓은 뒤 호출 (남은 레코드를 모두 기록)
+    void stop();
+    bool isRecording() const { return running.load(std::memory_order_relaxed); }
+
+    RecorderTap* createTap(uint8_t bus);  // 기록기가 살아 있는 동안 유효
+    RecorderStats stats() const;
+
+    static constexpr int kFlushIntervalMs = 10;
+
+private:
+    void writerLoop();
+    size_t drainOnce();
+
+    capture::Writer writer;  // 기록 스레드 전용
+    std::vector<capture::Record> mergeBuffer;
+    std::vector<size_t> runEnds;
+
+    mutable std::mutex tapMutex;  // 탭 목록 (탭 추가 / 기록 스레드 순회)
+    std::vector<std::unique_ptr<RecorderTap>> taps;
+
+    std::atomic<bool> running{false};
+    CancelEvent stopEvent;  // stop()이 기록 주기 대기를 깨움
+    std::atomic<uint64_t> recordsWritten{0};
+    std::atomic<uint64_t> bytesWritten{0};
+    std::atomic<bool> writeError{false};
+    std::thread writerThread;
+};
+
+#endif // TRAFFICRECORDER_H
@@ -0,0 +1,265 @@
+#include "TrafficReplayer.h"
+#include "CANCommunication.h"
+#include "RS232Communication.h"
+#include "PeriodicScheduler.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sys/prctl.h>
+
+namespace {
+
+constexpr double kMinSpeed = 0.01;
+
+bool hasSuffix(const std::string& text, const char* suffix) {
+    size_t n = strlen(suffix);
+    return text.size() >= n && text.compare(text.size() - n, n, suffix) == 0;
+}
+
+}  // namespace
+
+TrafficReplayer::~TrafficReplayer() {
+    stop();
+}
+
+void TrafficReplayer::setCANBus(uint8_t bus, CANCommunication* channel) {
+    if (running) {
+        return;
+    }
+    if (canBuses.size() <= bus) {
+        canBuses.resize(bus + 1, nullptr);
+    }
+    canBuses[bus] = channel;
+}
+
+void TrafficReplayer::setNMEAChannel(RS232Communication* channel) {
+    if (!running) {
+        nmeaChannel = channel;
+    }
+}
+
+void TrafficReplayer::setMode(ReplayMode replayMode, double replaySpeed) {
+    if (!running) {
+        mode = replayMode;
+        speed = std::max(replaySpeed, kMinSpeed);
+    }
+}
+
+bool TrafficReplayer::start(const std::string& path) {
+    if (running) {
+        return false;
+    }
+    if (replayThread.joinable()) {
+        replayThread.join();  // 이전 재생이 끝난 스레드
+    }
+
+    std::string capturePath = path;
+    if (hasSuffix(path, ".log")) {
+        capture::ImportResult imported;
+        capturePath = path + ".vscap";
+        if (!capture::importCandump(path, capturePath, imported)) {
+            lastError = "candump 로그 변환 실패: " + path;
+            return false;
+        }
+        std::cout << "[정보] candump 로그 변환: " << imported.recordsWritten << "개 레코드, "
+                  << imported.linesSkipped << "줄 건너뜀 -> " << capturePath << std::endl;
+    }
+
+    if (!reader.open(capturePath)) {
+        lastError = reader.error();
+        std::cerr << "[오류] 캡처 파일 열기 실패: " << lastError << std::endl;
+        return false;
+    }
+
+    lastError.clear();
+    recordsReplayed = 0;
+    canFrames = 0;
+    nmeaSentences = 0;
+    unroutable = 0;
+    captureSpanNs = 0;
+    startNs = PeriodicScheduler::monotonicNs();
+    endNs = 0;
+    timingError.reset();
+    if (!stopEvent.open()) {
+        lastError = std::string("eventfd 생성 실패: ") + strerror(errno);
+        std::cerr << "[오류] " << lastError << std::endl;
+        return false;
+    }
+    stopRequested = false;
+    running = true;
+    replayThread = std::thread(&TrafficReplayer::replayLoop, this);
+    return true;
+}
+
+void TrafficReplayer::stop() {
+    stopRequested = true;
+    stopEvent.signal();  // 다음 프레임 시각까지 기다리는 중이어도 바로 깨어남
+    waitFinished();
+}
+
+void TrafficReplayer::waitFinished() {
+    if (replayThread.joinable()) {
+        replayThread.join();
+    }
+}
+
+ReplayStats TrafficReplayer::stats() const {
+    ReplayStats result;
+    result.running = running.load(std::memory_order_acquire);
+    result.recordsReplayed = recordsReplayed.load(std::memory_order_relaxed);
+    result.canFrames = canFrames.load(std::memory_order_relaxed);
+    result.nmeaSentences = nmeaSentences.load(std::memory_order_relaxed);
+    result.unroutable = unroutable.load(std::memory_order_relaxed);
+    result.captureSpanNs = captureSpanNs.load(std::memory_order_relaxed);
+
+    int64_t end = endNs.load(std::memory_order_relaxed);
+    int64_t begin = startNs.load(std::memory_order_relaxed);
+    result.elapsedNs = (end != 0 ? end : PeriodicScheduler::monotonicNs()) - begin;
+    double elapsedSec = std::max<int64_t>(result.elapsedNs, 1) / 1e9;
+    result.recordsPerSec = result.recordsReplayed / elapsedSec;
+    result.achievedSpeed = result.captureSpanNs / 1e9 / elapsedSec;
+    result.timingError = timingError.summary();
+    if (!result.running) {
+        result.error = lastError;
+    }
+    return result;
+}
+
+void TrafficReplayer::replayLoop() {
+    // 기본 타이머 슬랙(50us)이 그대로 타이밍 오차가 되지 않도록
+    prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+    batchFrames.reserve(kMaxBatch);
+    batchFDFrames.reserve(kMaxBatch);
+    batchTargets.reserve(kMaxBatch);
+
+    const bool paced = mode != ReplayMode::AsFastAsPossible;
+    const double scale = (mode == ReplayMode::Scaled) ? 1.0 / speed : 1.0;
+    const int64_t baseNs = PeriodicScheduler::monotonicNs();
+    int64_t firstTimestampNs = 0;
+    int64_t offsetNs = 0;
+    bool first = true;
+
+    capture::Record record;
+    while (!stopRequested.load(std::memory_order_relaxed) && reader.next(record)) {
+        if (first) {
+            firstTimestampNs = record.header.timestampNs;
+            first = false;
+        }
+        // 여러 탭을 병합한 캡처는 경계에서 미세하게 역전될 수 있으므로 시각은 뒤로 가지 않게
+        offsetNs = std::max(offsetNs, record.header.timestampNs - firstTimestampNs);
+
+        int64_t targetNs = 0;
+        if (paced) {
+            targetNs = baseNs + static_cast<int64_t>(offsetNs * scale);
+            int64_t nowNs = PeriodicScheduler::monotonicNs();
+            if (targetNs > nowNs) {
+                // 기다리기 전에 이미 목표 시각이 지난 프레임부터 송신
+                flushBatch();
+                if (!stopEvent.waitUntil(targetNs)) {
+                    break;
+                }
+            }
+        }
+
+        if (!routeRecord(record)) {
+            unroutable.fetch_add(1, std::memory_order_relaxed);
+        } else if (batchChannel == nullptr) {
+            // NMEA는 바로 송신됨
+            if (paced) {
+                timingError.record(static_cast<uint64_t>(std::max<int64_t>(PeriodicScheduler::monotonicNs() - targetNs, 0)));
+            }
+            recordsReplayed.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            batchTargets.push_back(targetNs);
+            if (batchTargets.size() == kMaxBatch) {
+                flushBatch();
+            }
+        }
+        captureSpanNs.store(offsetNs, std::memory_order_relaxed);
+    }
+    flushBatch();
+
+    if (!reader.error().empty() && !stopRequested) {
+        lastError = reader.error();
+    }
+    reader.close();
+    endNs.store(PeriodicScheduler::monotonicNs(), std::memory_order_relaxed);
+    running.store(false, std::memory_order_release);
+}
+
+bool TrafficReplayer::routeRecord(const capture::Record& record) {
+    const capture::RecordHeader& header = record.header;
+
+    if (header.kind == capture::RecordKind::NMEA) {
+        flushBatch();
+        if (nmeaChannel == nullptr || !nmeaChannel->isConnected()) {
+            return false;
+        }
+        nmeaChannel->replaySentence(record.text());
+        nmeaSentences.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    CANCommunication* channel = header.bus < canBuses.size() ? canBuses[header.bus] : nullptr;
+    if (channel == nullptr || !channel->isConnected()) {
+        return false;
+    }
+
+    // 다른 버스 / 프레임 종류가 섞이면 지금까지의 묶음을 먼저 송신
+    bool fd = header.kind == capture::RecordKind::CANFD;
+    if (batchChannel != nullptr && (batchChannel != channel || batchFD != fd)) {
+        flushBatch();
+    }
+    batchChannel = channel;
+    batchFD = fd;
+
+    if (fd) {
+        canfd_frame frame = {};
+        frame.can_id = normalizeCANID(header.id);  // 플래그 없이 기록된 이전 캡처
+        frame.len = std::min<uint8_t>(header.length, CANFD_MAX_DLEN);
+        if (header.flags & capture::kFlagBRS) frame.flags |= CANFD_BRS;
+        if (header.flags & capture::kFlagESI) frame.flags |= CANFD_ESI;
+        memcpy(frame.data, record.payload, frame.len);
+        batchFDFrames.push_back(frame);
+    } else {
+        can_frame frame = {};
+        frame.can_id = normalizeCANID(header.id);
+        frame.can_dlc = std::min<uint8_t>(header.length, CAN_MAX_DLEN);
+        memcpy(frame.data, record.payload, frame.can_dlc);
+        batchFrames.push_back(frame);
+    }
+    return true;
+}
+
+void TrafficReplayer::flushBatch() {
+    if (batchChannel == nullptr) {
+        return;
+    }
+
+    // 채널의 반응기 스레드에서 현재 I/O 방식으로 송신 (Batched면 sendmmsg 한 번)
+    size_t count = batchTargets.size();
+    if (batchFD) {
+        batchChannel->replayFDFrames(std::move(batchFDFrames));
+        batchFDFrames = std::vector<canfd_frame>();
+        batchFDFrames.reserve(kMaxBatch);
+    } else {
+        batchChannel->replayFrames(std::move(batchFrames));
+        batchFrames = std::vector<can_frame>();
+        batchFrames.reserve(kMaxBatch);
+    }
+
+    if (mode != ReplayMode::AsFastAsPossible) {
+        int64_t sentNs = PeriodicScheduler::monotonicNs();
+        for (int64_t targetNs : batchTargets) {
+            timingError.record(static_cast<uint64_t>(std::max<int64_t>(sentNs - targetNs, 0)));
+        }
+    }
+    canFrames.fetch_add(count, std::memory_order_relaxed);
+    recordsReplayed.fetch_add(count, std::memory_order_relaxed);
+
+    batchFrames.clear();
+    batchFDFrames.clear();
+    batchTargets.clear();
+    batchChannel = nullptr;
+}
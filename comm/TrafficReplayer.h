@@ -0,0 +1,98 @@
+#ifndef TRAFFICREPLAYER_H
+#define TRAFFICREPLAYER_H
+
+#include "CaptureFile.h"
+#include "LatencyHistogram.h"
+#include "EventReactor.h"
+#include <linux/can.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+class CANCommunication;
+class RS232Communication;
+
+enum class ReplayMode {
+    RealTime,        // 원본 타임스탬프 간격 그대로
+    Scaled,          // 원본 간격 / speed
+    AsFastAsPossible // 대기 없이 연속 송신 (회귀 테스트용)
+};
+
+// 재생 결과 (실행 중에도 조회 가능)
+struct ReplayStats {
+    bool running;
+    uint64_t recordsReplayed;
+    uint64_t canFrames;
+    uint64_t nmeaSentences;
+    uint64_t unroutable;     // 해당 버스 / 채널이 연결되지 않아 보내지 못한 레코드
+    int64_t captureSpanNs;   // 지금까지 재생한 구간의 원본 시간 길이
+    int64_t elapsedNs;       // 재생에 걸린 실제 시간
+    double recordsPerSec;    // 달성한 송신 속도
+    double achievedSpeed;    // captureSpan / elapsed (RealTime이면 1.0에 가까워야 함)
+    HistogramSummary timingError;  // 목표 송신 시각 대비 실제 송신 지연 (AsFastAsPossible 제외)
+    std::string error;
+};
+
+// 캡처 파일(.vscap) 또는 candump .log를 원래 송신 경로(CANCommunication / RS232Communication)로 재생
+// 채널은 미리 start()해 두고, 무작위 생성 송신은 꺼 두는 것이 좋다 (enableCANSend(false) 등).
+// 재생은 전용 스레드에서 절대 데드라인으로 수행하고, 대기는 stop()이 eventfd로 즉시 깨운다.
+class TrafficReplayer {
+public:
+    TrafficReplayer() = default;
+    ~TrafficReplayer();
+
+    TrafficReplayer(const TrafficReplayer&) = delete;
+    TrafficReplayer& operator=(const TrafficReplayer&) = delete;
+
+    // 캡처의 버스 인덱스 -> CAN 채널 (nullptr: 해당 버스 레코드는 건너뜀)
+    void setCANBus(uint8_t bus, CANCommunication* channel);
+    void setNMEAChannel(RS232Communication* channel);
+    void setMode(ReplayMode mode, double speed = 1.0);  // speed는 Scaled에서만 사용
+
+    // path가 .log이면 candump 형식으로 보고 path + ".vscap"으로 변환한 뒤 재생
+    bool start(const std::string& path);
+    void stop();  // 재생 중단 (재생 스레드 종료까지 대기)
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+    void waitFinished();
+
+    ReplayStats stats() const;
+
+    static constexpr size_t kMaxBatch = 256;  // 목표 시각이 지난 연속 CAN 프레임을 한 번에 송신
+
+private:
+    void replayLoop();
+    void flushBatch();
+    bool routeRecord(const capture::Record& record);
+
+    std::vector<CANCommunication*> canBuses;
+    RS232Communication* nmeaChannel{nullptr};
+    ReplayMode mode{ReplayMode::RealTime};
+    double speed{1.0};
+
+    capture::Reader reader;  // 재생 스레드 전용
+
+    // 같은 버스 / 종류의 연속 프레임 묶음 (재생 스레드 전용)
+    CANCommunication* batchChannel{nullptr};
+    bool batchFD{false};
+    std::vector<can_frame> batchFrames;
+    std::vector<canfd_frame> batchFDFrames;
+    std::vector<int64_t> batchTargets;  // 프레임별 목표 송신 시각 (CLOCK_MONOTONIC)
+
+    std::atomic<bool> running{false};
+    std::atomic<bool> stopRequested{false};
+    CancelEvent stopEvent;  // stop()이 목표 시각 대기를 깨움
+    std::atomic<uint64_t> recordsReplayed{0};
+    std::atomic<uint64_t> canFrames{0};
+    std::atomic<uint64_t> nmeaSentences{0};
+    std::atomic<uint64_t> unroutable{0};
+    std::atomic<int64_t> captureSpanNs{0};
+    std::atomic<int64_t> startNs{0};
+    std::atomic<int64_t> endNs{0};  // 0: 진행 중
+    LatencyHistogram timingError;
+    std::string lastError;  // start() 실패 사유 (재생 스레드가 없을 때만 변경)
+    std::thread replayThread;
+};
+
+#endif // TRAFFICREPLAYER_H
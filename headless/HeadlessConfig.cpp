@@ -0,0 +1,267 @@
+#include "HeadlessConfig.h"
+#include "CANBusGroup.h"
+#include "SerialPort.h"
+#include <QSettings>
+#include <QStringList>
+#include <QVariant>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+
+const char* const kKnownKeys[] = {
+    "run/duration_s", "run/max_messages", "run/warmup_s", "run/progress_interval_s",
+    "run/overrun", "run/log", "run/output",
+    "can/interfaces", "can/ids", "can/period_us", "can/io", "can/batch_size",
+    "can/fd", "can/fd_samples", "can/brs", "can/pin", "can/seed",
+    "rs232/enabled", "rs232/send_port", "rs232/receive_port", "rs232/period_us", "rs232/baud", "rs232/seed",
+    "rs232/history_entries", "rs232/history_bytes",
+    "schedule/messages", "schedule/base_id", "schedule/periods_us", "schedule/jitter_us", "schedule/seed",
+    "metrics/textfile", "metrics/socket", "metrics/interval_ms",
+};
+
+// QSettings는 쉼표가 있는 값을 목록으로 읽으므로 다시 이어 붙여 문자열로
+std::string readString(const QSettings& settings, const char* key, const std::string& fallback = std::string()) {
+    if (!settings.contains(key)) {
+        return fallback;
+    }
+    return settings.value(key).toStringList().join(",").trimmed().toStdString();
+}
+
+bool readNumber(const QSettings& settings, const char* key, double& value, double minValue, std::string& error) {
+    if (!settings.contains(key)) {
+        return true;
+    }
+    std::string text = readString(settings, key);
+    char* end = nullptr;
+    double parsed = std::strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || parsed < minValue) {
+        error = std::string(key) + ": 잘못된 값 '" + text + "'";
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+// 10진수 / 0x 16진수
+bool readUnsigned(const std::string& text, uint64_t& value) {
+    if (text.empty() || text[0] == '-') {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = std::strtoull(text.c_str(), &end, 0);
+    if (*end != '\0' || errno != 0) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+bool readUnsigned(const QSettings& settings, const char* key, uint64_t& value, uint64_t minValue, uint64_t maxValue,
+                  std::string& error) {
+    if (!settings.contains(key)) {
+        return true;
+    }
+    std::string text = readString(settings, key);
+    uint64_t parsed = 0;
+    if (!readUnsigned(text, parsed) || parsed < minValue || parsed > maxValue) {
+        error = std::string(key) + ": 잘못된 값 '" + text + "' (" + std::to_string(minValue) + " ~ " +
+                std::to_string(maxValue) + ")";
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+bool readBool(const QSettings& settings, const char* key, bool& value, std::string& error) {
+    if (!settings.contains(key)) {
+        return true;
+    }
+    std::string text = readString(settings, key);
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (text == "true" || text == "yes" || text == "on" || text == "1") {
+        value = true;
+    } else if (text == "false" || text == "no" || text == "off" || text == "0") {
+        value = false;
+    } else {
+        error = std::string(key) + ": true / false가 아님 '" + text + "'";
+        return false;
+    }
+    return true;
+}
+
+template <typename Enum, size_t N>
+bool readChoice(const QSettings& settings, const char* key, Enum& value,
+                const std::pair<const char*, Enum> (&choices)[N], std::string& error) {
+    if (!settings.contains(key)) {
+        return true;
+    }
+    std::string text = readString(settings, key);
+    for (const auto& choice : choices) {
+        if (text == choice.first) {
+            value = choice.second;
+            return true;
+        }
+    }
+    error = std::string(key) + ": 알 수 없는 값 '" + text + "' (";
+    for (size_t i = 0; i < N; ++i) {
+        error += (i ? " | " : "") + std::string(choices[i].first);
+    }
+    error += ")";
+    return false;
+}
+
+}  // namespace
+
+bool loadHeadlessConfig(const std::string& path, HeadlessConfig& config, std::string& error) {
+    // QSettings는 없는 파일을 빈 설정으로 읽으므로 먼저 확인
+    if (access(path.c_str(), R_OK) != 0) {
+        error = path + ": " + strerror(errno);
+        return false;
+    }
+    QSettings settings(QString::fromStdString(path), QSettings::IniFormat);
+    if (settings.status() != QSettings::NoError) {
+        error = path + ": INI 형식 오류";
+        return false;
+    }
+    for (const QString& key : settings.allKeys()) {
+        std::string name = key.toStdString();
+        if (std::none_of(std::begin(kKnownKeys), std::end(kKnownKeys),
+                         [&](const char* known) { return name == known; })) {
+            error = path + ": 알 수 없는 설정 '" + name + "'";
+            return false;
+        }
+    }
+
+    static const std::pair<const char*, OverrunPolicy> kPolicies[] = {
+        {"skip", OverrunPolicy::Skip}, {"catchup", OverrunPolicy::CatchUp}};
+    static const std::pair<const char*, LogMode> kLogModes[] = {
+        {"off", LogMode::Disabled}, {"async", LogMode::Async}, {"sync", LogMode::Synchronous}};
+    static const std::pair<const char*, CANIOMode> kIOModes[] = {
+        {"perframe", CANIOMode::PerFrame}, {"batched", CANIOMode::Batched}};
+
+    uint64_t canPeriodUs = static_cast<uint64_t>(config.can.periodUs);
+    uint64_t canBatchSize = static_cast<uint64_t>(config.can.batchSize);
+    uint64_t fdSamples = static_cast<uint64_t>(config.can.fdSamplesPerFrame);
+    uint64_t rs232PeriodUs = static_cast<uint64_t>(config.rs232.periodUs);
+    uint64_t baudRate = static_cast<uint64_t>(config.rs232.baudRate);
+    uint64_t historyEntries = config.rs232.historyEntries;
+    uint64_t historyBytes = config.rs232.historyBytes;
+    uint64_t metricsIntervalMs = static_cast<uint64_t>(config.metrics.intervalMs);
+    uint64_t scheduleBaseId = config.schedule.baseId;
+    uint64_t jitterUs = static_cast<uint64_t>(config.schedule.jitterUs);
+    const uint64_t minPeriodUs = static_cast<uint64_t>(PeriodicScheduler::kMinPeriodNs / 1000);
+
+    bool ok = readNumber(settings, "run/duration_s", config.durationSec, 0.0, error) &&
+              readUnsigned(settings, "run/max_messages", config.maxMessages, 0, UINT64_MAX, error) &&
+              readNumber(settings, "run/warmup_s", config.warmupSec, 0.0, error) &&
+              readNumber(settings, "run/progress_interval_s", config.progressIntervalSec, 0.0, error) &&
+              readChoice(settings, "run/overrun", config.overrunPolicy, kPolicies, error) &&
+              readChoice(settings, "run/log", config.logMode, kLogModes, error) &&
+              readUnsigned(settings, "can/period_us", canPeriodUs, minPeriodUs, 3600000000ull, error) &&
+              readChoice(settings, "can/io", config.can.ioMode, kIOModes, error) &&
+              readUnsigned(settings, "can/batch_size", canBatchSize, 1, CANCommunication::kMaxBatchSize, error) &&
+              readBool(settings, "can/fd", config.can.fd, error) &&
+              readUnsigned(settings, "can/fd_samples", fdSamples, 1, CANCommunication::kMaxFDSamplesPerFrame, error) &&
+              readBool(settings, "can/brs", config.can.bitRateSwitch, error) &&
+              readBool(settings, "can/pin", config.can.pinWorkers, error) &&
+              readBool(settings, "rs232/enabled", config.rs232.enabled, error) &&
+              readUnsigned(settings, "rs232/period_us", rs232PeriodUs, minPeriodUs, 3600000000ull, error) &&
+              readUnsigned(settings, "rs232/baud", baudRate, 9600, 921600, error) &&
+              readUnsigned(settings, "rs232/history_entries", historyEntries, 1, 1ull << 24, error) &&
+              readUnsigned(settings, "rs232/history_bytes", historyBytes, 1024, UINT32_MAX, error) &&
+              readUnsigned(settings, "schedule/messages", config.schedule.messages, 0, 1000000, error) &&
+              readUnsigned(settings, "schedule/base_id", scheduleBaseId, 0, CAN_EFF_MASK, error) &&
+              readUnsigned(settings, "schedule/jitter_us", jitterUs, 0, 1000000, error) &&
+              readUnsigned(settings, "schedule/seed", config.schedule.seed, 0, UINT64_MAX, error) &&
+              readUnsigned(settings, "metrics/interval_ms", metricsIntervalMs, 10, 3600000, error);
+    if (!ok) {
+        error = path + ": " + error;
+        return false;
+    }
+    config.can.periodUs = static_cast<int64_t>(canPeriodUs);
+    config.can.batchSize = static_cast<int>(canBatchSize);
+    config.can.fdSamplesPerFrame = static_cast<int>(fdSamples);
+    config.rs232.periodUs = static_cast<int64_t>(rs232PeriodUs);
+    config.rs232.baudRate = static_cast<int>(baudRate);
+    if (!SerialPort::isSupportedBaudRate(config.rs232.baudRate)) {
+        error = path + ": rs232/baud: 지원하지 않는 속도 '" + std::to_string(baudRate) +
+                "' (9600 19200 38400 57600 115200 230400 460800 921600)";
+        return false;
+    }
+    config.rs232.historyEntries = static_cast<size_t>(historyEntries);
+    config.rs232.historyBytes = static_cast<size_t>(historyBytes);
+    config.metrics.intervalMs = static_cast<int64_t>(metricsIntervalMs);
+    config.schedule.baseId = static_cast<canid_t>(scheduleBaseId);
+    config.schedule.jitterUs = static_cast<int64_t>(jitterUs);
+    config.metrics.textfile = readString(settings, "metrics/textfile", config.metrics.textfile);
+    config.metrics.socket = readString(settings, "metrics/socket", config.metrics.socket);
+    config.outputPath = readString(settings, "run/output", config.outputPath);
+
+    config.can.interfaces = CANBusGroup::parseInterfaceList(readString(settings, "can/interfaces"));
+    if (config.can.interfaces.size() > CANBusGroup::kMaxBuses) {
+        error = path + ": can/interfaces: 버스 수 초과";
+        return false;
+    }
+    // ID 목록도 인터페이스 목록과 같은 구분자 규칙
+    config.can.ids.clear();
+    for (const std::string& text : CANBusGroup::parseInterfaceList(readString(settings, "can/ids"))) {
+        uint64_t id = 0;
+        if (!readUnsigned(text, id) || id > CAN_EFF_MASK || can_codec::messageIndex(static_cast<canid_t>(id)) < 0) {
+            error = path + ": can/ids: 정의되지 않은 CAN ID '" + text + "'";
+            return false;
+        }
+        config.can.ids.push_back(normalizeCANID(static_cast<canid_t>(id)));
+    }
+
+    if (settings.contains("schedule/periods_us")) {
+        config.schedule.periodsUs.clear();
+        for (const std::string& text : CANBusGroup::parseInterfaceList(readString(settings, "schedule/periods_us"))) {
+            uint64_t periodUs = 0;
+            if (!readUnsigned(text, periodUs) || periodUs < minPeriodUs || periodUs > 3600000000ull) {
+                error = path + ": schedule/periods_us: 잘못된 주기 '" + text + "'";
+                return false;
+            }
+            config.schedule.periodsUs.push_back(static_cast<int64_t>(periodUs));
+        }
+        if (config.schedule.periodsUs.empty()) {
+            error = path + ": schedule/periods_us: 주기가 없음";
+            return false;
+        }
+    }
+
+    config.rs232.sendPort = readString(settings, "rs232/send_port", config.rs232.sendPort);
+    config.rs232.receivePort = readString(settings, "rs232/receive_port", config.rs232.receivePort);
+    if (config.rs232.enabled && (config.rs232.sendPort.empty() || config.rs232.receivePort.empty())) {
+        error = path + ": rs232/send_port, rs232/receive_port가 필요함";
+        return false;
+    }
+    if (settings.contains("can/seed")) {
+        std::string text = readString(settings, "can/seed");
+        if (!readUnsigned(text, config.can.seed)) {
+            error = path + ": can/seed: 잘못된 값 '" + text + "'";
+            return false;
+        }
+        config.can.hasSeed = true;
+    }
+    if (settings.contains("rs232/seed")) {
+        std::string text = readString(settings, "rs232/seed");
+        if (!readUnsigned(text, config.rs232.seed)) {
+            error = path + ": rs232/seed: 잘못된 값 '" + text + "'";
+            return false;
+        }
+        config.rs232.hasSeed = true;
+    }
+
+    if (config.can.interfaces.empty() && !config.rs232.enabled) {
+        error = path + ": 사용할 채널이 없음 (can/interfaces 또는 rs232/enabled)";
+        return false;
+    }
+    // 실행 시간 / 메시지 수는 명령행(--duration / --messages) 적용 후 main에서 확인
+    return true;
+}
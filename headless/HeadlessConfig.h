@@ -0,0 +1,73 @@
+#ifndef HEADLESSCONFIG_H
+#define HEADLESSCONFIG_H
+
+#include "AsyncLogger.h"
+#include "CANCommunication.h"
+#include "PeriodicScheduler.h"
+#include "SentenceHistory.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct HeadlessCANConfig {
+    std::vector<std::string> interfaces;  // 비어 있으면 CAN 사용 안 함
+    std::vector<canid_t> ids;             // 비어 있으면 can_codec::kMessages 전체
+    int64_t periodUs{1000};
+    CANIOMode ioMode{CANIOMode::PerFrame};
+    int batchSize{32};
+    bool fd{false};
+    int fdSamplesPerFrame{CANCommunication::kMaxFDSamplesPerFrame};
+    bool bitRateSwitch{true};
+    bool pinWorkers{true};
+    bool hasSeed{false};  // 송신 값 합성 시드 (버스 i는 seed + i), 없으면 무작위
+    uint64_t seed{0};
+};
+
+// 가상 센서 메시지 일정 (messages > 0이면 can/period_us 고정 주기 송신 대신 사용, 버스마다 같은 일정)
+struct HeadlessScheduleConfig {
+    uint64_t messages{0};
+    canid_t baseId{0x18000000};
+    std::vector<int64_t> periodsUs{10000, 20000, 100000};  // 메시지마다 돌아가며 배정
+    int64_t jitterUs{0};
+    uint64_t seed{0};
+};
+
+struct HeadlessRS232Config {
+    bool enabled{false};
+    std::string sendPort;
+    std::string receivePort;
+    int64_t periodUs{500000};
+    int baudRate{115200};
+    bool hasSeed{false};
+    uint64_t seed{0};
+    size_t historyEntries{SentenceHistory::kDefaultMaxEntries};  // 송신 문장 히스토리 상한
+    size_t historyBytes{SentenceHistory::kDefaultArenaBytes};
+};
+
+// 실행 중 지표 내보내기 (MetricsExporter, 경로가 모두 비어 있으면 사용 안 함)
+struct HeadlessMetricsConfig {
+    std::string textfile;  // Prometheus 텍스트 형식 파일
+    std::string socket;    // Unix 소켓 경로
+    int64_t intervalMs{1000};
+};
+
+// 헤드리스 부하 측정 설정 (INI 파일, 예시는 headless/example.ini)
+struct HeadlessConfig {
+    double durationSec{10.0};     // 0: 제한 없음 (maxMessages까지)
+    uint64_t maxMessages{0};      // 송신 메시지(CAN 프레임 + NMEA 문장) 수 도달 시 종료, 0: 제한 없음
+    double warmupSec{0.0};        // 시작 후 통계를 초기화하기 전 대기 시간 (측정 구간에서 제외)
+    double progressIntervalSec{1.0};  // stderr 진행 상황 출력 간격, 0: 출력 안 함
+    OverrunPolicy overrunPolicy{OverrunPolicy::Skip};
+    LogMode logMode{LogMode::Disabled};
+    std::string outputPath;       // 요약 JSON 경로 (비어 있으면 stdout)
+
+    HeadlessCANConfig can;
+    HeadlessScheduleConfig schedule;
+    HeadlessRS232Config rs232;
+    HeadlessMetricsConfig metrics;
+};
+
+// 실패 시 error에 사유 (알 수 없는 키는 오타 방지를 위해 오류로 처리)
+bool loadHeadlessConfig(const std::string& path, HeadlessConfig& config, std::string& error);
+
+#endif // HEADLESSCONFIG_H
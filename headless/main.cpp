@@ -0,0 +1,579 @@
+// 헤드리스 부하 측정 실행기
+// 위젯 / 이벤트 루프 없이 설정 파일(INI)대로 CAN 버스와 RS232 채널을 구동하고,
+// 정해진 시간 또는 송신 메시지 수만큼 실행한 뒤 처리량 / 손실 / 지연 요약을 JSON으로 출력한다.
+//
+//   vsensor_headless <config.ini> [--duration 초] [--messages N] [--output 경로]
+//
+// 진행 상황과 채널 / 로그 출력은 stderr, 요약 JSON만 stdout(또는 run/output)으로 나간다. SIGINT / SIGTERM이면 그 시점까지 요약.
+#include "HeadlessConfig.h"
+#include "AsyncLogger.h"
+#include "CANBusGroup.h"
+#include "CommRecord.h"
+#include "JsonWriter.h"
+#include "MetricsExporter.h"
+#include "RS232Communication.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int kPollIntervalMs = 10;  // 종료 조건 확인 / 수신 링 비우기 간격
+constexpr size_t kDrainBatch = 1024;
+
+std::atomic<bool> interrupted{false};
+
+void handleSignal(int) {
+    interrupted.store(true);
+}
+
+int usage() {
+    std::fprintf(stderr, "usage: vsensor_headless <config.ini> [--duration 초] [--messages N] [--output 경로]\n");
+    return 2;
+}
+
+double cpuSeconds(const timeval& tv) {
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+const char* policyName(OverrunPolicy policy) {
+    return policy == OverrunPolicy::CatchUp ? "catchup" : "skip";
+}
+
+const char* logModeName(LogMode mode) {
+    switch (mode) {
+    case LogMode::Async: return "async";
+    case LogMode::Synchronous: return "sync";
+    case LogMode::Disabled: break;
+    }
+    return "off";
+}
+
+void writeHistogram(JsonWriter& json, const char* name, const HistogramSummary& summary) {
+    json.key(name);
+    json.beginObject();
+    json.field("count", summary.count);
+    json.field("mean", summary.mean);
+    json.field("p50", summary.p50);
+    json.field("p99", summary.p99);
+    json.field("p999", summary.p999);
+    json.field("max", summary.max);
+    json.endObject();
+}
+
+void writeScheduler(JsonWriter& json, const SchedulerStats& stats) {
+    json.key("scheduler");
+    json.beginObject();
+    json.field("period_ns", stats.periodNs);
+    json.field("ticks", stats.ticks);
+    json.field("overruns", stats.overruns);
+    json.field("skipped_periods", stats.skippedPeriods);
+    writeHistogram(json, "wakeup_latency_ns", stats.wakeupLatency);
+    json.endObject();
+}
+
+// 측정 구간 시작 시점의 누적 카운터 (워밍업 구간을 빼기 위해)
+struct Baseline {
+    std::vector<CANTrafficStats> canTraffic;
+    std::vector<uint64_t> canDropped;
+    RS232TrafficStats rs232Traffic{};
+    uint64_t rs232Dropped{0};
+    rusage usage{};
+    int64_t startNs{0};
+};
+
+class HeadlessRun {
+public:
+    explicit HeadlessRun(const HeadlessConfig& config) : config(config), drainBuffer(kDrainBatch) {}
+
+    bool start();
+    void run();
+    void stop();
+    void writeSummary(std::ostream& out, const std::string& configPath) const;
+
+private:
+    uint64_t messagesSent() const;
+    void drainRings();
+    void takeBaseline();
+    void printProgress(double elapsedSec);
+
+    const HeadlessConfig& config;
+    std::unique_ptr<CANBusGroup> canBuses;
+    std::unique_ptr<RS232Communication> rs232Comm;
+    MetricsExporter metricsExporter;  // 채널보다 먼저 멈춤 (소멸 역순)
+    std::vector<CommRecord> drainBuffer;
+    std::vector<uint64_t> canDrained;  // 버스별로 비운 수신 레코드 수 (측정 구간)
+    uint64_t rs232Drained{0};
+
+    Baseline baseline;
+    int64_t endNs{0};
+    rusage endUsage{};
+    const char* stopReason{"duration"};
+
+    // 진행 출력용 (이전 출력 시점)
+    double lastProgressSec{0.0};
+    uint64_t lastRS232Sent{0};
+    uint64_t lastRS232Received{0};
+};
+
+bool HeadlessRun::start() {
+    if (!config.can.interfaces.empty()) {
+        try {
+            canBuses = std::make_unique<CANBusGroup>(config.can.interfaces, config.can.pinWorkers);
+        } catch (const std::exception&) {
+            return false;  // 사유는 CANBusGroup에서 출력
+        }
+        for (size_t i = 0; i < canBuses->size(); ++i) {
+            CANCommunication& bus = canBuses->bus(i);
+            bus.setSendPeriodUs(config.can.periodUs);
+            bus.setOverrunPolicy(config.overrunPolicy);
+            bus.setIOMode(config.can.ioMode);
+            bus.setBatchSize(config.can.batchSize);
+            bus.setFDMode(config.can.fd);
+            bus.setFDSamplesPerFrame(config.can.fdSamplesPerFrame);
+            bus.setFDBitRateSwitch(config.can.bitRateSwitch);
+            if (config.can.hasSeed) {
+                bus.setSignalSeed(config.can.seed + i);
+            }
+            if (!config.can.ids.empty()) {
+                bus.setMessageIDs(config.can.ids);
+            }
+        }
+        if (config.schedule.messages > 0) {
+            std::vector<int64_t> periodsNs;
+            for (int64_t periodUs : config.schedule.periodsUs) {
+                periodsNs.push_back(periodUs * 1000);
+            }
+            std::vector<ScheduledMessage> fleet = makeSensorFleet(config.schedule.messages, config.schedule.baseId,
+                                                                  periodsNs, config.schedule.jitterUs * 1000,
+                                                                  can_codec::kMessageCount);
+            for (size_t i = 0; i < canBuses->size(); ++i) {
+                canBuses->bus(i).setMessageSchedule(fleet, config.schedule.seed + i);
+            }
+        }
+        canBuses->startAll();
+        canDrained.assign(canBuses->size(), 0);
+        for (size_t i = 0; i < canBuses->size(); ++i) {
+            if (!canBuses->bus(i).isConnected()) {
+                std::cerr << "[오류] CAN 인터페이스 시작 실패: " << canBuses->interfaceName(i) << std::endl;
+                return false;
+            }
+        }
+    }
+
+    if (config.rs232.enabled) {
+        rs232Comm = std::make_unique<RS232Communication>(config.rs232.sendPort, config.rs232.receivePort);
+        rs232Comm->setSendPeriodUs(config.rs232.periodUs);
+        rs232Comm->setOverrunPolicy(config.overrunPolicy);
+        rs232Comm->setBaudRate(config.rs232.baudRate);
+        rs232Comm->setSentHistoryLimits(config.rs232.historyEntries, config.rs232.historyBytes);
+        if (config.rs232.hasSeed) {
+            rs232Comm->setGeneratorSeed(config.rs232.seed);
+        }
+        rs232Comm->enableRS232Send(true);
+        rs232Comm->start();
+        if (!rs232Comm->isConnected()) {
+            std::cerr << "[오류] RS232 채널 시작 실패: " << config.rs232.sendPort << " -> "
+                      << config.rs232.receivePort << std::endl;
+            return false;
+        }
+    }
+
+    if ((!config.metrics.textfile.empty() || !config.metrics.socket.empty()) &&
+        !metricsExporter.start(config.metrics.textfile, config.metrics.socket,
+                               static_cast<int>(config.metrics.intervalMs))) {
+        return false;  // 사유는 MetricsExporter에서 출력
+    }
+    return true;
+}
+
+void HeadlessRun::stop() {
+    if (canBuses) {
+        canBuses->stopAll();
+    }
+    if (rs232Comm) {
+        rs232Comm->enableRS232Send(false);
+        rs232Comm->stop();
+    }
+    drainRings();
+    AsyncLogger::instance().flush();
+    metricsExporter.stop();  // 마지막 값으로 파일 갱신
+}
+
+uint64_t HeadlessRun::messagesSent() const {
+    uint64_t sent = 0;
+    for (size_t i = 0; canBuses && i < canBuses->size(); ++i) {
+        sent += canBuses->bus(i).trafficStats().framesSent - baseline.canTraffic[i].framesSent;
+    }
+    if (rs232Comm) {
+        sent += rs232Comm->trafficStats().sentencesSent - baseline.rs232Traffic.sentencesSent;
+    }
+    return sent;
+}
+
+void HeadlessRun::drainRings() {
+    // 표시할 곳은 없지만 UI 링 손실이 실제 소비 지연을 반영하도록 계속 비움
+    for (size_t i = 0; canBuses && i < canBuses->size(); ++i) {
+        size_t n;
+        while ((n = canBuses->bus(i).drainRecords(drainBuffer.data(), drainBuffer.size())) > 0) {
+            canDrained[i] += n;
+        }
+    }
+    if (rs232Comm) {
+        size_t n;
+        while ((n = rs232Comm->drainRecords(drainBuffer.data(), drainBuffer.size())) > 0) {
+            rs232Drained += n;
+        }
+    }
+}
+
+void HeadlessRun::takeBaseline() {
+    drainRings();
+    baseline.canTraffic.clear();
+    baseline.canDropped.clear();
+    for (size_t i = 0; canBuses && i < canBuses->size(); ++i) {
+        CANCommunication& bus = canBuses->bus(i);
+        baseline.canTraffic.push_back(bus.trafficStats());
+        baseline.canDropped.push_back(bus.droppedRecords());
+        bus.resetLatencyStats();
+        bus.resetSendSchedulerStats();
+        canDrained[i] = 0;
+    }
+    if (rs232Comm) {
+        baseline.rs232Traffic = rs232Comm->trafficStats();
+        baseline.rs232Dropped = rs232Comm->droppedRecords();
+        rs232Comm->resetSendSchedulerStats();
+        rs232Drained = 0;
+        lastRS232Sent = baseline.rs232Traffic.sentencesSent;
+        lastRS232Received = baseline.rs232Traffic.sentencesReceived;
+    }
+    if (canBuses) {
+        canBuses->sampleStats();  // 초당 값 기준 시점
+    }
+    AsyncLogger::instance().resetStats();
+    getrusage(RUSAGE_SELF, &baseline.usage);
+    baseline.startNs = PeriodicScheduler::monotonicNs();
+}
+
+void HeadlessRun::run() {
+    auto pollUntil = [this](int64_t deadlineNs) {
+        while (!interrupted.load() && PeriodicScheduler::monotonicNs() < deadlineNs) {
+            drainRings();
+            std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+        }
+    };
+
+    if (config.warmupSec > 0.0) {
+        std::cerr << "[정보] 워밍업 " << config.warmupSec << "초" << std::endl;
+        pollUntil(PeriodicScheduler::monotonicNs() + static_cast<int64_t>(config.warmupSec * 1e9));
+    }
+    takeBaseline();
+
+    const int64_t deadlineNs = config.durationSec > 0.0
+        ? baseline.startNs + static_cast<int64_t>(config.durationSec * 1e9)
+        : INT64_MAX;
+    for (;;) {
+        if (interrupted.load()) {
+            stopReason = "signal";
+            break;
+        }
+        int64_t nowNs = PeriodicScheduler::monotonicNs();
+        if (nowNs >= deadlineNs) {
+            stopReason = "duration";
+            break;
+        }
+        // 메시지 수는 폴링 간격만큼 넘을 수 있음 (요약에는 실제 송신 수를 기록)
+        if (config.maxMessages > 0 && messagesSent() >= config.maxMessages) {
+            stopReason = "messages";
+            break;
+        }
+        drainRings();
+        double elapsedSec = (nowNs - baseline.startNs) / 1e9;
+        if (config.progressIntervalSec > 0.0 && elapsedSec - lastProgressSec >= config.progressIntervalSec) {
+            printProgress(elapsedSec);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+    }
+
+    // 측정 구간은 송신을 멈추기 전까지 (정지 과정은 포함하지 않음)
+    endNs = PeriodicScheduler::monotonicNs();
+    getrusage(RUSAGE_SELF, &endUsage);
+}
+
+void HeadlessRun::printProgress(double elapsedSec) {
+    double intervalSec = elapsedSec - lastProgressSec;
+    lastProgressSec = elapsedSec;
+
+    char line[256];
+    int length = std::snprintf(line, sizeof(line), "[진행] %.1fs", elapsedSec);
+    if (canBuses) {
+        CANBusStats total = CANBusGroup::aggregate(canBuses->sampleStats());
+        length += std::snprintf(line + length, sizeof(line) - length, " | CAN tx %.0f/s rx %.0f/s",
+                                total.framesSentPerSec, total.framesReceivedPerSec);
+    }
+    if (rs232Comm) {
+        RS232TrafficStats traffic = rs232Comm->trafficStats();
+        length += std::snprintf(line + length, sizeof(line) - length, " | RS232 tx %.1f/s rx %.1f/s",
+                                (traffic.sentencesSent - lastRS232Sent) / intervalSec,
+                                (traffic.sentencesReceived - lastRS232Received) / intervalSec);
+        lastRS232Sent = traffic.sentencesSent;
+        lastRS232Received = traffic.sentencesReceived;
+    }
+    std::cerr << line << std::endl;
+}
+
+void HeadlessRun::writeSummary(std::ostream& out, const std::string& configPath) const {
+    const double elapsedSec = std::max<int64_t>(endNs - baseline.startNs, 1) / 1e9;
+    JsonWriter json(out);
+    json.beginObject();
+
+    json.key("config");
+    json.beginObject();
+    json.field("path", configPath);
+    json.field("duration_s", config.durationSec);
+    json.field("max_messages", config.maxMessages);
+    json.field("warmup_s", config.warmupSec);
+    json.field("overrun", policyName(config.overrunPolicy));
+    json.field("log", logModeName(config.logMode));
+    json.endObject();
+
+    json.key("run");
+    json.beginObject();
+    json.field("elapsed_s", elapsedSec);
+    json.field("stop_reason", stopReason);
+    json.field("messages_sent", messagesSent());
+    json.field("cpu_user_s", cpuSeconds(endUsage.ru_utime) - cpuSeconds(baseline.usage.ru_utime));
+    json.field("cpu_system_s", cpuSeconds(endUsage.ru_stime) - cpuSeconds(baseline.usage.ru_stime));
+    json.field("voluntary_context_switches", endUsage.ru_nvcsw - baseline.usage.ru_nvcsw);
+    json.field("involuntary_context_switches", endUsage.ru_nivcsw - baseline.usage.ru_nivcsw);
+    json.endObject();
+
+    if (canBuses) {
+        json.key("can");
+        json.beginObject();
+        json.field("period_us", config.can.periodUs);
+        json.field("io", config.can.ioMode == CANIOMode::Batched ? "batched" : "perframe");
+        json.field("batch_size", config.can.batchSize);
+        json.field("fd", config.can.fd);
+        json.key("buses");
+        json.beginArray();
+        uint64_t totalSent = 0;
+        uint64_t totalReceived = 0;
+        uint64_t totalDropped = 0;
+        for (size_t i = 0; i < canBuses->size(); ++i) {
+            CANCommunication& bus = canBuses->bus(i);
+            CANTrafficStats traffic = bus.trafficStats();
+            const CANTrafficStats& base = baseline.canTraffic[i];
+            uint64_t sent = traffic.framesSent - base.framesSent;
+            uint64_t received = traffic.framesReceived - base.framesReceived;
+            uint64_t dropped = bus.droppedRecords() - baseline.canDropped[i];
+            totalSent += sent;
+            totalReceived += received;
+            totalDropped += dropped;
+
+            json.beginObject();
+            json.field("interface", canBuses->interfaceName(i));
+            json.field("cpu", canBuses->cpu(i));
+            json.field("frames_sent", sent);
+            json.field("frames_received", received);
+            json.field("samples_sent", traffic.samplesSent - base.samplesSent);
+            json.field("samples_received", traffic.samplesReceived - base.samplesReceived);
+            json.field("payload_bytes_sent", traffic.payloadBytesSent - base.payloadBytesSent);
+            json.field("write_failures", traffic.writeFailures - base.writeFailures);
+            json.field("unknown_ids", traffic.unknownIDs - base.unknownIDs);
+            json.field("invalid_frames", traffic.invalidFrames - base.invalidFrames);
+            json.field("frames_sent_per_s", sent / elapsedSec);
+            json.field("frames_received_per_s", received / elapsedSec);
+            json.field("records_drained", canDrained[i]);
+            json.field("records_dropped", dropped);
+            writeScheduler(json, bus.sendSchedulerStats());
+            if (config.schedule.messages > 0) {
+                // 워밍업 포함 누적값
+                MessageScheduleStats schedule = bus.messageScheduleStats();
+                json.key("message_schedule");
+                json.beginObject();
+                json.field("messages", schedule.messages);
+                json.field("fired", schedule.fired);
+                json.field("skipped_periods", schedule.skippedPeriods);
+                json.field("wakeups", schedule.wakeups);
+                json.endObject();
+            }
+            {
+                // 워밍업 포함 누적값
+                IMUSignalStats signal = bus.signalStats();
+                json.key("signals");
+                json.beginObject();
+                json.field("seed", bus.signalSeed());
+                json.field("simd", simdLevelName(bestSimdLevel()));
+                json.field("streams", static_cast<uint64_t>(signal.streams));
+                json.field("samples", signal.samples);
+                json.field("blocks", signal.blocks);
+                json.field("on_demand_blocks", signal.onDemandBlocks);
+                json.field("skipped_samples", signal.skippedSamples);
+                json.endObject();
+            }
+            json.key("latency");
+            json.beginArray();
+            for (const CANLatencyStats& stats : bus.latencyStats()) {
+                char id[16];
+                std::snprintf(id, sizeof(id), "0x%X", stats.id & CAN_EFF_MASK);
+                json.beginObject();
+                json.field("id", id);
+                writeHistogram(json, "tx_to_rx_ns", stats.latency);
+                writeHistogram(json, "inter_arrival_ns", stats.interArrival);
+                json.endObject();
+            }
+            json.endArray();
+            json.endObject();
+        }
+        json.endArray();
+        json.field("frames_sent", totalSent);
+        json.field("frames_received", totalReceived);
+        json.field("frames_sent_per_s", totalSent / elapsedSec);
+        json.field("frames_received_per_s", totalReceived / elapsedSec);
+        json.field("records_dropped", totalDropped);
+        json.endObject();
+    }
+
+    if (rs232Comm) {
+        RS232TrafficStats traffic = rs232Comm->trafficStats();
+        const RS232TrafficStats& base = baseline.rs232Traffic;
+        uint64_t sent = traffic.sentencesSent - base.sentencesSent;
+        uint64_t received = traffic.sentencesReceived - base.sentencesReceived;
+        json.key("rs232");
+        json.beginObject();
+        json.field("send_port", config.rs232.sendPort);
+        json.field("receive_port", config.rs232.receivePort);
+        json.field("period_us", config.rs232.periodUs);
+        json.field("baud", config.rs232.baudRate);
+        json.field("sentences_sent", sent);
+        json.field("sentences_received", received);
+        json.field("sentences_dropped", traffic.sentencesDropped - base.sentencesDropped);
+        json.field("checksum_errors", traffic.checksumErrors - base.checksumErrors);
+        json.field("write_failures", traffic.writeFailures - base.writeFailures);
+        json.field("sentences_sent_per_s", sent / elapsedSec);
+        json.field("sentences_received_per_s", received / elapsedSec);
+        json.field("records_drained", rs232Drained);
+        json.field("records_dropped", rs232Comm->droppedRecords() - baseline.rs232Dropped);
+        writeScheduler(json, rs232Comm->sendSchedulerStats());
+        SentenceHistoryStats history = rs232Comm->sentHistory().stats();
+        json.key("sent_history");
+        json.beginObject();
+        json.field("entries", history.entries);
+        json.field("bytes", history.bytes);
+        json.field("max_entries", history.maxEntries);
+        json.field("arena_bytes", history.arenaBytes);
+        json.field("evicted", history.evicted);
+        json.endObject();
+        json.endObject();
+    }
+
+    LoggerStats logger = AsyncLogger::instance().stats();
+    json.key("logger");
+    json.beginObject();
+    json.field("events_logged", logger.eventsLogged);
+    json.field("events_dropped", logger.eventsDropped);
+    json.field("bytes_written", logger.bytesWritten);
+    json.endObject();
+
+    json.endObject();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argv[1][0] == '-') {
+        return usage();
+    }
+    const std::string configPath = argv[1];
+    HeadlessConfig config;
+    std::string error;
+    if (!loadHeadlessConfig(configPath, config, error)) {
+        std::cerr << "[오류] " << error << std::endl;
+        return 2;
+    }
+
+    // 명령행 값이 설정 파일보다 우선
+    for (int i = 2; i < argc; ++i) {
+        std::string option = argv[i];
+        if (i + 1 >= argc) {
+            return usage();
+        }
+        const char* value = argv[++i];
+        char* end = nullptr;
+        if (option == "--duration") {
+            config.durationSec = std::strtod(value, &end);
+        } else if (option == "--messages") {
+            config.maxMessages = std::strtoull(value, &end, 10);
+        } else if (option == "--output") {
+            config.outputPath = value;
+            continue;
+        } else {
+            return usage();
+        }
+        if (end == value || *end != '\0' || config.durationSec < 0.0) {
+            return usage();
+        }
+    }
+    if (config.durationSec <= 0.0 && config.maxMessages == 0) {
+        std::cerr << "[오류] 실행 시간 또는 메시지 수가 필요함 (run/duration_s / --duration 또는 run/max_messages / --messages)"
+                  << std::endl;
+        return 2;
+    }
+
+    // 채널 / 로거의 stdout 출력이 요약 JSON에 섞이지 않도록 실행 중 stdout은 stderr로 보냄
+    std::FILE* summaryOut = nullptr;
+    if (config.outputPath.empty()) {
+        std::fflush(stdout);
+        int summaryFd = dup(STDOUT_FILENO);
+        summaryOut = summaryFd >= 0 ? fdopen(summaryFd, "w") : nullptr;
+        if (summaryOut == nullptr || dup2(STDERR_FILENO, STDOUT_FILENO) < 0) {
+            std::cerr << "[오류] stdout 전환 실패: " << strerror(errno) << std::endl;
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    AsyncLogger::instance().setMode(config.logMode);
+
+    HeadlessRun run(config);
+    if (!run.start()) {
+        run.stop();
+        return 1;
+    }
+    run.run();
+    run.stop();
+
+    if (summaryOut) {
+        std::ostringstream summary;
+        run.writeSummary(summary, configPath);
+        std::string text = summary.str();
+        std::fwrite(text.data(), 1, text.size(), summaryOut);
+        std::fclose(summaryOut);
+    } else {
+        std::ofstream out(config.outputPath);
+        run.writeSummary(out, configPath);
+        if (!out) {
+            std::cerr << "[오류] 요약 파일 쓰기 실패: " << config.outputPath << std::endl;
+            return 1;
+        }
+        std::cerr << "[정보] 요약: " << config.outputPath << std::endl;
+    }
+    return 0;
+}
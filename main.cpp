@@ -1,37 +1,23 @@
-#include "CANCommunication.h"
-#include "RS232Communication.h"
 #include "commSimulator.h"
+#include "MetricsExporter.h"
 #include <QApplication>
-#include <iostream>
-#include <chrono>
-#include <thread>
+#include <cstdlib>
 
+// GUI 없이 부하 측정만 할 때는 headless/vsensor_headless.pro (QtCore만 사용)
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+
+    // 실행 지표 내보내기 (환경 변수 VSENSOR_METRICS_FILE / VSENSOR_METRICS_SOCKET 지정 시)
+    MetricsExporter metricsExporter;
+    const char* metricsFile = std::getenv("VSENSOR_METRICS_FILE");
+    const char* metricsSocket = std::getenv("VSENSOR_METRICS_SOCKET");
+    if (metricsFile || metricsSocket) {
+        metricsExporter.start(metricsFile ? metricsFile : "", metricsSocket ? metricsSocket : "");
+    }
+
     CommSimulator w;  // CommSimulator 클래스 인스턴스 생성
     w.show();  // UI를 표시
     return a.exec();  // 이벤트 루프 시작
 }
 
-/*
-int main() {
-    // CAN 통신 시작
-    CANCommunication canComm("vcan0");
-    canComm.start();
-
-    // RS232 통신 시작
-    RS232Communication rs232Comm("/dev/pts/3", "/dev/pts/2", 1000);
-    rs232Comm.start();  // RS232 시작
-
-    // exec for 10 secs..
-    std::this_thread::sleep_for(std::chrono::seconds(10));
-
-    canComm.stop();
-    rs232Comm.stop();
-
-    std::cout << "END" << std::endl;
-
-    return 0;
-}
-*/
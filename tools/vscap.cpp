@@ -0,0 +1,251 @@
+// 캡처 파일(.vscap) 명령행 도구
+// 인덱스(.vscap.idx)만으로 시간 / ID 범위를 찾아 해당 블록만 mmap 페이지로 읽는다.
+//
+//   vscap info <file>
+//   vscap query <file> [--id ID] [--from T] [--to T] [--limit N]   (candump 형식으로 출력)
+//   vscap extract <file> <out.vscap> [--id ID] [--from T] [--to T]
+//   vscap import <in.log> <out.vscap>
+//   vscap reindex <file>
+//
+// T: 캡처 시작 기준 초 (예: 12.5), '@'로 시작하면 epoch 초 (예: @1436509052.25)
+#include "CaptureFile.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+int usage() {
+    std::fprintf(stderr,
+                 "usage: vscap info <file>\n"
+                 "       vscap query <file> [--id ID] [--from T] [--to T] [--limit N]\n"
+                 "       vscap extract <file> <out.vscap> [--id ID] [--from T] [--to T]\n"
+                 "       vscap import <in.log> <out.vscap>\n"
+                 "       vscap reindex <file>\n"
+                 "  ID: 16진수 (3자리 초과 또는 0x7FF 초과면 확장 ID)\n"
+                 "  T:  캡처 시작 기준 초, '@'로 시작하면 epoch 초\n");
+    return 2;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+bool parseSeconds(const char* text, int64_t& ns) {
+    char* end = nullptr;
+    double seconds = std::strtod(text, &end);
+    if (end == text || *end != '\0') {
+        return false;
+    }
+    ns = static_cast<int64_t>(seconds * 1e9);
+    return true;
+}
+
+struct QueryArgs {
+    capture::Query query;
+    uint64_t limit{UINT64_MAX};
+};
+
+// 상대 시각은 첫 블록의 시작 시각 기준
+bool parseQueryArgs(int argc, char** argv, int first, const capture::MappedCapture& file, QueryArgs& args) {
+    int64_t baseNs = file.blockCount() > 0 ? file.block(0).block.firstTimestampNs : 0;
+    for (int i = first; i < argc; ++i) {
+        const char* option = argv[i];
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "%s: 값이 없음\n", option);
+            return false;
+        }
+        const char* value = argv[++i];
+        if (std::strcmp(option, "--id") == 0) {
+            char* end = nullptr;
+            unsigned long id = std::strtoul(value, &end, 16);
+            if (end == value || *end != '\0' || id > 0x1FFFFFFFul) {
+                std::fprintf(stderr, "잘못된 ID: %s\n", value);
+                return false;
+            }
+            args.query.filterId = true;
+            args.query.id = static_cast<uint32_t>(id);
+            size_t digits = std::strlen(value) - ((std::strncmp(value, "0x", 2) == 0) ? 2 : 0);
+            if (digits > 3 || id > 0x7FF) {
+                args.query.id |= CAN_EFF_FLAG;
+            }
+        } else if (std::strcmp(option, "--from") == 0 || std::strcmp(option, "--to") == 0) {
+            bool absolute = value[0] == '@';
+            int64_t ns = 0;
+            if (!parseSeconds(value + (absolute ? 1 : 0), ns)) {
+                std::fprintf(stderr, "잘못된 시각: %s\n", value);
+                return false;
+            }
+            if (!absolute) {
+                ns += baseNs;
+            }
+            (option[2] == 'f' ? args.query.fromNs : args.query.toNs) = ns;
+        } else if (std::strcmp(option, "--limit") == 0) {
+            args.limit = std::strtoull(value, nullptr, 10);
+        } else {
+            std::fprintf(stderr, "알 수 없는 옵션: %s\n", option);
+            return false;
+        }
+    }
+    return true;
+}
+
+void printQueryStats(const capture::QueryStats& stats, double ms) {
+    std::fprintf(stderr,
+                 "blocks: %llu total, %llu in time range, %llu skipped by ID bitmap, %llu scanned "
+                 "(%.1f KB read); %llu records matched in %.2f ms\n",
+                 static_cast<unsigned long long>(stats.blocksTotal),
+                 static_cast<unsigned long long>(stats.blocksInRange),
+                 static_cast<unsigned long long>(stats.blocksSkippedById),
+                 static_cast<unsigned long long>(stats.blocksScanned), stats.bytesScanned / 1024.0,
+                 static_cast<unsigned long long>(stats.recordsMatched), ms);
+}
+
+std::string_view busName(const capture::MappedCapture& file, const capture::RecordHeader& header) {
+    if (header.kind == capture::RecordKind::NMEA) {
+        return "nmea";
+    }
+    const auto& names = file.busNames();
+    return header.bus < names.size() ? std::string_view(names[header.bus]) : std::string_view("can?");
+}
+
+bool openCapture(capture::MappedCapture& file, const char* path) {
+    auto start = std::chrono::steady_clock::now();
+    if (!file.open(path)) {
+        std::fprintf(stderr, "%s\n", file.error().c_str());
+        return false;
+    }
+    if (!file.error().empty()) {
+        std::fprintf(stderr, "경고: %s\n", file.error().c_str());
+    }
+    std::fprintf(stderr, "opened %s in %.2f ms (%zu blocks, %zu recovered without index)\n", path,
+                 elapsedMs(start), file.blockCount(), file.recoveredBlocks());
+    return true;
+}
+
+int runInfo(const char* path) {
+    capture::MappedCapture file;
+    if (!openCapture(file, path)) {
+        return 1;
+    }
+    uint64_t records = 0;
+    for (size_t b = 0; b < file.blockCount(); ++b) {
+        records += file.block(b).block.recordCount;  // 인덱스만 읽음
+    }
+    std::printf("file:     %s\n", path);
+    std::printf("size:     %llu bytes\n", static_cast<unsigned long long>(file.dataSize()));
+    std::printf("blocks:   %zu (%zu recovered)\n", file.blockCount(), file.recoveredBlocks());
+    std::printf("records:  %llu\n", static_cast<unsigned long long>(records));
+    if (file.blockCount() > 0) {
+        int64_t firstNs = file.block(0).block.firstTimestampNs;
+        int64_t lastNs = file.block(file.blockCount() - 1).maxTimestampNs;
+        std::printf("start:    %lld.%06lld\n", static_cast<long long>(firstNs / 1000000000LL),
+                    static_cast<long long>(firstNs % 1000000000LL / 1000));
+        std::printf("duration: %.6f s\n", (lastNs - firstNs) / 1e9);
+    }
+    for (size_t i = 0; i < file.busNames().size(); ++i) {
+        std::printf("bus %zu:    %s\n", i, file.busNames()[i].c_str());
+    }
+    return 0;
+}
+
+int runQuery(int argc, char** argv) {
+    capture::MappedCapture file;
+    QueryArgs args;
+    if (!openCapture(file, argv[2]) || !parseQueryArgs(argc, argv, 3, file, args)) {
+        return 1;
+    }
+    char line[512];
+    uint64_t printed = 0;
+    auto start = std::chrono::steady_clock::now();
+    capture::QueryStats stats = file.query(args.query, [&](const capture::RecordHeader& header, const uint8_t* payload) {
+        if (formatCandumpLine(header, payload, busName(file, header), line, sizeof(line)) > 0) {
+            std::puts(line);
+        }
+        return ++printed < args.limit;
+    });
+    printQueryStats(stats, elapsedMs(start));
+    return 0;
+}
+
+int runExtract(int argc, char** argv) {
+    capture::MappedCapture file;
+    QueryArgs args;
+    if (!openCapture(file, argv[2]) || !parseQueryArgs(argc, argv, 4, file, args)) {
+        return 1;
+    }
+    capture::Writer writer;
+    if (!writer.open(argv[3], file.busNames())) {
+        return 1;
+    }
+    capture::Record record;
+    bool ok = true;
+    auto start = std::chrono::steady_clock::now();
+    capture::QueryStats stats = file.query(args.query, [&](const capture::RecordHeader& header, const uint8_t* payload) {
+        record.header = header;
+        memcpy(record.payload, payload, header.length);
+        ok = writer.append(record);
+        return ok;
+    });
+    ok = writer.close() && ok;
+    printQueryStats(stats, elapsedMs(start));
+    if (!ok) {
+        std::fprintf(stderr, "%s: 쓰기 실패\n", argv[3]);
+        return 1;
+    }
+    std::fprintf(stderr, "wrote %llu records in %llu blocks to %s\n",
+                 static_cast<unsigned long long>(writer.recordsWritten()),
+                 static_cast<unsigned long long>(writer.blocksWritten()), argv[3]);
+    return 0;
+}
+
+int runImport(const char* logPath, const char* capturePath) {
+    capture::ImportResult result;
+    if (!capture::importCandump(logPath, capturePath, result)) {
+        return 1;
+    }
+    std::fprintf(stderr, "imported %llu records (%llu lines skipped, %zu buses) to %s\n",
+                 static_cast<unsigned long long>(result.recordsWritten),
+                 static_cast<unsigned long long>(result.linesSkipped), result.busNames.size(), capturePath);
+    return 0;
+}
+
+int runReindex(const char* path) {
+    std::string error;
+    if (!capture::rebuildIndex(path, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    if (!error.empty()) {
+        std::fprintf(stderr, "경고: %s\n", error.c_str());
+    }
+    std::fprintf(stderr, "rebuilt %s\n", capture::indexPath(path).c_str());
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        return usage();
+    }
+    std::string command = argv[1];
+    if (command == "info" && argc == 3) {
+        return runInfo(argv[2]);
+    }
+    if (command == "query") {
+        return runQuery(argc, argv);
+    }
+    if (command == "extract" && argc >= 4) {
+        return runExtract(argc, argv);
+    }
+    if (command == "import" && argc == 4) {
+        return runImport(argv[2], argv[3]);
+    }
+    if (command == "reindex" && argc == 3) {
+        return runReindex(argv[2]);
+    }
+    return usage();
+}
@@ -0,0 +1,18 @@
+TEMPLATE = app
+TARGET = vscap
+QT -= core gui
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+QMAKE_CXXFLAGS_RELEASE += -O2
+
+SOURCES += \
+    vscap.cpp \
+    ../comm/CaptureFile.cpp \
+
+HEADERS += \
+    ../comm/CaptureFile.h \
+    ../comm/CANId.h \
+
+INCLUDEPATH += \
+    ../comm \
@@ -0,0 +1,147 @@
+#include "CANIDStatsModel.h"
+#include "CANSignalCodec.h"
+#include <QFontDatabase>
+
+CANIDStatsModel::CANIDStatsModel(QObject *parent) : QAbstractTableModel(parent) {}
+
+int CANIDStatsModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(rows.size());
+}
+
+int CANIDStatsModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant CANIDStatsModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    static const char *const kHeaders[ColumnCount] = {
+        "Bus", "ID", "Frames", "Rate (/s)", "Cycle (ms)", "Jitter (ms)", "Last (ms ago)", "Len", "Data", "Decoded"};
+    return (section >= 0 && section < ColumnCount) ? QString(kHeaders[section]) : QVariant();
+}
+
+QVariant CANIDStatsModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() < 0 || static_cast<size_t>(index.row()) >= rows.size()) {
+        return QVariant();
+    }
+    const Row &row = rows[static_cast<size_t>(index.row())];
+    const CANIDStats &stats = row.stats;
+
+    if (role == Qt::FontRole && (index.column() == IDColumn || index.column() == DataColumn)) {
+        return QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    }
+    if (role == Qt::TextAlignmentRole && index.column() >= FramesColumn && index.column() <= LengthColumn) {
+        return int(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (index.column()) {
+    case BusColumn:
+        return row.bus < busNames.size() ? busNames[row.bus] : QString::number(row.bus);
+    case IDColumn:
+        // candump처럼 확장 ID는 8자리, 표준 ID는 3자리
+        return QString("%1").arg(stats.id & CAN_EFF_MASK, (stats.id & CAN_EFF_FLAG) ? 8 : 3, 16, QChar('0')).toUpper();
+    case FramesColumn:
+        return QString::number(stats.frames);
+    case RateColumn:
+        return QString::number(row.framesPerSec, 'f', 1);
+    case IntervalColumn:
+        return stats.intervalNs > 0 ? QString::number(stats.intervalNs / 1e6, 'f', 3) : QString("-");
+    case JitterColumn:
+        return stats.intervalNs > 0 ? QString::number(stats.jitterNs / 1e6, 'f', 3) : QString("-");
+    case AgeColumn:
+        return QString::number(row.ageNs / 1000000);
+    case LengthColumn:
+        return QString("%1%2").arg(stats.length).arg(stats.fd ? " FD" : "");
+    case DataColumn:
+        return formatData(stats);
+    case ValuesColumn:
+        return formatValues(stats);
+    default:
+        return QVariant();
+    }
+}
+
+void CANIDStatsModel::update(const std::vector<std::vector<CANIDStats>> &snapshots, int64_t nowNs) {
+    double elapsedSec = lastUpdateNs > 0 ? (nowNs - lastUpdateNs) / 1e9 : 0.0;
+    lastUpdateNs = nowNs;
+
+    // 기존 행은 제자리에서 갱신, 새 ID는 모아서 한 번에 추가
+    std::vector<Row> added;
+    for (size_t bus = 0; bus < snapshots.size(); ++bus) {
+        for (const CANIDStats &stats : snapshots[bus]) {
+            uint64_t key = (static_cast<uint64_t>(bus) << 32) | stats.id;
+            int64_t ageNs = nowNs > stats.lastSeenNs ? nowNs - stats.lastSeenNs : 0;
+            auto it = rowIndex.find(key);
+            if (it == rowIndex.end()) {
+                rowIndex.emplace(key, rows.size() + added.size());
+                added.push_back({static_cast<uint8_t>(bus), stats, 0.0, ageNs});
+                continue;
+            }
+            Row &row = rows[it->second];
+            // 표가 초기화되어 수가 줄었으면 이번 갱신은 0으로
+            row.framesPerSec = (elapsedSec > 0.0 && stats.frames >= row.stats.frames)
+                ? (stats.frames - row.stats.frames) / elapsedSec : 0.0;
+            row.stats = stats;
+            row.ageNs = ageNs;
+        }
+    }
+
+    if (!rows.empty()) {
+        emit dataChanged(index(0, 0), index(static_cast<int>(rows.size()) - 1, ColumnCount - 1));
+    }
+    if (!added.empty()) {
+        beginInsertRows(QModelIndex(), static_cast<int>(rows.size()), static_cast<int>(rows.size() + added.size()) - 1);
+        rows.insert(rows.end(), added.begin(), added.end());
+        endInsertRows();
+    }
+}
+
+void CANIDStatsModel::clear() {
+    beginResetModel();
+    rows.clear();
+    rowIndex.clear();
+    lastUpdateNs = 0;
+    endResetModel();
+}
+
+QString CANIDStatsModel::formatData(const CANIDStats &stats) const {
+    static const char kHex[] = "0123456789ABCDEF";
+    char text[CANFD_MAX_DLEN * 3];
+    int length = 0;
+    for (uint8_t i = 0; i < stats.length && i < CANFD_MAX_DLEN; ++i) {
+        if (i) {
+            text[length++] = ' ';
+        }
+        text[length++] = kHex[stats.data[i] >> 4];
+        text[length++] = kHex[stats.data[i] & 0xF];
+    }
+    return QString::fromLatin1(text, length);
+}
+
+QString CANIDStatsModel::formatValues(const CANIDStats &stats) const {
+    const can_codec::MessageDesc *msg = can_codec::findMessage(stats.id);
+    if (msg == nullptr) {
+        return QString();
+    }
+    // FD 프레임은 [샘플 수][샘플0]... 이므로 첫 샘플만 표시
+    const uint8_t *sample = stats.data;
+    int available = stats.length;
+    if (stats.fd) {
+        sample = stats.data + 1;
+        available = stats.length - 1;
+    }
+    if (available < msg->sampleBytes()) {
+        return QString();
+    }
+    float values[can_codec::kMaxFields];
+    can_codec::decode(*msg, sample, values);
+    QString text = QString(msg->name) + " |";
+    for (int f = 0; f < msg->fieldCount; ++f) {
+        text += QString(" %1=%2").arg(msg->fields[f].name).arg(static_cast<double>(values[f]), 0, 'f', 2);
+    }
+    return text;
+}
@@ -0,0 +1,50 @@
+#ifndef CANIDSTATSMODEL_H
+#define CANIDSTATSMODEL_H
+
+#include <QAbstractTableModel>
+#include <QStringList>
+#include <unordered_map>
+#include <vector>
+#include "CANIDStatsTable.h"
+
+// cansniffer 형식의 CAN ID별 통계 표
+// 갱신은 UI 타이머 주기마다 버스별 스냅샷으로 한 번 (버스 부하와 무관하게 ID 수에만 비례).
+// 행은 처음 수신한 순서를 유지하고 새 ID만 끝에 추가한다.
+class CANIDStatsModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column { BusColumn, IDColumn, FramesColumn, RateColumn, IntervalColumn, JitterColumn, AgeColumn,
+                  LengthColumn, DataColumn, ValuesColumn, ColumnCount };
+
+    explicit CANIDStatsModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // snapshots[i]: 버스 i의 CANCommunication::idStats() 결과, nowNs: CLOCK_REALTIME
+    void update(const std::vector<std::vector<CANIDStats>> &snapshots, int64_t nowNs);
+    void clear();
+
+    void setBusNames(const QStringList &names) { busNames = names; }
+
+private:
+    struct Row {
+        uint8_t bus;
+        CANIDStats stats;
+        double framesPerSec;  // 직전 갱신 이후 수신률
+        int64_t ageNs;        // 갱신 시점 기준 마지막 수신 후 경과 시간
+    };
+
+    std::vector<Row> rows;
+    std::unordered_map<uint64_t, size_t> rowIndex;  // (버스 << 32 | ID) -> 행
+    int64_t lastUpdateNs = 0;
+    QStringList busNames;
+
+    QString formatData(const CANIDStats &stats) const;
+    QString formatValues(const CANIDStats &stats) const;
+};
+
+#endif // CANIDSTATSMODEL_H
@@ -0,0 +1,95 @@
+#include "ReceivedDataModel.h"
+#include "CANCommunication.h"
+#include "RS232Communication.h"
+#include <QDateTime>
+#include <algorithm>
+
+ReceivedDataModel::ReceivedDataModel(size_t capacity, QObject *parent)
+    : QAbstractListModel(parent), records(capacity) {}
+
+int ReceivedDataModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(count);
+}
+
+QVariant ReceivedDataModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() < 0 || static_cast<size_t>(index.row()) >= count) {
+        return QVariant();
+    }
+
+    // 보이는 행에 대해서만 포맷팅
+    if (role == Qt::DisplayRole) {
+        return formatRow(at(index.row()));
+    }
+    if (role == Qt::ToolTipRole) {
+        return formatDetail(at(index.row()));
+    }
+    return QVariant();
+}
+
+void ReceivedDataModel::appendRecords(const CommRecord *newRecords, size_t newCount) {
+    if (newCount == 0) {
+        return;
+    }
+
+    const size_t capacity = records.size();
+
+    // 한 번에 용량 이상이 들어오면 마지막 capacity개만 남기고 전체 갱신
+    if (newCount >= capacity) {
+        beginResetModel();
+        const CommRecord *tail = newRecords + (newCount - capacity);
+        std::copy(tail, tail + capacity, records.begin());
+        head = 0;
+        count = capacity;
+        endResetModel();
+        return;
+    }
+
+    // 넘치는 만큼 가장 오래된 행을 한 번에 제거
+    if (count + newCount > capacity) {
+        size_t overflow = count + newCount - capacity;
+        beginRemoveRows(QModelIndex(), 0, static_cast<int>(overflow) - 1);
+        head = (head + overflow) % capacity;
+        count -= overflow;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), static_cast<int>(count), static_cast<int>(count + newCount) - 1);
+    for (size_t i = 0; i < newCount; ++i) {
+        records[(head + count + i) % capacity] = newRecords[i];
+    }
+    count += newCount;
+    endInsertRows();
+}
+
+void ReceivedDataModel::clear() {
+    beginResetModel();
+    head = 0;
+    count = 0;
+    endResetModel();
+}
+
+const CommRecord &ReceivedDataModel::recordAt(int row) const {
+    return at(static_cast<size_t>(row));
+}
+
+QString ReceivedDataModel::busPrefix(const CommRecord &record) const {
+    if (record.bus < busNames.size()) {
+        return QString("[%1] ").arg(busNames[record.bus]);
+    }
+    return QString();
+}
+
+QString ReceivedDataModel::formatRow(const CommRecord &record) const {
+    QString timestamp = QDateTime::fromMSecsSinceEpoch(record.timestampNs / 1000000).toString("yyyy-MM-dd hh:mm:ss.zzz");
+
+    // 행 높이를 균일하게 유지하기 위해 RS232는 원문 한 줄만 표시 (필드 분해는 툴팁)
+    QString data = (record.channel == RecordChannel::RS232)
+        ? "[RS232 수신] " + QString::fromLatin1(record.text, record.length)
+        : busPrefix(record) + CANCommunication::formatRecord(record);
+    return QString("Received: %1 @ %2").arg(timestamp).arg(data);
+}
+
+QString ReceivedDataModel::formatDetail(const CommRecord &record) const {
+    return (record.channel == RecordChannel::RS232) ? RS232Communication::formatRecord(record)
+                                                     : busPrefix(record) + CANCommunication::formatRecord(record);
+}
@@ -0,0 +1,46 @@
+#ifndef RECEIVEDDATAMODEL_H
+#define RECEIVEDDATAMODEL_H
+
+#include <QAbstractListModel>
+#include <QStringList>
+#include <vector>
+#include "CommRecord.h"
+
+// 수신 레코드 히스토리 모델
+// 고정 용량 원형 버퍼에 CommRecord를 그대로 보관하고, 문자열은 뷰가 요청한 행에 대해서만 만든다.
+// 용량을 넘으면 가장 오래된 행부터 제거된다 (행 0 = 가장 오래된 레코드).
+class ReceivedDataModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    static constexpr size_t kDefaultCapacity = 1 << 18;  // 262144개 (약 26MB)
+
+    explicit ReceivedDataModel(size_t capacity = kDefaultCapacity, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    void appendRecords(const CommRecord *records, size_t count);  // 한 번의 beginInsertRows로 추가
+    void clear();
+
+    const CommRecord &recordAt(int row) const;
+    size_t capacity() const { return records.size(); }
+
+    // CAN 레코드의 bus 인덱스 -> 인터페이스 이름 (CANBusGroup 순서)
+    void setBusNames(const QStringList &names) { busNames = names; }
+
+    QString formatRow(const CommRecord &record) const;     // 목록 한 줄 표시
+    QString formatDetail(const CommRecord &record) const;  // 상세 (NMEA 필드 분해 포함)
+
+private:
+    std::vector<CommRecord> records;  // 원형 버퍼
+    size_t head = 0;                  // 가장 오래된 레코드 위치
+    size_t count = 0;
+    QStringList busNames;
+
+    QString busPrefix(const CommRecord &record) const;
+
+    const CommRecord &at(size_t row) const { return records[(head + row) % records.size()]; }
+};
+
+#endif // RECEIVEDDATAMODEL_H
@@ -1,54 +1,208 @@
 #include "commSimulator.h"
 #include "CANCommunication.h"
+#include "CANBusGroup.h"
 #include "RS232Communication.h"
+#include "AsyncLogger.h"
 #include <QVBoxLayout>
 #include <QDateTime>
 #include <QRandomGenerator>
-#include <QListWidgetItem>
+#include <QScrollBar>
+#include <QHeaderView>
+#include <algorithm>
+#include <chrono>
 
 CommSimulator::CommSimulator(QWidget *parent)
-    : QWidget(parent) , canComm(nullptr), rs232Comm(nullptr){
+    : QWidget(parent) , canBuses(nullptr), rs232Comm(nullptr), recorder(new TrafficRecorder), replayer(new TrafficReplayer){
 
     setupUI();
 
-    // CAN 통신 객체 생성 및 시그널 연결
-    canComm = new CANCommunication("vcan0");
-    connect(canComm, &CANCommunication::dataReceived, this, &CommSimulator::dataReceived);
-    connect(canComm, &CANCommunication::connectionStatusChanged, this, &CommSimulator::updateConnectionStatusLabel);
+    // CAN 버스 묶음 생성 (인터페이스 목록은 UI에서 변경 가능)
+    createCANBuses(CANBusGroup::parseInterfaceList(canInterfacesEdit->text().toStdString()));
 
     // RS232 통신 객체 생성 및 시그널 연결
     rs232Comm = new RS232Communication("/dev/pts/3", "/dev/pts/2");
-    connect(rs232Comm, &RS232Communication::dataReceived, this, &CommSimulator::dataReceived);
     connect(rs232Comm, &RS232Communication::connectionStatusChanged, this, &CommSimulator::updateConnectionStatusLabelRS);
+    connect(rs232Comm, &RS232Communication::transitionFinished, this, &CommSimulator::finishRS232Transition);
+
+    // 수신 데이터는 메시지마다 시그널을 보내지 않고 화면 갱신 주기마다 링에서 한꺼번에 가져옴
+    refreshTimer = new QTimer(this);
+    connect(refreshTimer, &QTimer::timeout, this, &CommSimulator::drainReceivedData);
+    refreshTimer->start(kRefreshIntervalMs);
+
+    statsTimer = new QTimer(this);
+    connect(statsTimer, &QTimer::timeout, this, &CommSimulator::updateSchedulerStats);
+    connect(statsTimer, &QTimer::timeout, this, &CommSimulator::updateCANThroughput);
+    connect(statsTimer, &QTimer::timeout, this, &CommSimulator::updateCaptureStats);
+    statsTimer->start(kStatsIntervalMs);
+
+    idStatsTimer = new QTimer(this);
+    connect(idStatsTimer, &QTimer::timeout, this, &CommSimulator::updateCANIDStats);
+    idStatsTimer->start(kIDStatsIntervalMs);
 
 }
 
 CommSimulator::~CommSimulator() {
-    if (canComm) {
-        delete canComm;  // 소멸자에서 메모리 해제
+    // 재생기가 채널을 사용하므로 먼저 정지, 기록기는 채널이 탭을 놓은 뒤 정지
+    delete replayer;
+    if (canBuses) {
+        delete canBuses;  // 소멸자에서 메모리 해제 (버스별 반응기 스레드 종료)
     }
     if (rs232Comm) {
         delete rs232Comm;  // 소멸자에서 메모리 해제
     }
+    delete recorder;
+}
+
+void CommSimulator::createCANBuses(const std::vector<std::string> &interfaces) {
+    delete canBuses;
+    canBuses = nullptr;
+    canBusStatus.clear();
+    canTargetComboBox->clear();
+    canTargetComboBox->addItem("All CAN buses");
+    drainBuffer.resize(RS232Communication::kUIRingCapacity);
+
+    try {
+        canBuses = new CANBusGroup(interfaces);
+    } catch (const std::exception &e) {
+        qDebug() << "CAN bus group creation failed: " << e.what();
+        communicationStatusLabel->setText(QString("CAN 통신 상태: 버스 생성 실패 (%1)").arg(e.what()));
+        return;
+    }
+
+    QStringList names;
+    for (size_t i = 0; i < canBuses->size(); ++i) {
+        QString name = QString::fromStdString(canBuses->interfaceName(i));
+        names << name;
+        canBusStatus << "Unknown";
+        canTargetComboBox->addItem(QString("%1 (core %2)").arg(name).arg(canBuses->cpu(i)));
+
+        // 버스마다 상태 시그널을 버스 번호와 함께 전달
+        connect(&canBuses->bus(i), &CANCommunication::connectionStatusChanged, this,
+                [this, i](const QString &status) { updateConnectionStatusLabel(static_cast<int>(i), status); });
+        connect(&canBuses->bus(i), &CANCommunication::transitionFinished, this, &CommSimulator::finishCANTransition);
+    }
+    receivedDataModel->setBusNames(names);
+    canIDStatsModel->clear();
+    canIDStatsModel->setBusNames(names);
+    idStatsSnapshots.assign(canBuses->size(), {});
+
+    // 현재 UI 설정을 모든 버스에 적용 (콤보 박스는 "전체" 선택 상태)
+    setCANSendInterval();
+    setOverrunPolicy(catchUpCheckBox->isChecked());
+    setCANIOMode();
+    setCANFDMode();
+    updateCANMessageSet();
+    setReceiveAllCANIDs(canAllIDsCheckBox->isChecked());
+
+    drainBuffer.resize(canBuses->size() * CANCommunication::kUIRingCapacity + RS232Communication::kUIRingCapacity);
+}
+
+std::vector<CANCommunication*> CommSimulator::targetCANBuses() const {
+    std::vector<CANCommunication*> targets;
+    if (!canBuses) {
+        return targets;
+    }
+    int selected = canTargetComboBox->currentIndex();
+    if (selected <= 0) {
+        for (size_t i = 0; i < canBuses->size(); ++i) {
+            targets.push_back(&canBuses->bus(i));
+        }
+    } else if (static_cast<size_t>(selected) <= canBuses->size()) {
+        targets.push_back(&canBuses->bus(selected - 1));
+    }
+    return targets;
+}
+
+void CommSimulator::applyCANInterfaces() {
+    if (canActive || canTransitionsPending > 0 || recorder->isRecording() || replayActive) {
+        communicationStatusLabel->setText("CAN 통신 상태: 인터페이스 변경은 통신 / 기록 / 재생 정지 후 가능");
+        return;
+    }
+    std::vector<std::string> interfaces = CANBusGroup::parseInterfaceList(canInterfacesEdit->text().toStdString());
+    if (interfaces.empty()) {
+        communicationStatusLabel->setText("CAN 통신 상태: 인터페이스 목록이 비어 있음");
+        return;
+    }
+    createCANBuses(interfaces);
 }
 
 void CommSimulator::setupUI() {
     timestampLabel = new QLabel("Last Data Timestamp: Not Available", this);
 
-    // 송신 주기 설정 버튼 (CAN)
-    QPushButton *canSendIntervalButton = new QPushButton("Set CAN Send Interval (ms)", this);
+    // CAN 인터페이스 목록 (버스마다 전용 코어의 반응기 스레드) / 설정 적용 대상 버스
+    canInterfacesEdit = new QLineEdit("vcan0", this);
+    canInterfacesEdit->setPlaceholderText("vcan0, vcan1, ...");
+    canInterfacesButton = new QPushButton("Apply CAN Interfaces", this);
+    connect(canInterfacesButton, &QPushButton::clicked, this, &CommSimulator::applyCANInterfaces);
+    canTargetComboBox = new QComboBox(this);
+    canThroughputLabel = new QLabel("CAN Throughput: -", this);
+
+    // 수신 트래픽 기록 / 재생 (재생은 .vscap 또는 candump .log)
+    capturePathEdit = new QLineEdit("capture.vscap", this);
+    recordButton = new QPushButton("Start Recording", this);
+    connect(recordButton, &QPushButton::clicked, this, &CommSimulator::toggleRecording);
+    replayModeComboBox = new QComboBox(this);
+    replayModeComboBox->addItem("Replay: real-time");
+    replayModeComboBox->addItem("Replay: scaled speed");
+    replayModeComboBox->addItem("Replay: as fast as possible");
+    replaySpeedSpinBox = new QSpinBox(this);
+    replaySpeedSpinBox->setRange(1, 100000);
+    replaySpeedSpinBox->setValue(100);
+    replaySpeedSpinBox->setSuffix(" %");
+    replayButton = new QPushButton("Start Replay", this);
+    connect(replayButton, &QPushButton::clicked, this, &CommSimulator::toggleReplay);
+    captureStatsLabel = new QLabel("Capture: -", this);
+
+    // 송신 주기 설정 버튼 (CAN, 단위 us)
+    QPushButton *canSendIntervalButton = new QPushButton("Set CAN Send Interval (us)", this);
     canSendIntervalSpinBox = new QSpinBox(this);
-    canSendIntervalSpinBox->setRange(100, 5000);
-    canSendIntervalSpinBox->setValue(2000);  // 기본 2000ms
+    canSendIntervalSpinBox->setRange(kMinSendIntervalUs, kMaxSendIntervalUs);
+    canSendIntervalSpinBox->setSingleStep(100);
+    canSendIntervalSpinBox->setValue(2000000);  // 기본 2000ms
     connect(canSendIntervalButton, &QPushButton::clicked, this, &CommSimulator::setCANSendInterval);
 
-    // 송신 주기 설정 버튼 (RS232)
-    QPushButton *rs232SendIntervalButton = new QPushButton("Set RS232 Send Interval (ms)", this);
+    // 송신 주기 설정 버튼 (RS232, 단위 us)
+    QPushButton *rs232SendIntervalButton = new QPushButton("Set RS232 Send Interval (us)", this);
     rs232SendIntervalSpinBox = new QSpinBox(this);
-    rs232SendIntervalSpinBox->setRange(100, 5000);
-    rs232SendIntervalSpinBox->setValue(2000);  // 기본 2000ms
+    rs232SendIntervalSpinBox->setRange(kMinSendIntervalUs, kMaxSendIntervalUs);
+    rs232SendIntervalSpinBox->setSingleStep(100);
+    rs232SendIntervalSpinBox->setValue(2000000);  // 기본 2000ms
     connect(rs232SendIntervalButton, &QPushButton::clicked, this, &CommSimulator::setRS232SendInterval);
 
+    // 송신 작업이 주기를 넘겼을 때: 체크 시 놓친 주기를 연속 송신으로 따라잡고, 아니면 건너뜀
+    catchUpCheckBox = new QCheckBox("Catch up missed send periods", this);
+    connect(catchUpCheckBox, &QCheckBox::toggled, this, &CommSimulator::setOverrunPolicy);
+    schedulerStatsLabel = new QLabel("Send Timing: -", this);
+
+    // CAN 배치 I/O 설정 (sendmmsg/recvmmsg)
+    canBatchedIOCheckBox = new QCheckBox("Batched CAN I/O (sendmmsg/recvmmsg)", this);
+    canBatchSizeSpinBox = new QSpinBox(this);
+    canBatchSizeSpinBox->setRange(1, CANCommunication::kMaxBatchSize);
+    canBatchSizeSpinBox->setValue(32);  // 기본 32 프레임
+    connect(canBatchedIOCheckBox, &QCheckBox::toggled, this, &CommSimulator::setCANIOMode);
+    connect(canBatchSizeSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &CommSimulator::setCANIOMode);
+
+    // CAN FD 설정 (64바이트 페이로드에 IMU 샘플 N개)
+    canFDCheckBox = new QCheckBox("CAN FD (BRS, packed IMU samples)", this);
+    canFDSamplesSpinBox = new QSpinBox(this);
+    canFDSamplesSpinBox->setRange(1, CANCommunication::kMaxFDSamplesPerFrame);
+    canFDSamplesSpinBox->setValue(CANCommunication::kMaxFDSamplesPerFrame);
+    connect(canFDCheckBox, &QCheckBox::toggled, this, &CommSimulator::setCANFDMode);
+    connect(canFDSamplesSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &CommSimulator::setCANFDMode);
+
+    // 송수신할 CAN 메시지 선택 (커널 수신 필터에 반영)
+    for (const can_codec::MessageDesc& msg : can_codec::kMessages) {
+        QCheckBox *checkBox = new QCheckBox(QString("0x%1 %2").arg(msg.id & CAN_EFF_MASK, 8, 16, QChar('0')).arg(msg.name), this);
+        checkBox->setChecked(true);
+        connect(checkBox, &QCheckBox::toggled, this, &CommSimulator::updateCANMessageSet);
+        canMessageCheckBoxes.push_back(checkBox);
+    }
+
+    // 송수신 로그 콘솔 출력 (끄면 핫 패스에서 로그 기록 자체를 생략)
+    consoleLogCheckBox = new QCheckBox("Console log echo", this);
+    consoleLogCheckBox->setChecked(AsyncLogger::instance().mode() != LogMode::Disabled);
+    connect(consoleLogCheckBox, &QCheckBox::toggled, this, &CommSimulator::setConsoleLogEcho);
+
     // CAN 통신 토글 버튼
     canToggleButton = new QPushButton("Start CAN Communication", this);
     connect(canToggleButton, &QPushButton::clicked, this, &CommSimulator::toggleCANCommunication);
@@ -63,15 +217,43 @@ void CommSimulator::setupUI() {
     communicationStatusLabel = new QLabel("CAN Communication Status: Unknown", this);
     communicationStatusLabel2 = new QLabel("RS232 Communication Status: Unknown", this);
 
-    // 데이터 목록을 표시할 QListWidget 추가
-    receivedDataListWidget = new QListWidget(this);
+    // 데이터 목록: 원형 버퍼 모델 + 균일 행 높이 QListView (보이는 행만 포맷팅)
+    receivedDataModel = new ReceivedDataModel(ReceivedDataModel::kDefaultCapacity, this);
+    receivedDataListView = new QListView(this);
+    receivedDataListView->setModel(receivedDataModel);
+    receivedDataListView->setUniformItemSizes(true);
+
+    // CAN ID별 수신 통계 (cansniffer 형식, 주기적으로 스냅샷만 읽음)
+    canAllIDsCheckBox = new QCheckBox("Receive all CAN IDs (ID statistics only)", this);
+    connect(canAllIDsCheckBox, &QCheckBox::toggled, this, &CommSimulator::setReceiveAllCANIDs);
+    canIDStatsResetButton = new QPushButton("Reset CAN ID Statistics", this);
+    connect(canIDStatsResetButton, &QPushButton::clicked, this, &CommSimulator::resetCANIDStats);
+    canIDStatsModel = new CANIDStatsModel(this);
+    canIDStatsView = new QTableView(this);
+    canIDStatsView->setModel(canIDStatsModel);
+    canIDStatsView->horizontalHeader()->setStretchLastSection(true);
+    canIDStatsView->verticalHeader()->setVisible(false);
 
     QVBoxLayout *mainLayout = new QVBoxLayout;
     mainLayout->addWidget(timestampLabel);
+    mainLayout->addWidget(canInterfacesEdit);
+    mainLayout->addWidget(canInterfacesButton);
+    mainLayout->addWidget(canTargetComboBox);
     mainLayout->addWidget(canSendIntervalButton);
     mainLayout->addWidget(canSendIntervalSpinBox);
     mainLayout->addWidget(rs232SendIntervalButton);
     mainLayout->addWidget(rs232SendIntervalSpinBox);
+    mainLayout->addWidget(catchUpCheckBox);
+    mainLayout->addWidget(schedulerStatsLabel);
+    mainLayout->addWidget(canThroughputLabel);
+    mainLayout->addWidget(canBatchedIOCheckBox);
+    mainLayout->addWidget(canBatchSizeSpinBox);
+    mainLayout->addWidget(canFDCheckBox);
+    mainLayout->addWidget(canFDSamplesSpinBox);
+    for (QCheckBox *checkBox : canMessageCheckBoxes) {
+        mainLayout->addWidget(checkBox);
+    }
+    mainLayout->addWidget(consoleLogCheckBox);
     mainLayout->addWidget(canToggleButton);
     mainLayout->addWidget(rs232ToggleButton);
     mainLayout->addWidget(canStatusLabel);
@@ -79,90 +261,418 @@ void CommSimulator::setupUI() {
     mainLayout->addWidget(receivedDataLabel);
     mainLayout->addWidget(communicationStatusLabel);
     mainLayout->addWidget(communicationStatusLabel2);
-    mainLayout->addWidget(receivedDataListWidget);
+    mainLayout->addWidget(capturePathEdit);
+    mainLayout->addWidget(recordButton);
+    mainLayout->addWidget(replayModeComboBox);
+    mainLayout->addWidget(replaySpeedSpinBox);
+    mainLayout->addWidget(replayButton);
+    mainLayout->addWidget(captureStatsLabel);
+    mainLayout->addWidget(canAllIDsCheckBox);
+    mainLayout->addWidget(canIDStatsResetButton);
+    mainLayout->addWidget(canIDStatsView);
+    mainLayout->addWidget(receivedDataListView);
 
     setLayout(mainLayout);
 }
 
 void CommSimulator::setCANSendInterval() {
-    int intervalMs = canSendIntervalSpinBox->value();
-    if (canComm) {
-        canComm->setSendPeriod(intervalMs);  // CAN 송신 주기 설정
+    int intervalUs = canSendIntervalSpinBox->value();
+    for (CANCommunication *bus : targetCANBuses()) {
+        bus->setSendPeriodUs(intervalUs);  // CAN 송신 주기 설정 (선택한 버스)
         communicationStatusLabel->setText("CAN Send Interval Updated");
     }
 }
 
 void CommSimulator::setRS232SendInterval() {
-    int intervalMs = rs232SendIntervalSpinBox->value();
+    int intervalUs = rs232SendIntervalSpinBox->value();
     if (rs232Comm) {
-        rs232Comm->setSendPeriod(intervalMs);  // RS232 송신 주기 설정
+        rs232Comm->setSendPeriodUs(intervalUs);  // RS232 송신 주기 설정
         communicationStatusLabel2->setText("RS232 Send Interval Updated");
     }
 }
 
-void CommSimulator::toggleCANCommunication() {
-    try {
-        if (canComm) {
-            bool canSendEnabledState = canComm->canSendEnabled.load();
-            // qDebug() << "Current CAN send state: " << canSendEnabledState;
-
-            if (canSendEnabledState) {
-                canComm->enableCANSend(false);
-                canComm->stop();
-                canToggleButton->setText("Start CAN Communication");
-                canStatusLabel->setText("CAN Status: Disconnected");
-            } else {
-                canComm->enableCANSend(true);
-                canComm->start();
-                canToggleButton->setText("Stop CAN Communication");
-                canStatusLabel->setText("CAN Status: Connected");
+void CommSimulator::setOverrunPolicy(bool catchUp) {
+    OverrunPolicy policy = catchUp ? OverrunPolicy::CatchUp : OverrunPolicy::Skip;
+    if (canBuses) {
+        for (size_t i = 0; i < canBuses->size(); ++i) {
+            canBuses->bus(i).setOverrunPolicy(policy);
+        }
+    }
+    if (rs232Comm) {
+        rs232Comm->setOverrunPolicy(policy);
+    }
+}
+
+void CommSimulator::updateSchedulerStats() {
+    // 데드라인 대비 깨어남 지연(지터)과 주기 초과 횟수
+    auto format = [](const QString& name, const SchedulerStats& stats) {
+        return QString("%1 %2us: jitter p50 %3us p99 %4us max %5us, overruns %6, skipped %7")
+            .arg(name)
+            .arg(stats.periodNs / 1000)
+            .arg(stats.wakeupLatency.p50 / 1000.0, 0, 'f', 1)
+            .arg(stats.wakeupLatency.p99 / 1000.0, 0, 'f', 1)
+            .arg(stats.wakeupLatency.max / 1000.0, 0, 'f', 1)
+            .arg(stats.overruns)
+            .arg(stats.skippedPeriods);
+    };
+
+    QString text = "Send Timing:";
+    if (canBuses) {
+        for (size_t i = 0; i < canBuses->size(); ++i) {
+            if (canBuses->bus(i).isConnected()) {
+                QString name = "CAN " + QString::fromStdString(canBuses->interfaceName(i));
+                text += "\n  " + format(name, canBuses->bus(i).sendSchedulerStats());
             }
-        } else {
-            qDebug() << "canComm is nullptr!";
         }
-    } catch (const std::exception &e) {
-        qDebug() << "Exception caught: " << e.what();
     }
+    if (rs232Comm && rs232Comm->isConnected()) {
+        text += "\n  " + format("RS232", rs232Comm->sendSchedulerStats());
+        SentenceHistoryStats history = rs232Comm->sentHistory().stats();
+        text += QString("\n  RS232 sent history: %1/%2 sentences, %3/%4 KiB, evicted %5")
+                    .arg(history.entries).arg(history.maxEntries)
+                    .arg(history.bytes / 1024).arg(history.arenaBytes / 1024)
+                    .arg(history.evicted);
+    }
+    schedulerStatsLabel->setText(text);
 }
 
+void CommSimulator::updateCANThroughput() {
+    if (!canBuses || !canActive) {
+        return;
+    }
 
-void CommSimulator::toggleRS232Communication() {
-    if (rs232Comm) {
-        if (rs232Comm->rs232SendEnabled) {
-            rs232Comm->enableRS232Send(false);
-            rs232Comm->stop();
-            rs232ToggleButton->setText("Start RS232 Communication");
-            rs232StatusLabel->setText("RS232 Status: Disconnected");
-        } else {
-            rs232Comm->enableRS232Send(true);
-            rs232Comm->start();
-            rs232ToggleButton->setText("Stop RS232 Communication");
-            rs232StatusLabel->setText("RS232 Status: Connected");
+    // 버스별 / 전체 초당 송수신 프레임 수 (버스 카운터는 서로 독립, 여기서만 합산)
+    std::vector<CANBusStats> stats = canBuses->sampleStats();
+    CANBusStats total = CANBusGroup::aggregate(stats);
+    QString text = QString("CAN Throughput: total tx %1 fps, rx %2 fps")
+        .arg(total.framesSentPerSec, 0, 'f', 0)
+        .arg(total.framesReceivedPerSec, 0, 'f', 0);
+    for (const CANBusStats &bus : stats) {
+        text += QString("\n  %1 (core %2): tx %3 fps, rx %4 fps")
+            .arg(QString::fromStdString(bus.interfaceName))
+            .arg(bus.cpu)
+            .arg(bus.framesSentPerSec, 0, 'f', 0)
+            .arg(bus.framesReceivedPerSec, 0, 'f', 0);
+    }
+    canThroughputLabel->setText(text);
+}
+
+void CommSimulator::setCANIOMode() {
+    for (CANCommunication *bus : targetCANBuses()) {
+        bus->setBatchSize(canBatchSizeSpinBox->value());
+        bus->setIOMode(canBatchedIOCheckBox->isChecked() ? CANIOMode::Batched : CANIOMode::PerFrame);
+    }
+}
+
+void CommSimulator::setCANFDMode() {
+    for (CANCommunication *bus : targetCANBuses()) {
+        bus->setFDSamplesPerFrame(canFDSamplesSpinBox->value());
+        bus->setFDMode(canFDCheckBox->isChecked());
+    }
+}
+
+void CommSimulator::updateCANMessageSet() {
+    std::vector<canid_t> ids;
+    for (size_t m = 0; m < canMessageCheckBoxes.size(); ++m) {
+        if (canMessageCheckBoxes[m]->isChecked()) {
+            ids.push_back(can_codec::kMessages[m].id);
         }
     }
+    for (CANCommunication *bus : targetCANBuses()) {
+        bus->setMessageIDs(ids);  // 버스마다 다른 ID 집합 가능
+    }
+}
+
+void CommSimulator::setConsoleLogEcho(bool enable) {
+    AsyncLogger::instance().setMode(enable ? LogMode::Async : LogMode::Disabled);
+}
+
+void CommSimulator::toggleCANCommunication() {
+    if (!canBuses) {
+        qDebug() << "canBuses is nullptr!";
+        return;
+    }
+    if (canTransitionsPending > 0) {
+        return;  // 이전 요청의 완료 보고 대기 중
+    }
+
+    // UI 스레드는 기다리지 않고, 버스마다 반응기 스레드에서 끝나면 finishCANTransition()으로 보고됨
+    canTransitionsPending = canBuses->size();
+    canTransitionsConnected = 0;
+    canTransitionMaxNs = 0;
+    canToggleButton->setEnabled(false);
+    canInterfacesButton->setEnabled(false);
+    if (canActive) {
+        canActive = false;
+        canStatusLabel->setText("CAN Status: Stopping...");
+        canBuses->stopAllAsync();
+    } else {
+        canActive = true;
+        canStatusLabel->setText("CAN Status: Starting...");
+        canBuses->startAllAsync();
+        if (replayActive) {
+            setGeneratedTrafficEnabled(false);
+        }
+        canBuses->sampleStats();  // 처리량 기준 시점
+    }
+}
+
+void CommSimulator::finishCANTransition(bool connected, qint64 elapsedNs) {
+    if (canTransitionsPending == 0) {
+        return;
+    }
+    canTransitionsConnected += connected ? 1 : 0;
+    canTransitionMaxNs = std::max(canTransitionMaxNs, elapsedNs);
+    if (--canTransitionsPending > 0) {
+        return;
+    }
+
+    canToggleButton->setEnabled(true);
+    if (canActive) {
+        canToggleButton->setText("Stop CAN Communication");
+        canStatusLabel->setText(QString("CAN Status: Connected (%1/%2 bus, %3 ms)")
+                                    .arg(canTransitionsConnected).arg(canBuses->size())
+                                    .arg(canTransitionMaxNs / 1e6, 0, 'f', 1));
+    } else {
+        canInterfacesButton->setEnabled(true);
+        canToggleButton->setText("Start CAN Communication");
+        canStatusLabel->setText(QString("CAN Status: Disconnected (%1 ms)").arg(canTransitionMaxNs / 1e6, 0, 'f', 1));
+    }
 }
 
-void CommSimulator::dataReceived(const QString &data) {
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-    timestampLabel->setText("Last Data Timestamp: " + timestamp);
+void CommSimulator::toggleRS232Communication() {
+    if (!rs232Comm || rs232Comm->isTransitioning()) {
+        return;
+    }
+    rs232ToggleButton->setEnabled(false);
+    if (rs232Active) {
+        rs232Comm->enableRS232Send(false);
+        rs232Comm->stopAsync();
+        rs232Active = false;
+        rs232StatusLabel->setText("RS232 Status: Stopping...");
+    } else {
+        rs232Comm->enableRS232Send(!replayActive);
+        rs232Comm->startAsync();
+        rs232Active = true;
+        rs232StatusLabel->setText("RS232 Status: Starting...");
+    }
+}
 
-    QString formattedData = QString("Received: %1 @ %2").arg(timestamp).arg(data);
-    receivedDataLabel->setText(formattedData);
+void CommSimulator::finishRS232Transition(bool connected, qint64 elapsedNs) {
+    rs232ToggleButton->setEnabled(true);
+    if (rs232Active) {
+        rs232ToggleButton->setText("Stop RS232 Communication");
+        rs232StatusLabel->setText(QString("RS232 Status: %1 (%2 ms)")
+                                      .arg(connected ? "Connected" : "Start failed").arg(elapsedNs / 1e6, 0, 'f', 1));
+    } else {
+        rs232ToggleButton->setText("Start RS232 Communication");
+        rs232StatusLabel->setText(QString("RS232 Status: Disconnected (%1 ms)").arg(elapsedNs / 1e6, 0, 'f', 1));
+    }
+}
+
+void CommSimulator::drainReceivedData() {
+    // 버스별 링 / RS232 링에서 가져온 구간은 각각 시각 순이므로 구간끼리 차례로 병합
+    auto byTime = [](const CommRecord& a, const CommRecord& b) { return a.timestampNs < b.timestampNs; };
+    size_t count = 0;
+    auto drainRun = [&](size_t drained) {
+        if (drained > 0 && count > 0) {
+            std::inplace_merge(drainBuffer.begin(), drainBuffer.begin() + count,
+                               drainBuffer.begin() + count + drained, byTime);
+        }
+        count += drained;
+    };
+    if (canBuses) {
+        for (size_t i = 0; i < canBuses->size(); ++i) {
+            drainRun(canBuses->bus(i).drainRecords(drainBuffer.data() + count, CANCommunication::kUIRingCapacity));
+        }
+    }
+    if (rs232Comm) {
+        drainRun(rs232Comm->drainRecords(drainBuffer.data() + count, RS232Communication::kUIRingCapacity));
+    }
+    if (count == 0) {
+        return;
+    }
 
-    // 수신된 데이터를 목록에 추가
-    receivedDataListWidget->addItem(formattedData);
+    // 스크롤이 맨 아래에 있을 때만 새 데이터를 따라감
+    QScrollBar *scrollBar = receivedDataListView->verticalScrollBar();
+    bool followTail = scrollBar->value() == scrollBar->maximum();
 
-    // 리스트의 크기가 50개 이상이면 가장 오래된 항목을 제거
-    if (receivedDataListWidget->count() > 50) {
-        delete receivedDataListWidget->takeItem(receivedDataListWidget->count() - 1);
+    // 이번 주기에 받은 레코드를 한 번의 행 삽입으로 추가
+    receivedDataModel->appendRecords(drainBuffer.data(), count);
+    if (followTail) {
+        receivedDataListView->scrollToBottom();
     }
 
+    const CommRecord &last = drainBuffer[count - 1];
+    timestampLabel->setText("Last Data Timestamp: " +
+        QDateTime::fromMSecsSinceEpoch(last.timestampNs / 1000000).toString("yyyy-MM-dd hh:mm:ss"));
+    receivedDataLabel->setText(receivedDataModel->formatRow(last));
 }
 
-void CommSimulator::updateConnectionStatusLabel(const QString &status) {
-    // 상태 레이블을 UI에 표시
-    communicationStatusLabel->setText("CAN 통신 상태: " + status);
+void CommSimulator::updateConnectionStatusLabel(int bus, const QString &status) {
+    // 버스별 상태를 모아 UI에 표시 (버스가 하나면 기존과 같은 형식)
+    if (bus < 0 || bus >= canBusStatus.size() || !canBuses) {
+        return;
+    }
+    canBusStatus[bus] = status;
+    if (canBusStatus.size() == 1) {
+        communicationStatusLabel->setText("CAN 통신 상태: " + status);
+        return;
+    }
+    QStringList parts;
+    for (int i = 0; i < canBusStatus.size(); ++i) {
+        parts << QString("%1 %2").arg(QString::fromStdString(canBuses->interfaceName(i))).arg(canBusStatus[i]);
+    }
+    communicationStatusLabel->setText("CAN 통신 상태: " + parts.join(", "));
 }
 void CommSimulator::updateConnectionStatusLabelRS(const QString &status) {
     communicationStatusLabel2->setText("RS232 통신 상태: " + status);
 }
+
+void CommSimulator::toggleRecording() {
+    if (recorder->isRecording()) {
+        // 채널이 탭을 놓은 뒤 남은 레코드를 기록하고 닫음
+        if (canBuses) {
+            for (size_t i = 0; i < canBuses->size(); ++i) {
+                canBuses->bus(i).setRecorder(nullptr);
+            }
+        }
+        if (rs232Comm) {
+            rs232Comm->setRecorder(nullptr);
+        }
+        recorder->stop();
+        recordButton->setText("Start Recording");
+        updateCaptureStats();
+        return;
+    }
+
+    std::vector<std::string> busNames;
+    if (canBuses) {
+        for (size_t i = 0; i < canBuses->size(); ++i) {
+            busNames.push_back(canBuses->interfaceName(i));
+        }
+    }
+    if (!recorder->start(capturePathEdit->text().toStdString(), busNames)) {
+        captureStatsLabel->setText("Capture: 기록 파일 열기 실패");
+        return;
+    }
+    if (canBuses) {
+        for (size_t i = 0; i < canBuses->size(); ++i) {
+            canBuses->bus(i).setRecorder(recorder, static_cast<uint8_t>(i));
+        }
+    }
+    if (rs232Comm) {
+        rs232Comm->setRecorder(recorder);
+    }
+    recordButton->setText("Stop Recording");
+}
+
+void CommSimulator::setGeneratedTrafficEnabled(bool enable) {
+    if (canBuses && canActive) {
+        for (size_t i = 0; i < canBuses->size(); ++i) {
+            canBuses->bus(i).enableCANSend(enable);
+        }
+    }
+    if (rs232Comm && rs232Active) {
+        rs232Comm->enableRS232Send(enable);
+    }
+}
+
+void CommSimulator::toggleReplay() {
+    if (replayActive) {
+        replayer->stop();
+        updateCaptureStats();  // 종료 처리 (버튼 / 생성 송신 복구)
+        return;
+    }
+
+    // 캡처의 버스 인덱스 = 현재 버스 묶음 순서
+    if (canBuses) {
+        for (size_t i = 0; i < canBuses->size(); ++i) {
+            replayer->setCANBus(static_cast<uint8_t>(i), &canBuses->bus(i));
+        }
+    }
+    replayer->setNMEAChannel(rs232Comm);
+    replayer->setMode(static_cast<ReplayMode>(replayModeComboBox->currentIndex()),
+                      replaySpeedSpinBox->value() / 100.0);
+
+    // 재생 중에는 무작위 생성 송신을 멈춰 원본 트래픽만 보냄
+    setGeneratedTrafficEnabled(false);
+    if (!replayer->start(capturePathEdit->text().toStdString())) {
+        setGeneratedTrafficEnabled(true);
+        captureStatsLabel->setText("Capture: 재생 실패 (" + QString::fromStdString(replayer->stats().error) + ")");
+        return;
+    }
+    replayActive = true;
+    replayButton->setText("Stop Replay");
+}
+
+void CommSimulator::updateCaptureStats() {
+    QString text = "Capture:";
+    if (recorder->isRecording()) {
+        RecorderStats stats = recorder->stats();
+        text += QString("\n  recording %1 records, %2 KB, dropped %3%4")
+            .arg(stats.recordsWritten)
+            .arg(stats.bytesWritten / 1024)
+            .arg(stats.dropped)
+            .arg(stats.writeError ? ", write error" : "");
+    }
+
+    if (replayActive) {
+        // 달성 속도와 원본 타임스탬프 대비 송신 지연
+        ReplayStats stats = replayer->stats();
+        lastReplaySummary = QString("\n  replay %1: %2 records (CAN %3, NMEA %4, unroutable %5), %6 rec/s, speed x%7, "
+                        "timing error p50 %8us p99 %9us max %10us")
+            .arg(stats.running ? "running" : "finished")
+            .arg(stats.recordsReplayed)
+            .arg(stats.canFrames)
+            .arg(stats.nmeaSentences)
+            .arg(stats.unroutable)
+            .arg(stats.recordsPerSec, 0, 'f', 0)
+            .arg(stats.achievedSpeed, 0, 'f', 2)
+            .arg(stats.timingError.p50 / 1000.0, 0, 'f', 1)
+            .arg(stats.timingError.p99 / 1000.0, 0, 'f', 1)
+            .arg(stats.timingError.max / 1000.0, 0, 'f', 1);
+        if (!stats.error.empty()) {
+            lastReplaySummary += " (" + QString::fromStdString(stats.error) + ")";
+        }
+
+        if (!stats.running) {
+            replayer->waitFinished();
+            replayActive = false;
+            replayButton->setText("Start Replay");
+            setGeneratedTrafficEnabled(true);
+        }
+    }
+    captureStatsLabel->setText(text + lastReplaySummary);  // 끝난 재생은 마지막 결과 유지
+}
+
+void CommSimulator::updateCANIDStats() {
+    if (!canBuses) {
+        return;
+    }
+    // 스냅샷 비용은 등록된 ID 수에만 비례 (수신 스레드는 seqlock 쓰기만 하고 기다리지 않음)
+    for (size_t i = 0; i < canBuses->size(); ++i) {
+        canBuses->bus(i).idStats(idStatsSnapshots[i]);
+    }
+    int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    canIDStatsModel->update(idStatsSnapshots, nowNs);
+}
+
+void CommSimulator::setReceiveAllCANIDs(bool enable) {
+    if (!canBuses) {
+        return;
+    }
+    for (size_t i = 0; i < canBuses->size(); ++i) {
+        canBuses->bus(i).setReceiveAllIDs(enable);
+    }
+}
+
+void CommSimulator::resetCANIDStats() {
+    if (canBuses) {
+        for (size_t i = 0; i < canBuses->size(); ++i) {
+            canBuses->bus(i).resetIDStats();
+        }
+    }
+    canIDStatsModel->clear();
+}
@@ -6,11 +6,22 @@
 #include <QLabel>
 #include <QPushButton>
 #include <QSpinBox>
-#include <QListWidget>
+#include <QCheckBox>
+#include <QListView>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QTableView>
 #include "CANCommunication.h"
+#include "CANBusGroup.h"
 #include "RS232Communication.h"
+#include "ReceivedDataModel.h"
+#include "CANIDStatsModel.h"
+#include "TrafficRecorder.h"
+#include "TrafficReplayer.h"
+#include <vector>
 
 class CANCommunication;
+class CANBusGroup;
 class RS232Communication;
 
 class CommSimulator : public QWidget {
@@ -21,20 +32,39 @@ public:
     ~CommSimulator();
 
 private slots:
+    void applyCANInterfaces();          // 인터페이스 목록으로 CAN 버스 묶음 재생성 (정지 상태에서만)
     void setCANSendInterval();          // CAN 송신 주기 설정
     void setRS232SendInterval();        // RS232 송신 주기 설정
+    void setOverrunPolicy(bool catchUp); // 주기 초과 시 따라잡기 / 건너뛰기
+    void updateSchedulerStats();        // 송신 주기 지터 / 초과 통계 표시 (타이머)
+    void updateCANThroughput();         // 버스별 / 전체 초당 프레임 수 표시 (타이머)
+    void setCANIOMode();                // CAN 배치 I/O 모드 / 배치 크기 설정
+    void setCANFDMode();                // CAN FD 모드 / 프레임당 샘플 수 설정
+    void updateCANMessageSet();         // 송수신할 CAN 메시지 ID 집합 변경
+    void setConsoleLogEcho(bool enable); // 콘솔 로그 출력 온오프
     void toggleCANCommunication();     // CAN 통신 온오프
     void toggleRS232Communication();   // RS232 통신 온오프
     // void handleDisconnection();        // 재연결 시도
-    void dataReceived(const QString &data); // 데이터 수신 시그널 처리
+    void drainReceivedData();           // 통신 스레드 링에서 수신 레코드를 가져와 표시 (타이머)
+    void toggleRecording();             // 수신 트래픽 캡처 기록 온오프
+    void toggleReplay();                // 캡처 / candump 로그 재생 온오프
+    void updateCaptureStats();          // 기록 / 재생 통계 표시 (타이머)
+    void updateCANIDStats();            // ID별 수신 통계 표 갱신 (타이머, 버스 부하와 무관한 고정 주기)
+    void setReceiveAllCANIDs(bool enable); // 메시지 선택과 무관하게 모든 ID를 통계 표에 수집
+    void resetCANIDStats();             // ID별 수신 통계 초기화
+    void finishCANTransition(bool connected, qint64 elapsedNs);  // 버스 하나의 비동기 시작 / 정지 완료
+    void finishRS232Transition(bool connected, qint64 elapsedNs);
 
 public slots:
-    void updateConnectionStatusLabel(const QString &status);
+    void updateConnectionStatusLabel(int bus, const QString &status);
     void updateConnectionStatusLabelRS(const QString &status);
 
 private:
-    bool canActive = false;
+    bool canActive = false;   // 마지막으로 요청한 상태 (시작 / 정지 완료는 transitionFinished로 보고됨)
     bool rs232Active = false;
+    size_t canTransitionsPending = 0;  // 완료 보고를 기다리는 버스 수
+    size_t canTransitionsConnected = 0;
+    qint64 canTransitionMaxNs = 0;     // 가장 늦게 끝난 버스의 소요 시간
 
     QLabel *timestampLabel;             // 타임스탬프 라벨
     QLabel *canStatusLabel;             // CAN 상태 라벨
@@ -42,18 +72,61 @@ private:
     QLabel *receivedDataLabel;          // 수신 데이터 라벨
     QLabel *communicationStatusLabel;   // 통신 상태 라벨
     QLabel *communicationStatusLabel2;   // 통신 상태 라벨
+    QStringList canBusStatus;           // 버스별 연결 상태 (communicationStatusLabel에 합쳐 표시)
+
+    QLineEdit *canInterfacesEdit;       // CAN 인터페이스 목록 ("vcan0, vcan1")
+    QPushButton *canInterfacesButton;   // 인터페이스 목록 적용 버튼
+    QComboBox *canTargetComboBox;       // 설정을 적용할 버스 (0: 전체, i+1: 버스 i)
+    QLabel *canThroughputLabel;         // 버스별 / 전체 처리량
 
     QPushButton *canToggleButton;       // CAN 토글 버튼
     QPushButton *rs232ToggleButton;     // RS232 토글 버튼
     QSpinBox *canSendIntervalSpinBox;   // CAN 송신 주기 설정 스핀 박스
     QSpinBox *rs232SendIntervalSpinBox; // RS232 송신 주기 설정 스핀 박스
-    QListWidget *receivedDataListWidget;
+    QCheckBox *catchUpCheckBox;         // 주기 초과 처리 방식 (CatchUp / Skip)
+    QLabel *schedulerStatsLabel;        // 송신 주기 지터 / 초과 통계
+    QCheckBox *canBatchedIOCheckBox;    // CAN 배치 I/O (sendmmsg/recvmmsg) 사용 여부
+    QSpinBox *canBatchSizeSpinBox;      // CAN 배치 크기 설정 스핀 박스
+    QCheckBox *canFDCheckBox;           // CAN FD 프레임 사용 여부
+    QSpinBox *canFDSamplesSpinBox;      // FD 프레임당 IMU 샘플 수 설정 스핀 박스
+    std::vector<QCheckBox*> canMessageCheckBoxes;  // can_codec::kMessages 순서의 메시지 선택
+    QCheckBox *consoleLogCheckBox;      // 송수신 로그 콘솔 출력 여부
+    QLineEdit *capturePathEdit;         // 캡처 파일 경로 (.vscap, 재생은 candump .log도 가능)
+    QPushButton *recordButton;          // 기록 토글 버튼
+    QComboBox *replayModeComboBox;      // 재생 방식 (ReplayMode 순서)
+    QSpinBox *replaySpeedSpinBox;       // Scaled 재생 속도 (%)
+    QPushButton *replayButton;          // 재생 토글 버튼
+    QLabel *captureStatsLabel;          // 기록 / 재생 통계
+    QListView *receivedDataListView;
+    ReceivedDataModel *receivedDataModel;  // 수신 레코드 히스토리 (고정 용량 원형 버퍼)
+    QCheckBox *canAllIDsCheckBox;       // 모든 CAN ID 수신 (cansniffer처럼)
+    QPushButton *canIDStatsResetButton; // ID별 통계 초기화 버튼
+    QTableView *canIDStatsView;
+    CANIDStatsModel *canIDStatsModel;   // 버스 / ID별 수신률, 주기, 지터, 마지막 값
 
-    CANCommunication *canComm;     // CAN 통신 객체
+    CANBusGroup *canBuses;         // CAN 버스 묶음 (버스마다 전용 코어 / 반응기)
     RS232Communication *rs232Comm; // RS232 통신 객체
+    TrafficRecorder *recorder;     // 수신 트래픽 기록기
+    TrafficReplayer *replayer;     // 캡처 재생기
+    bool replayActive = false;
+    QString lastReplaySummary;
+
+    static constexpr int kRefreshIntervalMs = 33;  // 화면 갱신 주기 (~30fps)
+    QTimer *refreshTimer;
+    std::vector<CommRecord> drainBuffer;           // 링에서 꺼낸 레코드 (재사용)
+    static constexpr int kStatsIntervalMs = 1000;  // 송신 주기 통계 갱신 주기
+    QTimer *statsTimer;
+    static constexpr int kIDStatsIntervalMs = 250;  // ID별 통계 표 갱신 주기
+    QTimer *idStatsTimer;
+    std::vector<std::vector<CANIDStats>> idStatsSnapshots;  // 버스별 스냅샷 (재사용)
+    static constexpr int kMinSendIntervalUs = 100;      // PeriodicScheduler::kMinPeriodNs
+    static constexpr int kMaxSendIntervalUs = 5000000;
 
 
     void setupUI();
+    void createCANBuses(const std::vector<std::string> &interfaces);
+    void setGeneratedTrafficEnabled(bool enable);  // 재생 중에는 무작위 생성 송신을 멈춤
+    std::vector<CANCommunication*> targetCANBuses() const;  // canTargetComboBox 선택에 해당하는 버스
 };
 
 #endif // COMMSIMULATOR_H
@@ -7,20 +7,70 @@ CONFIG += c++17
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 QMAKE_CXXFLAGS += -D_GNU_SOURCE
+# SIMD 배치 디코딩(CANBatchDecoder)과 송신 값 합성(IMUSignalModel)이 스칼라 경로와 비트 단위로 같도록 곱셈-덧셈 융합 금지
+QMAKE_CXXFLAGS += -ffp-contract=off
 
 SOURCES += \
     main.cpp \
     ui/commSimulator.cpp \
+    ui/ReceivedDataModel.cpp \
+    ui/CANIDStatsModel.cpp \
     ui/mainwindow.cpp \
     comm/CANCommunication.cpp \
+    comm/CANBatchDecoder.cpp \
+    comm/IMUSignalModel.cpp \
+    comm/SimdDispatch.cpp \
+    comm/CANIDStatsTable.cpp \
     comm/RS232Communication.cpp \
+    comm/SentenceHistory.cpp \
+    comm/LatencyHistogram.cpp \
+    comm/AsyncLogger.cpp \
+    comm/SerialPort.cpp \
+    comm/NMEAParser.cpp \
+    comm/NMEAGenerator.cpp \
+    comm/PeriodicScheduler.cpp \
+    comm/MessageSchedule.cpp \
+    comm/EventReactor.cpp \
+    comm/CANBusGroup.cpp \
+    comm/CaptureFile.cpp \
+    comm/TrafficRecorder.cpp \
+    comm/Metrics.cpp \
+    comm/MetricsExporter.cpp \
+    comm/TrafficReplayer.cpp \
 
 HEADERS += \
     comm/HardwareCommunication.h \
     ui/commSimulator.h \
+    ui/ReceivedDataModel.h \
+    ui/CANIDStatsModel.h \
     ui/mainwindow.h \
     comm/CANCommunication.h \
+    comm/CANIDStatsTable.h \
+    comm/CANSignalCodec.h \
+    comm/CANId.h \
+    comm/CANBatchDecoder.h \
+    comm/IMUSignalModel.h \
+    comm/SimdDispatch.h \
     comm/RS232Communication.h \
+    comm/SentenceHistory.h \
+    comm/LatencyHistogram.h \
+    comm/SPSCRing.h \
+    comm/CommRecord.h \
+    comm/AsyncLogger.h \
+    comm/SerialPort.h \
+    comm/LineFramer.h \
+    comm/NMEAParser.h \
+    comm/NMEAGenerator.h \
+    comm/FastRandom.h \
+    comm/PeriodicScheduler.h \
+    comm/MessageSchedule.h \
+    comm/EventReactor.h \
+    comm/CANBusGroup.h \
+    comm/CaptureFile.h \
+    comm/TrafficRecorder.h \
+    comm/Metrics.h \
+    comm/MetricsExporter.h \
+    comm/TrafficReplayer.h \
 
 FORMS += \
     ui/mainwindow.ui